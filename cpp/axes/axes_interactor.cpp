@@ -135,7 +135,7 @@ void AxesInteractor::changeZoom(const double dy)
 
 void AxesInteractor::changePan(const double dx, const double dy)
 {
-    const Matrixd rotation_mat = view_angles_.getSnappedRotationMatrix();
+    const RotationMatrix3D rotation_mat = view_angles_.getSnappedRotationMatrix();
     const Vec3Dd v = rotation_mat.getTranspose() * Vec3Dd(-dx, dy, 0.0);
 
     const Vec3Dd s = axes_limits_.getAxesScale();
@@ -71,7 +71,7 @@ void setClipPlane(const GLenum gl_plane,
                   const Point3Dd& p0,
                   const Point3Dd& p1,
                   const Point3Dd& p2,
-                  const Matrixd rot_mat,
+                  const RotationMatrix3D& rot_mat,
                   const bool invert)
 {
     // Points are 3 points in non rotated plane
@@ -97,7 +97,7 @@ void AxesPainter::enableClipPlanes() const
     const ViewAngles view_ang(
         -view_angles_.getAzimuth(), -view_angles_.getElevation(), view_angles_.getAngleLimit());
 
-    const Matrixd rot_mat = view_ang.getSnappedRotationMatrix();
+    const RotationMatrix3D rot_mat = view_ang.getSnappedRotationMatrix();
 
     setClipPlane(GL_CLIP_PLANE0, {-f, 0.0, 0.0}, {-f, 1.0, 1.0}, {-f, 1.0, 0.0}, rot_mat, false);
     setClipPlane(GL_CLIP_PLANE1, {-f, 0.0, 0.0}, {-f, 1.0, 1.0}, {-f, 1.0, 0.0}, rot_mat, true);
@@ -35,7 +35,7 @@ Vec2Dd CoordinateConverter::orthogonalViewToModelCoordinate(const Vec2Dd& view_c
 
 Vec2Dd CoordinateConverter::modelToViewCoordinate(const Vec3Dd& model_coord) const
 {
-    const Matrixd rotation_mat = view_angles_.getSnappedRotationMatrix();
+    const RotationMatrix3D rotation_mat = view_angles_.getSnappedRotationMatrix();
     const Vec3Dd vr = rotation_mat * model_coord;
 
     return Vec2Dd(vr.x, vr.y);
@@ -0,0 +1,84 @@
+#ifndef ROTATION_MATRIX_3D_H_
+#define ROTATION_MATRIX_3D_H_
+
+#include <arl/math/math.h>
+
+#include <cmath>
+
+// 3 x 3 rotation matrix with its elements on the stack, row major. The view rotation is used
+// for every coordinate conversion and clip plane, so it's not worth a heap allocated
+// arl::Matrixd each time.
+struct RotationMatrix3D
+{
+    double m[3][3];
+
+    static RotationMatrix3D rotationX(const double angle)
+    {
+        const double ca = std::cos(angle);
+        const double sa = std::sin(angle);
+        return {{{1.0, 0.0, 0.0}, {0.0, ca, -sa}, {0.0, sa, ca}}};
+    }
+
+    static RotationMatrix3D rotationY(const double angle)
+    {
+        const double ca = std::cos(angle);
+        const double sa = std::sin(angle);
+        return {{{ca, 0.0, sa}, {0.0, 1.0, 0.0}, {-sa, 0.0, ca}}};
+    }
+
+    RotationMatrix3D operator*(const RotationMatrix3D& other) const
+    {
+        RotationMatrix3D res;
+        for (size_t r = 0; r < 3; r++)
+        {
+            for (size_t c = 0; c < 3; c++)
+            {
+                res.m[r][c] =
+                    m[r][0] * other.m[0][c] + m[r][1] * other.m[1][c] + m[r][2] * other.m[2][c];
+            }
+        }
+        return res;
+    }
+
+    arl::Vec3Dd operator*(const arl::Vec3Dd& v) const
+    {
+        return arl::Vec3Dd(m[0][0] * v.x + m[0][1] * v.y + m[0][2] * v.z,
+                           m[1][0] * v.x + m[1][1] * v.y + m[1][2] * v.z,
+                           m[2][0] * v.x + m[2][1] * v.y + m[2][2] * v.z);
+    }
+
+    RotationMatrix3D getTranspose() const
+    {
+        return {{{m[0][0], m[1][0], m[2][0]},
+                 {m[0][1], m[1][1], m[2][1]},
+                 {m[0][2], m[1][2], m[2][2]}}};
+    }
+
+    // Same conversion as arl::rotationMatrixToAxisAngle
+    arl::AxisAngled toAxisAngle() const
+    {
+        arl::AxisAngled axis_angle;
+        const double a0 = m[2][1] - m[1][2];
+        const double a1 = m[0][2] - m[2][0];
+        const double a2 = m[1][0] - m[0][1];
+        const double inv_den = 1.0 / std::sqrt(a0 * a0 + a1 * a1 + a2 * a2);
+
+        axis_angle.phi = std::acos((m[0][0] + m[1][1] + m[2][2] - 1.0) / 2.0);
+        if (std::abs(axis_angle.phi) < 1e-8)
+        {
+            axis_angle.x = 1.0;
+            axis_angle.y = 0.0;
+            axis_angle.z = 0.0;
+        }
+        else
+        {
+            axis_angle.x = a0 * inv_den;
+            axis_angle.y = a1 * inv_den;
+            axis_angle.z = a2 * inv_den;
+        }
+
+        return axis_angle;
+    }
+};
+
+#endif
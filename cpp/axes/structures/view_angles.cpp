@@ -102,26 +102,23 @@ double ViewAngles::getSnappedElevation() const
 
 arl::AxisAngled ViewAngles::getAngleAxis() const
 {
-    const arl::Matrixd rotation_mat =
-        arl::rotationMatrixX(getElevation()) * arl::rotationMatrixY(getAzimuth());
-    return arl::rotationMatrixToAxisAngle(rotation_mat);
+    return getRotationMatrix().toAxisAngle();
 }
 
-arl::Matrixd ViewAngles::getRotationMatrix() const
+RotationMatrix3D ViewAngles::getRotationMatrix() const
 {
-    return arl::rotationMatrixX(getElevation()) * arl::rotationMatrixY(getAzimuth());
+    return RotationMatrix3D::rotationX(getElevation()) * RotationMatrix3D::rotationY(getAzimuth());
 }
 
 arl::AxisAngled ViewAngles::getSnappedAngleAxis() const
 {
-    const arl::Matrixd rotation_mat =
-        arl::rotationMatrixX(getSnappedElevation()) * arl::rotationMatrixY(getSnappedAzimuth());
-    return arl::rotationMatrixToAxisAngle(rotation_mat);
+    return getSnappedRotationMatrix().toAxisAngle();
 }
 
-arl::Matrixd ViewAngles::getSnappedRotationMatrix() const
+RotationMatrix3D ViewAngles::getSnappedRotationMatrix() const
 {
-    return arl::rotationMatrixX(getSnappedElevation()) * arl::rotationMatrixY(getSnappedAzimuth());
+    return RotationMatrix3D::rotationX(getSnappedElevation()) *
+           RotationMatrix3D::rotationY(getSnappedAzimuth());
 }
 
 double ViewAngles::calcElevationSnapAngle() const
@@ -3,6 +3,8 @@
 
 #include <arl/math/math.h>
 
+#include "axes/structures/rotation_matrix_3d.h"
+
 class ViewAngles
 {
 private:
@@ -27,9 +29,9 @@ public:
     double getSnappedAzimuth() const;
     double getSnappedElevation() const;
     arl::AxisAngled getAngleAxis() const;
-    arl::Matrixd getRotationMatrix() const;
+    RotationMatrix3D getRotationMatrix() const;
     arl::AxisAngled getSnappedAngleAxis() const;
-    arl::Matrixd getSnappedRotationMatrix() const;
+    RotationMatrix3D getSnappedRotationMatrix() const;
     bool isCloseToSnap() const;
     bool bothSnappedBelowAngleLimitAroundZero() const;
     double getAngleLimit() const;
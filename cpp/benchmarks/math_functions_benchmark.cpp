@@ -0,0 +1,115 @@
+#include <math/math.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+/*
+Compares the elementwise sin, cos, exp, log, log10, sqrt and pow of the client math library with
+loops calling the std:: functions, on float and double vectors of num_elements elements.
+
+Usage: math-functions-benchmark [num_elements]
+*/
+
+namespace
+{
+// Average time in ms of f, repeated until at least min_total_time_ms has passed
+template <typename F> double timeFunction(const F& f, const double min_total_time_ms = 200.0)
+{
+    f();
+
+    size_t num_iterations = 0;
+    double total_time_ms = 0.0;
+    const auto t0 = std::chrono::steady_clock::now();
+    while (total_time_ms < min_total_time_ms)
+    {
+        f();
+        num_iterations++;
+        total_time_ms = std::chrono::duration<double, std::milli>(
+                            std::chrono::steady_clock::now() - t0)
+                            .count();
+    }
+
+    return total_time_ms / num_iterations;
+}
+
+template <typename T, typename F, typename G>
+void compare(const std::string& name,
+             const plot_tool::Vector<T>& x,
+             const F& library_function,
+             const G& std_function)
+{
+    plot_tool::Vector<T> y(x.size());
+
+    const double library_time = timeFunction([&] { y = library_function(x); });
+    const double std_time = timeFunction([&] {
+        for (size_t k = 0; k < x.size(); k++)
+        {
+            y(k) = std_function(x(k));
+        }
+    });
+
+    std::cout << std::setw(10) << name << std::setw(8) << (sizeof(T) == 8 ? "double" : "float")
+              << std::fixed << std::setprecision(3) << std::setw(12) << std_time << std::setw(12)
+              << library_time << std::setw(10) << std::setprecision(2)
+              << std_time / library_time << std::endl;
+}
+
+template <typename T> void compareAll(const size_t num_elements)
+{
+    plot_tool::Vector<T> x(num_elements), x_positive(num_elements);
+    for (size_t k = 0; k < num_elements; k++)
+    {
+        x(k) = static_cast<T>(20.0 * std::rand() / RAND_MAX - 10.0);
+        x_positive(k) = static_cast<T>(100.0 * std::rand() / RAND_MAX + 1.0e-3);
+    }
+
+    using V = plot_tool::Vector<T>;
+    compare("sin", x, [](const V& v) { return sin(v); }, [](const T a) { return std::sin(a); });
+    compare("cos", x, [](const V& v) { return cos(v); }, [](const T a) { return std::cos(a); });
+    compare("exp", x, [](const V& v) { return exp(v); }, [](const T a) { return std::exp(a); });
+    compare("log",
+            x_positive,
+            [](const V& v) { return log(v); },
+            [](const T a) { return std::log(a); });
+    compare("log10",
+            x_positive,
+            [](const V& v) { return log10(v); },
+            [](const T a) { return std::log10(a); });
+    compare("sqrt",
+            x_positive,
+            [](const V& v) { return sqrt(v); },
+            [](const T a) { return std::sqrt(a); });
+    compare("pow 1.5",
+            x_positive,
+            [](const V& v) { return pow(v, T(1.5)); },
+            [](const T a) { return std::pow(a, T(1.5)); });
+    compare("pow 3",
+            x,
+            [](const V& v) { return pow(v, T(3)); },
+            [](const T a) { return std::pow(a, T(3)); });
+}
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    const size_t num_elements = argc > 1 ? std::atoi(argv[1]) : 1000000;
+
+#ifdef PLOT_TOOL_SIMD_AVX2
+    std::cout << "Kernels: AVX2/FMA" << std::endl;
+#else
+    std::cout << "Kernels: portable" << std::endl;
+#endif
+
+    std::cout << std::setw(10) << "function" << std::setw(8) << "type" << std::setw(12)
+              << "std [ms]" << std::setw(12) << "simd [ms]" << std::setw(10) << "speedup"
+              << std::endl;
+
+    compareAll<double>(num_elements);
+    compareAll<float>(num_elements);
+
+    return 0;
+}
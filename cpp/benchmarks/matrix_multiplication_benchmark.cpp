@@ -0,0 +1,139 @@
+#include <math/math.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+/*
+Compares the blocked Matrix * Matrix and Matrix * Vector products of the client math library
+with the previous naive triple loop, for square matrices from 8x8 up to max_size.
+
+Usage: matrix-multiplication-benchmark [max_size] [max_naive_size]
+*/
+
+namespace
+{
+// The previous implementation of Matrix * Matrix
+plot_tool::Matrix<double> multiplyNaive(const plot_tool::Matrix<double>& m0,
+                                        const plot_tool::Matrix<double>& m1)
+{
+    plot_tool::Matrix<double> res(m0.rows(), m1.cols());
+
+    for (size_t r = 0; r < res.rows(); r++)
+    {
+        for (size_t c = 0; c < res.cols(); c++)
+        {
+            double p = 0.0;
+            for (size_t i = 0; i < m0.cols(); i++)
+            {
+                p = p + m0(r, i) * m1(i, c);
+            }
+            res(r, c) = p;
+        }
+    }
+    return res;
+}
+
+// The previous implementation of Matrix * Vector
+plot_tool::Vector<double> multiplyNaive(const plot_tool::Matrix<double>& m,
+                                        const plot_tool::Vector<double>& v)
+{
+    plot_tool::Vector<double> res(m.rows());
+
+    for (size_t r = 0; r < m.rows(); r++)
+    {
+        double p = 0.0;
+        for (size_t c = 0; c < m.cols(); c++)
+        {
+            p = p + m(r, c) * v(c);
+        }
+        res(r) = p;
+    }
+    return res;
+}
+
+// Average time in ms of f, repeated until at least min_total_time_ms has passed
+template <typename F> double timeFunction(const F& f, const double min_total_time_ms = 200.0)
+{
+    f();
+
+    size_t num_iterations = 0;
+    double total_time_ms = 0.0;
+    const auto t0 = std::chrono::steady_clock::now();
+    while (total_time_ms < min_total_time_ms)
+    {
+        f();
+        num_iterations++;
+        total_time_ms = std::chrono::duration<double, std::milli>(
+                            std::chrono::steady_clock::now() - t0)
+                            .count();
+    }
+
+    return total_time_ms / num_iterations;
+}
+
+void fillRandom(double* const data, const size_t num_elements)
+{
+    for (size_t k = 0; k < num_elements; k++)
+    {
+        data[k] = static_cast<double>(std::rand()) / RAND_MAX - 0.5;
+    }
+}
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    const size_t max_size = argc > 1 ? std::atoi(argv[1]) : 2048;
+    const size_t max_naive_size = argc > 2 ? std::atoi(argv[2]) : 1024;
+
+#ifdef PLOT_TOOL_SIMD_AVX2
+    std::cout << "Kernels: AVX2/FMA" << std::endl;
+#else
+    std::cout << "Kernels: portable" << std::endl;
+#endif
+
+    std::cout << std::setw(8) << "size" << std::setw(16) << "naive mm [ms]" << std::setw(16)
+              << "blocked [ms]" << std::setw(12) << "GFLOP/s" << std::setw(10) << "speedup"
+              << std::setw(16) << "naive mv [ms]" << std::setw(16) << "simd mv [ms]"
+              << std::setw(10) << "speedup" << std::endl;
+
+    for (size_t n = 8; n <= max_size; n *= 2)
+    {
+        plot_tool::Matrix<double> a(n, n), b(n, n);
+        plot_tool::Vector<double> v(n);
+        fillRandom(a.getDataPointer(), n * n);
+        fillRandom(b.getDataPointer(), n * n);
+        fillRandom(v.getDataPointer(), n);
+
+        plot_tool::Matrix<double> c;
+        plot_tool::Vector<double> w;
+
+        const double blocked_time = timeFunction([&] { c = a * b; });
+        const double simd_mv_time = timeFunction([&] { w = a * v; });
+        const double naive_mv_time = timeFunction([&] { w = multiplyNaive(a, v); });
+
+        const double gflops = 2.0 * n * n * n / (blocked_time * 1.0e6);
+
+        std::cout << std::setw(8) << n << std::fixed << std::setprecision(4);
+        if (n <= max_naive_size)
+        {
+            const double naive_time = timeFunction([&] { c = multiplyNaive(a, b); });
+            std::cout << std::setw(16) << naive_time << std::setw(16) << blocked_time
+                      << std::setw(12) << std::setprecision(2) << gflops << std::setw(10)
+                      << naive_time / blocked_time;
+        }
+        else
+        {
+            std::cout << std::setw(16) << "-" << std::setw(16) << blocked_time << std::setw(12)
+                      << std::setprecision(2) << gflops << std::setw(10) << "-";
+        }
+        std::cout << std::setprecision(4) << std::setw(16) << naive_mv_time << std::setw(16)
+                  << simd_mv_time << std::setw(10) << std::setprecision(2)
+                  << naive_mv_time / simd_mv_time << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,142 @@
+#include <math/math.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+/*
+Compares Vector::sort, sortedIndices and randomPermutation of the client math library with
+std::sort and with the previous bubble sort implementations, for vectors from 1024 elements up
+to max_size. The bubble sorts are only timed up to max_bubble_size elements.
+
+Usage: sorting-benchmark [max_size] [max_bubble_size]
+*/
+
+namespace
+{
+// The previous implementation of Vector::sort
+template <typename T> void bubbleSort(plot_tool::Vector<T>& v)
+{
+    bool done = false;
+
+    while (!done)
+    {
+        bool did_swap = false;
+        for (size_t k = 0; k < v.size() - 1; k++)
+        {
+            if (v(k) > v(k + 1))
+            {
+                std::swap(v(k), v(k + 1));
+                did_swap = true;
+            }
+        }
+        if (!did_swap)
+        {
+            done = true;
+        }
+    }
+}
+
+// Average time in ms of f, repeated until at least min_total_time_ms has passed
+template <typename F> double timeFunction(const F& f, const double min_total_time_ms = 200.0)
+{
+    f();
+
+    size_t num_iterations = 0;
+    double total_time_ms = 0.0;
+    const auto t0 = std::chrono::steady_clock::now();
+    while (total_time_ms < min_total_time_ms)
+    {
+        f();
+        num_iterations++;
+        total_time_ms = std::chrono::duration<double, std::milli>(
+                            std::chrono::steady_clock::now() - t0)
+                            .count();
+    }
+
+    return total_time_ms / num_iterations;
+}
+
+// All times include copying the input
+template <typename T>
+void compare(const std::string& name,
+             const plot_tool::Vector<T>& x,
+             const size_t max_bubble_size)
+{
+    plot_tool::Vector<T> y;
+    plot_tool::Vector<size_t> indices;
+
+    const double library_time = timeFunction([&] {
+        y = x;
+        y.sort();
+    });
+    const double std_time = timeFunction([&] {
+        y = x;
+        std::sort(y.getDataPointer(), y.getDataPointer() + y.size());
+    });
+    const double indices_time = timeFunction([&] { indices = plot_tool::sortedIndices(x); });
+
+    std::cout << std::setw(12) << name << std::setw(10) << x.size() << std::fixed
+              << std::setprecision(3);
+    if (x.size() <= max_bubble_size)
+    {
+        const double bubble_time = timeFunction([&] {
+            y = x;
+            bubbleSort(y);
+        });
+        std::cout << std::setw(14) << bubble_time;
+    }
+    else
+    {
+        std::cout << std::setw(14) << "-";
+    }
+    std::cout << std::setw(14) << std_time << std::setw(14) << library_time << std::setw(16)
+              << indices_time << std::endl;
+}
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    const size_t max_size = argc > 1 ? std::atoi(argv[1]) : 4194304;
+    const size_t max_bubble_size = argc > 2 ? std::atoi(argv[2]) : 8192;
+
+    std::cout << std::setw(12) << "data" << std::setw(10) << "size" << std::setw(14)
+              << "bubble [ms]" << std::setw(14) << "std [ms]" << std::setw(14) << "sort [ms]"
+              << std::setw(16) << "indices [ms]" << std::endl;
+
+    for (size_t n = 1024; n <= max_size; n *= 4)
+    {
+        plot_tool::Vector<double> x(n), timestamps(n);
+        plot_tool::Vector<float> x_float(n);
+        plot_tool::Vector<int> x_int(n);
+        for (size_t k = 0; k < n; k++)
+        {
+            x(k) = 2.0e3 * std::rand() / RAND_MAX - 1.0e3;
+            x_float(k) = static_cast<float>(x(k));
+            x_int(k) = std::rand() - RAND_MAX / 2;
+
+            // Mostly increasing, as when samples from several sources are merged
+            timestamps(k) = 1.6e9 + 1.0e-3 * k + 1.0e-2 * std::rand() / RAND_MAX;
+        }
+
+        compare("double", x, max_bubble_size);
+        compare("float", x_float, max_bubble_size);
+        compare("int", x_int, max_bubble_size);
+        compare("timestamps", timestamps, max_bubble_size);
+    }
+
+    std::cout << std::endl << std::setw(10) << "size" << std::setw(22) << "randomPermutation [ms]"
+              << std::endl;
+    for (size_t n = 1024; n <= max_size; n *= 4)
+    {
+        plot_tool::Vector<size_t> permutation;
+        std::cout << std::setw(10) << n << std::setw(22) << std::setprecision(3)
+                  << timeFunction([&] { permutation = plot_tool::randomPermutation(n); })
+                  << std::endl;
+    }
+
+    return 0;
+}
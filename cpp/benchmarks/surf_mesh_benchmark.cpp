@@ -0,0 +1,93 @@
+#include <arl/math/math.h>
+#include <arl/utilities/color_map.h>
+#include <arl/utilities/logging.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "communication/rx_list.h"
+#include "misc/thread_pool.h"
+#include "plot_functions/color_lut.h"
+#include "plot_functions/surf_mesh.h"
+
+/*
+Measures how CPU side surf mesh generation scales with the number of threads.
+
+Usage: surf-mesh-benchmark [max_num_threads] [num_iterations]
+*/
+
+namespace
+{
+double timeBuildSurfMesh(const arl::Matrixd& x,
+                         const arl::Matrixd& y,
+                         const arl::Matrixd& z,
+                         ThreadPool& thread_pool,
+                         const size_t num_iterations)
+{
+    SurfMesh mesh;
+    const arl::Interval1D<double> min_max_interval(arl::min(y), arl::max(y));
+    const ColorLut& color_lut = getBuiltInColorLut(plot_tool::ColorMap::JET);
+
+    // Warm up, so that allocating the buffers isn't included in the timing
+    buildSurfMesh(mesh, x, y, z, min_max_interval, color_lut, thread_pool);
+
+    const auto t0 = std::chrono::steady_clock::now();
+    for (size_t k = 0; k < num_iterations; k++)
+    {
+        buildSurfMesh(mesh, x, y, z, min_max_interval, color_lut, thread_pool);
+    }
+    const auto t1 = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::milli>(t1 - t0).count() / num_iterations;
+}
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    const size_t max_num_threads =
+        argc > 1 ? std::atoi(argv[1]) : std::max(1U, std::thread::hardware_concurrency());
+    const size_t num_iterations = argc > 2 ? std::atoi(argv[2]) : 5;
+
+    const std::vector<size_t> grid_sizes = {250, 500, 1000, 2000};
+
+    std::cout << std::setw(10) << "grid" << std::setw(10) << "threads" << std::setw(14)
+              << "time [ms]" << std::setw(10) << "speedup" << std::endl;
+
+    for (const size_t n : grid_sizes)
+    {
+        arl::Matrixd x(n, n), y(n, n), z(n, n);
+        for (size_t r = 0; r < n; r++)
+        {
+            for (size_t c = 0; c < n; c++)
+            {
+                x(r, c) = -4.0 + 8.0 * static_cast<double>(c) / (n - 1);
+                z(r, c) = -4.0 + 8.0 * static_cast<double>(r) / (n - 1);
+                const double rad = std::sqrt(x(r, c) * x(r, c) + z(r, c) * z(r, c)) + 1e-6;
+                y(r, c) = std::sin(2.0 * rad) / rad;
+            }
+        }
+
+        double single_thread_time = 0.0;
+        for (size_t num_threads = 1; num_threads <= max_num_threads; num_threads++)
+        {
+            ThreadPool thread_pool(num_threads - 1);
+            const double t = timeBuildSurfMesh(x, y, z, thread_pool, num_iterations);
+            if (num_threads == 1)
+            {
+                single_thread_time = t;
+            }
+
+            std::cout << std::setw(10) << n << std::setw(10) << num_threads << std::setw(14)
+                      << std::fixed << std::setprecision(3) << t << std::setw(10)
+                      << std::setprecision(2) << single_thread_time / t << std::endl;
+        }
+    }
+
+    return 0;
+}
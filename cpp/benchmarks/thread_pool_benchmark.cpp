@@ -0,0 +1,111 @@
+#include <math/math.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+
+/*
+Times elementwise expressions, reductions, generators and matrix products of the client math
+library with 1, 2, 4... threads up to the number of hardware threads, and prints the speedup
+over a single thread.
+
+Usage: thread-pool-benchmark [num_elements] [matrix_size]
+*/
+
+namespace
+{
+// Average time in ms of f, repeated until at least min_total_time_ms has passed
+template <typename F> double timeFunction(const F& f, const double min_total_time_ms = 200.0)
+{
+    f();
+
+    size_t num_iterations = 0;
+    double total_time_ms = 0.0;
+    const auto t0 = std::chrono::steady_clock::now();
+    while (total_time_ms < min_total_time_ms)
+    {
+        f();
+        num_iterations++;
+        total_time_ms = std::chrono::duration<double, std::milli>(
+                            std::chrono::steady_clock::now() - t0)
+                            .count();
+    }
+
+    return total_time_ms / num_iterations;
+}
+
+template <typename F>
+void timeWithThreadCounts(const std::string& name, const size_t max_num_threads, const F& f)
+{
+    std::cout << std::setw(24) << name;
+
+    double single_thread_time = 0.0;
+    for (size_t num_threads = 1; num_threads <= max_num_threads; num_threads *= 2)
+    {
+        plot_tool::setMaxNumThreads(num_threads);
+        const double t = timeFunction(f);
+        if (num_threads == 1)
+        {
+            single_thread_time = t;
+        }
+
+        std::cout << std::fixed << std::setprecision(3) << std::setw(12) << t << " ("
+                  << std::setprecision(2) << single_thread_time / t << "x)";
+    }
+    std::cout << std::endl;
+}
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    const size_t num_elements = argc > 1 ? std::atoi(argv[1]) : 4000000;
+    const size_t matrix_size = argc > 2 ? std::atoi(argv[2]) : 512;
+    const size_t max_num_threads = std::max(1U, std::thread::hardware_concurrency());
+    const size_t grid_size = static_cast<size_t>(std::sqrt(static_cast<double>(num_elements)));
+
+    plot_tool::Vector<double> x(num_elements), y(num_elements), z(num_elements);
+    for (size_t k = 0; k < num_elements; k++)
+    {
+        x(k) = 20.0 * std::rand() / RAND_MAX - 10.0;
+        y(k) = 20.0 * std::rand() / RAND_MAX - 10.0;
+    }
+
+    plot_tool::Matrix<double> m0(matrix_size, matrix_size), m1(matrix_size, matrix_size);
+    for (size_t r = 0; r < matrix_size; r++)
+    {
+        for (size_t c = 0; c < matrix_size; c++)
+        {
+            m0(r, c) = static_cast<double>(std::rand()) / RAND_MAX;
+            m1(r, c) = static_cast<double>(std::rand()) / RAND_MAX;
+        }
+    }
+    plot_tool::Matrix<double> x_grid, y_grid, m_res;
+
+    std::cout << num_elements << " elements, " << matrix_size << "x" << matrix_size
+              << " matrices, times in ms" << std::endl;
+    std::cout << std::setw(24) << "threads";
+    for (size_t num_threads = 1; num_threads <= max_num_threads; num_threads *= 2)
+    {
+        std::cout << std::setw(20) << num_threads;
+    }
+    std::cout << std::endl;
+
+    timeWithThreadCounts("x * y + 2 * x", max_num_threads, [&] { z = x * y + 2.0 * x; });
+    timeWithThreadCounts("sin(x) + cos(y)", max_num_threads, [&] { z = sin(x) + cos(y); });
+    timeWithThreadCounts("sum(x)", max_num_threads, [&] { z(0) = sum(x); });
+    timeWithThreadCounts("max(x)", max_num_threads, [&] { z(0) = max(x); });
+    timeWithThreadCounts("linspace", max_num_threads, [&] {
+        z = plot_tool::linspaceFromPointsAndCount(0.0, 1.0, num_elements);
+    });
+    timeWithThreadCounts("meshGrid", max_num_threads, [&] {
+        std::tie(x_grid, y_grid) = plot_tool::meshGrid(0.0, 1.0, 0.0, 1.0, grid_size, grid_size);
+    });
+    timeWithThreadCounts("Matrix * Matrix", max_num_threads, [&] { m_res = m0 * m1; });
+
+    return 0;
+}
@@ -22,10 +22,12 @@ private:
     size_t num_rows;
     size_t num_cols;
     bool is_allocated;
+    MemoryResource* memory_resource;
 
 public:
     ImageC1();
     ImageC1(const size_t num_rows_, const size_t num_cols_);
+    ImageC1(const size_t num_rows_, const size_t num_cols_, MemoryResource* const memory_resource_);
     ~ImageC1();
 
     T& operator()(const size_t r, const size_t c);
@@ -52,24 +54,43 @@ public:
                      const size_t height) const;
     size_t numElements() const;
     T* getDataPointer() const;
+    MemoryResource* memoryResource() const;
 };
 
 template <typename T> ImageC1<T>::~ImageC1()
 {
     if (is_allocated)
     {
-        delete[] data;
+        internal::deallocateElements(memory_resource, data, num_rows * num_cols);
         is_allocated = false;
         num_rows = 0;
         num_cols = 0;
     }
 }
 
-template <typename T> ImageC1<T>::ImageC1() : num_rows(0), num_cols(0), is_allocated(false) {}
+template <typename T>
+ImageC1<T>::ImageC1()
+    : data(nullptr),
+      num_rows(0),
+      num_cols(0),
+      is_allocated(false),
+      memory_resource(defaultMemoryResource())
+{
+}
 
-template <typename T> ImageC1<T>::ImageC1(const size_t num_rows_, const size_t num_cols_)
+template <typename T>
+ImageC1<T>::ImageC1(const size_t num_rows_, const size_t num_cols_)
+    : ImageC1(num_rows_, num_cols_, defaultMemoryResource())
 {
-    data = new T[num_rows_ * num_cols_];
+}
+
+template <typename T>
+ImageC1<T>::ImageC1(const size_t num_rows_,
+                    const size_t num_cols_,
+                    MemoryResource* const memory_resource_)
+    : memory_resource(memory_resource_)
+{
+    data = internal::allocateElements<T>(memory_resource, num_rows_ * num_cols_, "ImageC1");
     num_rows = num_rows_;
     num_cols = num_cols_;
     is_allocated = true;
@@ -79,13 +100,13 @@ template <typename T> void ImageC1<T>::reallocate(const size_t num_rows_, const
 {
     if (is_allocated)
     {
-        delete[] data;
+        internal::deallocateElements(memory_resource, data, num_rows * num_cols);
         is_allocated = false;
         num_rows = 0;
         num_cols = 0;
     }
 
-    data = new T[num_rows_ * num_cols_];
+    data = internal::allocateElements<T>(memory_resource, num_rows_ * num_cols_, "ImageC1");
     num_rows = num_rows_;
     num_cols = num_cols_;
     is_allocated = true;
@@ -121,6 +142,11 @@ template <typename T> T* ImageC1<T>::getDataPointer() const
     return data;
 }
 
+template <typename T> MemoryResource* ImageC1<T>::memoryResource() const
+{
+    return memory_resource;
+}
+
 template <typename T> Vector<T> ImageC1<T>::getImageCol(const size_t col) const
 {
     Vector<T> image_col(num_rows);
@@ -7,6 +7,7 @@
 #include <sys/un.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <chrono>
 #include <iostream>
 #include <string>
@@ -79,6 +80,54 @@ template <template <typename> class C, typename T> void sendData(const C<T>& dat
         raw_ptr, getClientSocketHandle(), data_to_send.numElements() * sizeof(T), max_elements_);
 }
 
+namespace internal
+{
+// Strided and non-double views are converted to double in chunks of this many bytes, a whole
+// number of transmissions, so that the server receives the same packets as from one buffer
+constexpr size_t gather_buffer_num_bytes = 32 * max_elements_;
+
+template <typename V> void gatherAndSendData(const V& view)
+{
+    const size_t num_elements = view.numElements();
+    const size_t chunk_num_elements = gather_buffer_num_bytes / sizeof(double);
+    std::vector<double> buffer(std::min(num_elements, chunk_num_elements));
+
+    for (size_t begin = 0; begin < num_elements; begin += chunk_num_elements)
+    {
+        const size_t end = std::min(begin + chunk_num_elements, num_elements);
+        view.copyTo(buffer.data(), begin, end);
+        sendData(reinterpret_cast<const char*>(buffer.data()), (end - begin) * sizeof(double));
+    }
+}
+}  // namespace internal
+
+// Contiguous double data is sent directly from the viewed memory, other views are gathered
+template <typename T> void sendData(const VectorView<T>& data_to_send)
+{
+    if (std::is_same<T, double>::value && data_to_send.isContiguous())
+    {
+        sendData(reinterpret_cast<const char*>(data_to_send.getDataPointer()),
+                 data_to_send.numElements() * sizeof(T));
+    }
+    else
+    {
+        internal::gatherAndSendData(data_to_send);
+    }
+}
+
+template <typename T> void sendData(const MatrixView<T>& data_to_send)
+{
+    if (std::is_same<T, double>::value && data_to_send.isContiguous())
+    {
+        sendData(reinterpret_cast<const char*>(data_to_send.getDataPointer()),
+                 data_to_send.numElements() * sizeof(T));
+    }
+    else
+    {
+        internal::gatherAndSendData(data_to_send);
+    }
+}
+
 inline void waitForAckInternal()
 {
     waitForAck(getClientSocketHandle());
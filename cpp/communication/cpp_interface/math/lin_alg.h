@@ -3,9 +3,12 @@
 
 #include "math/lin_alg/matrix_dynamic/matrix_dynamic.h"
 #include "math/lin_alg/matrix_vector_dynamic.h"
+#include "math/lin_alg/matrix_vector_fixed.h"
 #include "math/lin_alg/vector_dynamic/vector_dynamic.h"
 #include "math/lin_alg/vector_low_dim/vec2d.h"
 #include "math/lin_alg/vector_low_dim/vec3d.h"
 #include "math/lin_alg/vector_low_dim/vec4d.h"
+#include "math/lin_alg/views/matrix_view.h"
+#include "math/lin_alg/views/vector_view.h"
 
 #endif
@@ -0,0 +1,15 @@
+#ifndef PLOT_TOOL_ELEMENTWISE_EXPRESSION_CLASS_H_
+#define PLOT_TOOL_ELEMENTWISE_EXPRESSION_CLASS_H_
+
+namespace plot_tool
+{
+// Base of Vector, Matrix and the lazy elementwise expressions built from them. E is the derived
+// type and C the container type the expression evaluates to, Vector<T> or Matrix<T>.
+template <typename E, typename C> class ElementwiseExpression
+{
+public:
+    const E& derived() const;
+};
+}  // namespace plot_tool
+
+#endif
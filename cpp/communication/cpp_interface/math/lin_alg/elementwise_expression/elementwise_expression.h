@@ -0,0 +1,700 @@
+#ifndef PLOT_TOOL_ELEMENTWISE_EXPRESSION_H_
+#define PLOT_TOOL_ELEMENTWISE_EXPRESSION_H_
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "logging.h"
+#include "math/math_core.h"
+#include "math/misc/thread_pool.h"
+#include "math/misc/vectorized_math_functions.h"
+
+// Elementwise arithmetic and math functions on Vector and Matrix are evaluated lazily. Each
+// operator returns a small expression object instead of a new container, and the whole
+// expression, e.g. sin(2.0 * r) / r + 0.1412, is evaluated with a single allocation when it's
+// assigned to a Vector or Matrix, or passed to a plot function. Evaluation goes through the
+// expression in blocks of expression_block_size elements, small enough to stay in the L1 cache,
+// and each operation is applied to a whole block at a time, so that the math functions can use
+// the vectorized kernels in vectorized_math_functions.h. Large expressions are split into
+// ranges of blocks that are evaluated on the shared thread pool.
+// Temporary containers in an expression, e.g. the result of a function, are moved into it, but
+// named containers are read in place, so an expression stored in an auto variable must not
+// outlive the named containers it was built from, and sees changes made to them before it's
+// evaluated. expression.eval() gives a container. Expressions have the read-only members size(),
+// numElements(), rows(), cols(), max(), min(), sum() and norm(), the reductions evaluate the
+// expression first. Functions that aren't elementwise, e.g. matrix multiplication, take
+// containers, and evaluate(expression) gives one.
+
+namespace plot_tool
+{
+template <typename E, typename C> const E& ElementwiseExpression<E, C>::derived() const
+{
+    return static_cast<const E&>(*this);
+}
+
+// Number of elements evaluated at a time
+constexpr size_t expression_block_size = 256;
+
+template <typename C> struct ContainerElementType;
+
+template <typename T> struct ContainerElementType<Vector<T>>
+{
+    using Type = T;
+};
+
+template <typename T> struct ContainerElementType<Matrix<T>>
+{
+    using Type = T;
+};
+
+template <typename T> size_t numContainerRows(const Vector<T>& v)
+{
+    return v.size();
+}
+
+template <typename T> size_t numContainerRows(const Matrix<T>& m)
+{
+    return m.rows();
+}
+
+template <typename T> size_t numContainerCols(const Vector<T>&)
+{
+    return 1;
+}
+
+template <typename T> size_t numContainerCols(const Matrix<T>& m)
+{
+    return m.cols();
+}
+
+// Vector or Matrix in an expression, read directly through its data pointer. Temporaries are
+// moved into the operand, shared by the copies of the expression, and named containers are
+// referenced.
+template <typename C> class ContainerOperand
+{
+public:
+    using ValueType = typename ContainerElementType<C>::Type;
+
+private:
+    std::shared_ptr<const C> owned_container_;
+    const ValueType* data_;
+    size_t num_rows_;
+    size_t num_cols_;
+
+public:
+    explicit ContainerOperand(const C& c)
+        : data_(c.getDataPointer()), num_rows_(numContainerRows(c)), num_cols_(numContainerCols(c))
+    {
+    }
+
+    explicit ContainerOperand(C&& c)
+        : owned_container_(std::make_shared<const C>(std::move(c))),
+          data_(owned_container_->getDataPointer()),
+          num_rows_(numContainerRows(*owned_container_)),
+          num_cols_(numContainerCols(*owned_container_))
+    {
+    }
+
+    // Const temporaries can't be moved from
+    explicit ContainerOperand(const C&& c)
+        : owned_container_(std::make_shared<const C>(c)),
+          data_(owned_container_->getDataPointer()),
+          num_rows_(numContainerRows(*owned_container_)),
+          num_cols_(numContainerCols(*owned_container_))
+    {
+    }
+
+    size_t rows() const
+    {
+        return num_rows_;
+    }
+
+    size_t cols() const
+    {
+        return num_cols_;
+    }
+
+    // Writes the num_elements elements from idx to out
+    void evaluateBlock(const size_t idx, const size_t num_elements, ValueType* const out) const
+    {
+        std::copy(data_ + idx, data_ + idx + num_elements, out);
+    }
+};
+
+// How an expression is stored in the expressions using it, containers as ContainerOperand and
+// expressions by value. E may be a reference type, as deduced for a forwarding reference.
+template <typename E> struct DecayedExpressionOperand
+{
+    using Type = E;
+};
+
+template <typename T> struct DecayedExpressionOperand<Vector<T>>
+{
+    using Type = ContainerOperand<Vector<T>>;
+};
+
+template <typename T> struct DecayedExpressionOperand<Matrix<T>>
+{
+    using Type = ContainerOperand<Matrix<T>>;
+};
+
+template <typename E> struct ExpressionOperand
+{
+    using Type = typename DecayedExpressionOperand<typename std::decay<E>::type>::Type;
+};
+
+// Read-only members of the expressions, evaluated first where they need the values
+template <typename E, typename C> class ExpressionNode : public ElementwiseExpression<E, C>
+{
+public:
+    using ValueType = typename ContainerElementType<C>::Type;
+
+    size_t size() const
+    {
+        return this->derived().rows() * this->derived().cols();
+    }
+
+    size_t numElements() const
+    {
+        return size();
+    }
+
+    C eval() const
+    {
+        return C(this->derived());
+    }
+
+    ValueType max() const
+    {
+        return eval().max();
+    }
+
+    ValueType min() const
+    {
+        return eval().min();
+    }
+
+    ValueType sum() const
+    {
+        return eval().sum();
+    }
+
+    // Vector expressions only
+    ValueType norm() const
+    {
+        return eval().norm();
+    }
+};
+
+template <typename A, typename Op, typename C>
+class UnaryExpression : public ExpressionNode<UnaryExpression<A, Op, C>, C>
+{
+public:
+    using ValueType = typename ContainerElementType<C>::Type;
+
+private:
+    A operand_;
+    Op op_;
+
+public:
+    template <typename X>
+    UnaryExpression(X&& operand, const Op& op) : operand_(std::forward<X>(operand)), op_(op)
+    {
+    }
+
+    size_t rows() const
+    {
+        return operand_.rows();
+    }
+
+    size_t cols() const
+    {
+        return operand_.cols();
+    }
+
+    void evaluateBlock(const size_t idx, const size_t num_elements, ValueType* const out) const
+    {
+        operand_.evaluateBlock(idx, num_elements, out);
+        op_.applyInPlace(out, num_elements);
+    }
+};
+
+template <typename L, typename R, typename Op, typename C>
+class BinaryExpression : public ExpressionNode<BinaryExpression<L, R, Op, C>, C>
+{
+public:
+    using ValueType = typename ContainerElementType<C>::Type;
+
+private:
+    L lhs_;
+    R rhs_;
+    Op op_;
+
+public:
+    template <typename X, typename Y>
+    BinaryExpression(X&& lhs, Y&& rhs)
+        : lhs_(std::forward<X>(lhs)), rhs_(std::forward<Y>(rhs)), op_()
+    {
+        PT_ASSERT((lhs_.rows() == rhs_.rows()) && (lhs_.cols() == rhs_.cols()))
+            << "Operands of elementwise operation have different dimensions!";
+    }
+
+    size_t rows() const
+    {
+        return lhs_.rows();
+    }
+
+    size_t cols() const
+    {
+        return lhs_.cols();
+    }
+
+    void evaluateBlock(const size_t idx, const size_t num_elements, ValueType* const out) const
+    {
+        ValueType rhs_values[expression_block_size];
+        lhs_.evaluateBlock(idx, num_elements, out);
+        rhs_.evaluateBlock(idx, num_elements, rhs_values);
+
+        for (size_t k = 0; k < num_elements; k++)
+        {
+            out[k] = op_(out[k], rhs_values[k]);
+        }
+    }
+};
+
+// Container type that an expression, Vector or Matrix evaluates to. There is none for other
+// types, which removes the operators and functions below from overload resolution for them.
+template <typename E> struct DecayedExpressionContainer
+{
+};
+
+template <typename T> struct DecayedExpressionContainer<Vector<T>>
+{
+    using Type = Vector<T>;
+};
+
+template <typename T> struct DecayedExpressionContainer<Matrix<T>>
+{
+    using Type = Matrix<T>;
+};
+
+template <typename A, typename Op, typename C>
+struct DecayedExpressionContainer<UnaryExpression<A, Op, C>>
+{
+    using Type = C;
+};
+
+template <typename L, typename R, typename Op, typename C>
+struct DecayedExpressionContainer<BinaryExpression<L, R, Op, C>>
+{
+    using Type = C;
+};
+
+template <typename E>
+using ExpressionContainerOf =
+    typename DecayedExpressionContainer<typename std::decay<E>::type>::Type;
+
+template <typename E>
+using ExpressionScalarOf = typename ContainerElementType<ExpressionContainerOf<E>>::Type;
+
+// E, L and R are the types deduced for the forwarding reference operands
+template <typename E, typename Op>
+using UnaryExpressionOf =
+    UnaryExpression<typename ExpressionOperand<E>::Type, Op, ExpressionContainerOf<E>>;
+
+template <typename L, typename R, typename Op>
+using BinaryExpressionOf = typename std::enable_if<
+    std::is_same<ExpressionContainerOf<L>, ExpressionContainerOf<R>>::value,
+    BinaryExpression<typename ExpressionOperand<L>::Type,
+                     typename ExpressionOperand<R>::Type,
+                     Op,
+                     ExpressionContainerOf<L>>>::type;
+
+struct AddOperation
+{
+    template <typename T> T operator()(const T a, const T b) const
+    {
+        return a + b;
+    }
+};
+
+struct SubtractOperation
+{
+    template <typename T> T operator()(const T a, const T b) const
+    {
+        return a - b;
+    }
+};
+
+struct MultiplyOperation
+{
+    template <typename T> T operator()(const T a, const T b) const
+    {
+        return a * b;
+    }
+};
+
+struct DivideOperation
+{
+    template <typename T> T operator()(const T a, const T b) const
+    {
+        return a / b;
+    }
+};
+
+// Only used through ScalarRightOperation
+struct PowOperation
+{
+};
+
+struct NegateOperation
+{
+    template <typename T> void applyInPlace(T* const values, const size_t num_values) const
+    {
+        for (size_t k = 0; k < num_values; k++)
+        {
+            values[k] = -values[k];
+        }
+    }
+};
+
+struct SinOperation
+{
+    template <typename T> void applyInPlace(T* const values, const size_t num_values) const
+    {
+        internal::sinInPlace(values, num_values);
+    }
+};
+
+struct CosOperation
+{
+    template <typename T> void applyInPlace(T* const values, const size_t num_values) const
+    {
+        internal::cosInPlace(values, num_values);
+    }
+};
+
+struct ExpOperation
+{
+    template <typename T> void applyInPlace(T* const values, const size_t num_values) const
+    {
+        internal::expInPlace(values, num_values);
+    }
+};
+
+struct LogOperation
+{
+    template <typename T> void applyInPlace(T* const values, const size_t num_values) const
+    {
+        internal::logInPlace(values, num_values);
+    }
+};
+
+struct Log10Operation
+{
+    template <typename T> void applyInPlace(T* const values, const size_t num_values) const
+    {
+        internal::log10InPlace(values, num_values);
+    }
+};
+
+struct SqrtOperation
+{
+    template <typename T> void applyInPlace(T* const values, const size_t num_values) const
+    {
+        internal::sqrtInPlace(values, num_values);
+    }
+};
+
+struct AbsOperation
+{
+    template <typename T> void applyInPlace(T* const values, const size_t num_values) const
+    {
+        for (size_t k = 0; k < num_values; k++)
+        {
+            values[k] = std::fabs(values[k]);
+        }
+    }
+};
+
+struct RoundOperation
+{
+    template <typename T> void applyInPlace(T* const values, const size_t num_values) const
+    {
+        for (size_t k = 0; k < num_values; k++)
+        {
+            values[k] = std::round(values[k]);
+        }
+    }
+};
+
+// Binary operation with a scalar as left or right operand, as a unary operation
+template <typename Op, typename T> class ScalarLeftOperation
+{
+private:
+    Op op_;
+    T scalar_;
+
+public:
+    explicit ScalarLeftOperation(const T scalar) : op_(), scalar_(scalar) {}
+
+    void applyInPlace(T* const values, const size_t num_values) const
+    {
+        for (size_t k = 0; k < num_values; k++)
+        {
+            values[k] = op_(scalar_, values[k]);
+        }
+    }
+};
+
+template <typename Op, typename T> class ScalarRightOperation
+{
+private:
+    Op op_;
+    T scalar_;
+
+public:
+    explicit ScalarRightOperation(const T scalar) : op_(), scalar_(scalar) {}
+
+    void applyInPlace(T* const values, const size_t num_values) const
+    {
+        for (size_t k = 0; k < num_values; k++)
+        {
+            values[k] = op_(values[k], scalar_);
+        }
+    }
+};
+
+template <typename T> class ScalarRightOperation<PowOperation, T>
+{
+private:
+    T exponent_;
+
+public:
+    explicit ScalarRightOperation(const T exponent) : exponent_(exponent) {}
+
+    void applyInPlace(T* const values, const size_t num_values) const
+    {
+        internal::powInPlace(values, num_values, exponent_);
+    }
+};
+
+template <typename Op, typename E>
+using ScalarLeftOperationOf = ScalarLeftOperation<Op, ExpressionScalarOf<E>>;
+
+template <typename Op, typename E>
+using ScalarRightOperationOf = ScalarRightOperation<Op, ExpressionScalarOf<E>>;
+
+// Writes the elements of expression, an expression operand, to out, which may be one of the
+// containers in it, since each block is evaluated completely before it's written
+template <typename E, typename T> void evaluateExpression(const E& expression, T* const out)
+{
+    const size_t num_elements = expression.rows() * expression.cols();
+
+    const auto evaluate_range = [&](const size_t begin, const size_t end) {
+        typename E::ValueType block[expression_block_size];
+        for (size_t idx = begin; idx < end; idx += expression_block_size)
+        {
+            const size_t num_block_elements = std::min(expression_block_size, end - idx);
+            expression.evaluateBlock(idx, num_block_elements, block);
+
+            for (size_t k = 0; k < num_block_elements; k++)
+            {
+                out[idx + k] = static_cast<T>(block[k]);
+            }
+        }
+    };
+
+    internal::parallelFor(num_elements, expression_block_size, num_elements, evaluate_range);
+}
+
+template <typename T> const Vector<T>& evaluate(const Vector<T>& v)
+{
+    return v;
+}
+
+template <typename T> const Matrix<T>& evaluate(const Matrix<T>& m)
+{
+    return m;
+}
+
+template <typename E, typename C> C evaluate(const ElementwiseExpression<E, C>& e)
+{
+    return C(e);
+}
+
+// Elementwise operations between containers and expressions of the same type. Operands are
+// forwarding references, so that temporary containers can be moved into the expression.
+template <typename L, typename R>
+BinaryExpressionOf<L, R, AddOperation> operator+(L&& lhs, R&& rhs)
+{
+    return BinaryExpressionOf<L, R, AddOperation>(std::forward<L>(lhs), std::forward<R>(rhs));
+}
+
+template <typename L, typename R>
+BinaryExpressionOf<L, R, SubtractOperation> operator-(L&& lhs, R&& rhs)
+{
+    return BinaryExpressionOf<L, R, SubtractOperation>(std::forward<L>(lhs), std::forward<R>(rhs));
+}
+
+template <typename L, typename R>
+BinaryExpressionOf<L, R, MultiplyOperation> operator^(L&& lhs, R&& rhs)
+{
+    return BinaryExpressionOf<L, R, MultiplyOperation>(std::forward<L>(lhs), std::forward<R>(rhs));
+}
+
+template <typename L, typename R>
+BinaryExpressionOf<L, R, DivideOperation> operator/(L&& lhs, R&& rhs)
+{
+    return BinaryExpressionOf<L, R, DivideOperation>(std::forward<L>(lhs), std::forward<R>(rhs));
+}
+
+// Elementwise operations with scalars
+template <typename E>
+UnaryExpressionOf<E, ScalarRightOperationOf<AddOperation, E>> operator+(
+    E&& e, const ExpressionScalarOf<E> f)
+{
+    return UnaryExpressionOf<E, ScalarRightOperationOf<AddOperation, E>>(
+        std::forward<E>(e), ScalarRightOperationOf<AddOperation, E>(f));
+}
+
+template <typename E>
+UnaryExpressionOf<E, ScalarLeftOperationOf<AddOperation, E>> operator+(
+    const ExpressionScalarOf<E> f, E&& e)
+{
+    return UnaryExpressionOf<E, ScalarLeftOperationOf<AddOperation, E>>(
+        std::forward<E>(e), ScalarLeftOperationOf<AddOperation, E>(f));
+}
+
+template <typename E>
+UnaryExpressionOf<E, ScalarRightOperationOf<SubtractOperation, E>> operator-(
+    E&& e, const ExpressionScalarOf<E> f)
+{
+    return UnaryExpressionOf<E, ScalarRightOperationOf<SubtractOperation, E>>(
+        std::forward<E>(e), ScalarRightOperationOf<SubtractOperation, E>(f));
+}
+
+template <typename E>
+UnaryExpressionOf<E, ScalarLeftOperationOf<SubtractOperation, E>> operator-(
+    const ExpressionScalarOf<E> f, E&& e)
+{
+    return UnaryExpressionOf<E, ScalarLeftOperationOf<SubtractOperation, E>>(
+        std::forward<E>(e), ScalarLeftOperationOf<SubtractOperation, E>(f));
+}
+
+template <typename E>
+UnaryExpressionOf<E, ScalarRightOperationOf<MultiplyOperation, E>> operator*(
+    E&& e, const ExpressionScalarOf<E> f)
+{
+    return UnaryExpressionOf<E, ScalarRightOperationOf<MultiplyOperation, E>>(
+        std::forward<E>(e), ScalarRightOperationOf<MultiplyOperation, E>(f));
+}
+
+template <typename E>
+UnaryExpressionOf<E, ScalarLeftOperationOf<MultiplyOperation, E>> operator*(
+    const ExpressionScalarOf<E> f, E&& e)
+{
+    return UnaryExpressionOf<E, ScalarLeftOperationOf<MultiplyOperation, E>>(
+        std::forward<E>(e), ScalarLeftOperationOf<MultiplyOperation, E>(f));
+}
+
+template <typename E>
+UnaryExpressionOf<E, ScalarRightOperationOf<DivideOperation, E>> operator/(
+    E&& e, const ExpressionScalarOf<E> f)
+{
+    return UnaryExpressionOf<E, ScalarRightOperationOf<DivideOperation, E>>(
+        std::forward<E>(e), ScalarRightOperationOf<DivideOperation, E>(f));
+}
+
+template <typename E>
+UnaryExpressionOf<E, ScalarLeftOperationOf<DivideOperation, E>> operator/(
+    const ExpressionScalarOf<E> f, E&& e)
+{
+    return UnaryExpressionOf<E, ScalarLeftOperationOf<DivideOperation, E>>(
+        std::forward<E>(e), ScalarLeftOperationOf<DivideOperation, E>(f));
+}
+
+template <typename E> UnaryExpressionOf<E, NegateOperation> operator-(E&& e)
+{
+    return UnaryExpressionOf<E, NegateOperation>(std::forward<E>(e), NegateOperation());
+}
+
+// Elementwise math functions
+template <typename E>
+UnaryExpressionOf<E, ScalarRightOperationOf<PowOperation, E>> pow(
+    E&& e, const ExpressionScalarOf<E> exponent)
+{
+    return UnaryExpressionOf<E, ScalarRightOperationOf<PowOperation, E>>(
+        std::forward<E>(e), ScalarRightOperationOf<PowOperation, E>(exponent));
+}
+
+template <typename E> UnaryExpressionOf<E, SinOperation> sin(E&& e)
+{
+    return UnaryExpressionOf<E, SinOperation>(std::forward<E>(e), SinOperation());
+}
+
+template <typename E> UnaryExpressionOf<E, CosOperation> cos(E&& e)
+{
+    return UnaryExpressionOf<E, CosOperation>(std::forward<E>(e), CosOperation());
+}
+
+template <typename E> UnaryExpressionOf<E, ExpOperation> exp(E&& e)
+{
+    return UnaryExpressionOf<E, ExpOperation>(std::forward<E>(e), ExpOperation());
+}
+
+template <typename E> UnaryExpressionOf<E, LogOperation> log(E&& e)
+{
+    return UnaryExpressionOf<E, LogOperation>(std::forward<E>(e), LogOperation());
+}
+
+template <typename E> UnaryExpressionOf<E, Log10Operation> log10(E&& e)
+{
+    return UnaryExpressionOf<E, Log10Operation>(std::forward<E>(e), Log10Operation());
+}
+
+template <typename E> UnaryExpressionOf<E, SqrtOperation> sqrt(E&& e)
+{
+    return UnaryExpressionOf<E, SqrtOperation>(std::forward<E>(e), SqrtOperation());
+}
+
+template <typename E> UnaryExpressionOf<E, AbsOperation> abs(E&& e)
+{
+    return UnaryExpressionOf<E, AbsOperation>(std::forward<E>(e), AbsOperation());
+}
+
+template <typename E> UnaryExpressionOf<E, RoundOperation> round(E&& e)
+{
+    return UnaryExpressionOf<E, RoundOperation>(std::forward<E>(e), RoundOperation());
+}
+
+// Reductions of expressions, evaluated first
+template <typename E, typename C>
+typename ContainerElementType<C>::Type max(const ElementwiseExpression<E, C>& e)
+{
+    return max(evaluate(e.derived()));
+}
+
+template <typename E, typename C>
+typename ContainerElementType<C>::Type min(const ElementwiseExpression<E, C>& e)
+{
+    return min(evaluate(e.derived()));
+}
+
+template <typename E, typename C>
+typename ContainerElementType<C>::Type maxAbs(const ElementwiseExpression<E, C>& e)
+{
+    return maxAbs(evaluate(e.derived()));
+}
+
+template <typename E, typename C>
+typename ContainerElementType<C>::Type minAbs(const ElementwiseExpression<E, C>& e)
+{
+    return minAbs(evaluate(e.derived()));
+}
+}  // namespace plot_tool
+
+#endif
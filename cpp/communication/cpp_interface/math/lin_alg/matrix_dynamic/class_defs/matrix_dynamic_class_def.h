@@ -3,23 +3,26 @@
 
 namespace plot_tool
 {
-template <typename T> class Matrix
+template <typename T> class Matrix : public ElementwiseExpression<Matrix<T>, Matrix<T>>
 {
 protected:
     T* data_;
     size_t num_rows_;
     size_t num_cols_;
     bool is_allocated_;
+    MemoryResource* memory_resource_;
 
 public:
     Matrix();
     Matrix(const size_t num_rows, const size_t num_cols);
+    Matrix(const size_t num_rows, const size_t num_cols, MemoryResource* const memory_resource);
     Matrix(const Matrix<T>& m);
     template <typename Y> Matrix(const Matrix<Y>& m);
     Matrix(const std::vector<std::vector<T>>& vm);
     Matrix(const std::initializer_list<std::initializer_list<T>>& il);
     Matrix(Matrix<T>&& m);
     Matrix(const T a[3][3]);
+    template <typename E, typename Y> Matrix(const ElementwiseExpression<E, Matrix<Y>>& e);
     ~Matrix();
 
     Matrix<T>&& move();
@@ -39,6 +42,8 @@ public:
     const T& operator()(const size_t r, const EndIndex& col_end_idx) const;
     Matrix<T>& operator=(const Matrix<T>& m);
     Matrix<T>& operator=(Matrix<T>&& m);
+    template <typename E, typename Y>
+    Matrix<T>& operator=(const ElementwiseExpression<E, Matrix<Y>>& e);
 
     void removeRowAtIndex(const size_t row_idx);
     void removeRowsAtIndices(const IndexSpan& idx_span);
@@ -67,6 +72,7 @@ public:
     void switchRows(size_t r0, size_t r1);
     void switchColumns(size_t c0, size_t c1);
     T* getDataPointer() const;
+    MemoryResource* memoryResource() const;
     void setInternalData(T* const input_ptr, const size_t num_rows, const size_t num_cols);
     Matrix<T> getTranspose() const;
     void transpose();
@@ -5,7 +5,10 @@
 #include <cmath>
 
 #include "logging.h"
+#include "math/lin_alg/elementwise_expression/elementwise_expression.h"
+#include "math/lin_alg/matrix_dynamic/matrix_multiplication.h"
 #include "math/math_core.h"
+#include "math/misc/array_reductions.h"
 #include "math/misc/math_macros.h"
 
 namespace plot_tool
@@ -19,13 +22,14 @@ template <typename T> Matrix<T>& Matrix<T>::operator=(const Matrix<T>& m)
         {
             if ((m.rows() != num_rows_) || (m.cols() != num_cols_))
             {
-                delete[] data_;
-                DATA_ALLOCATION(data_, m.rows() * m.cols(), T, "Matrix");
+                internal::deallocateElements(memory_resource_, data_, num_rows_ * num_cols_);
+                data_ = internal::allocateElements<T>(
+                    memory_resource_, m.rows() * m.cols(), "Matrix");
             }
         }
         else
         {
-            DATA_ALLOCATION(data_, m.rows() * m.cols(), T, "Matrix");
+            data_ = internal::allocateElements<T>(memory_resource_, m.rows() * m.cols(), "Matrix");
         }
 
         num_rows_ = m.rows();
@@ -44,13 +48,13 @@ template <typename T> Matrix<T>& Matrix<T>::operator=(const Matrix<T>& m)
     return *this;
 }
 
-template <typename T> Matrix<T>::Matrix(const T a[3][3])
+template <typename T> Matrix<T>::Matrix(const T a[3][3]) : memory_resource_(defaultMemoryResource())
 {
     is_allocated_ = true;
     num_rows_ = 3;
     num_cols_ = 3;
 
-    DATA_ALLOCATION(data_, 9, T, "Matrix");
+    data_ = internal::allocateElements<T>(memory_resource_, 9, "Matrix");
     for (size_t r = 0; r < 3; r++)
     {
         for (size_t c = 0; c < 3; c++)
@@ -66,6 +70,7 @@ template <typename T> Matrix<T>::Matrix(Matrix<T>&& m)
     data_ = m.getDataPointer();
     num_rows_ = m.rows();
     num_cols_ = m.cols();
+    memory_resource_ = m.memory_resource_;
 
     is_allocated_ = true;
     m.setInternalData(nullptr, 0, 0);
@@ -73,13 +78,14 @@ template <typename T> Matrix<T>::Matrix(Matrix<T>&& m)
 
 template <typename T>
 template <typename Y>
-Matrix<T>::Matrix(const Matrix<Y>& m) : is_allocated_(true)
+Matrix<T>::Matrix(const Matrix<Y>& m)
+    : is_allocated_(true), memory_resource_(defaultMemoryResource())
 {
     PT_ASSERT(m.isAllocated()) << "Input matrix not allocated!";
     num_rows_ = m.rows();
     num_cols_ = m.cols();
 
-    DATA_ALLOCATION(data_, m.rows() * m.cols(), T, "Matrix");
+    data_ = internal::allocateElements<T>(memory_resource_, m.rows() * m.cols(), "Matrix");
     for (size_t r = 0; r < m.rows(); r++)
     {
         for (size_t c = 0; c < m.cols(); c++)
@@ -89,6 +95,52 @@ Matrix<T>::Matrix(const Matrix<Y>& m) : is_allocated_(true)
     }
 }
 
+template <typename T>
+template <typename E, typename Y>
+Matrix<T>::Matrix(const ElementwiseExpression<E, Matrix<Y>>& e)
+    : is_allocated_(true), memory_resource_(defaultMemoryResource())
+{
+    const typename ExpressionOperand<E>::Type expr(e.derived());
+    num_rows_ = expr.rows();
+    num_cols_ = expr.cols();
+
+    data_ = internal::allocateElements<T>(memory_resource_, num_rows_ * num_cols_, "Matrix");
+    evaluateExpression(expr, data_);
+}
+
+template <typename T>
+template <typename E, typename Y>
+Matrix<T>& Matrix<T>::operator=(const ElementwiseExpression<E, Matrix<Y>>& e)
+{
+    const typename ExpressionOperand<E>::Type expr(e.derived());
+
+    // Evaluated in place if the size is the same, which is safe also if this matrix is in the
+    // expression, since each element only depends on the elements at the same index, and each
+    // block is evaluated before it's written
+    if (is_allocated_)
+    {
+        if ((expr.rows() * expr.cols()) != (num_rows_ * num_cols_))
+        {
+            internal::deallocateElements(memory_resource_, data_, num_rows_ * num_cols_);
+            data_ = internal::allocateElements<T>(
+                memory_resource_, expr.rows() * expr.cols(), "Matrix");
+        }
+    }
+    else
+    {
+        data_ = internal::allocateElements<T>(
+            memory_resource_, expr.rows() * expr.cols(), "Matrix");
+    }
+
+    num_rows_ = expr.rows();
+    num_cols_ = expr.cols();
+    is_allocated_ = true;
+
+    evaluateExpression(expr, data_);
+
+    return *this;
+}
+
 template <typename T> Matrix<T>&& Matrix<T>::move()
 {
     return std::move(*this);
@@ -102,12 +154,13 @@ template <typename T> Matrix<T>& Matrix<T>::operator=(Matrix<T>&& m)
 
         if (is_allocated_)
         {
-            delete[] data_;
+            internal::deallocateElements(memory_resource_, data_, num_rows_ * num_cols_);
         }
 
         num_rows_ = m.rows();
         num_cols_ = m.cols();
         is_allocated_ = true;
+        memory_resource_ = m.memory_resource_;
 
         data_ = m.getDataPointer();
 
@@ -196,25 +249,45 @@ template <typename T> Matrix<T> rotationMatrix2D(const T angle)
 }
 
 template <typename T>
-Matrix<T>::Matrix() : data_(nullptr), num_rows_(0), num_cols_(0), is_allocated_(false)
+Matrix<T>::Matrix()
+    : data_(nullptr),
+      num_rows_(0),
+      num_cols_(0),
+      is_allocated_(false),
+      memory_resource_(defaultMemoryResource())
 {
 }
 
 template <typename T>
-Matrix<T>::Matrix(const size_t num_rows, const size_t num_cols) : is_allocated_(true)
+Matrix<T>::Matrix(const size_t num_rows, const size_t num_cols)
+    : is_allocated_(true), memory_resource_(defaultMemoryResource())
 {
     num_rows_ = num_rows;
     num_cols_ = num_cols;
 
-    DATA_ALLOCATION(data_, num_rows_ * num_cols_, T, "Matrix");
+    data_ = internal::allocateElements<T>(memory_resource_, num_rows_ * num_cols_, "Matrix");
 }
 
-template <typename T> Matrix<T>::Matrix(const Matrix<T>& m) : is_allocated_(true)
+template <typename T>
+Matrix<T>::Matrix(const size_t num_rows,
+                  const size_t num_cols,
+                  MemoryResource* const memory_resource)
+    : is_allocated_(true), memory_resource_(memory_resource)
+{
+    num_rows_ = num_rows;
+    num_cols_ = num_cols;
+
+    data_ = internal::allocateElements<T>(memory_resource_, num_rows_ * num_cols_, "Matrix");
+}
+
+template <typename T>
+Matrix<T>::Matrix(const Matrix<T>& m)
+    : is_allocated_(true), memory_resource_(defaultMemoryResource())
 {
     num_rows_ = m.rows();
     num_cols_ = m.cols();
 
-    DATA_ALLOCATION(data_, m.rows() * m.cols(), T, "Matrix");
+    data_ = internal::allocateElements<T>(memory_resource_, m.rows() * m.cols(), "Matrix");
     for (size_t r = 0; r < m.rows(); r++)
     {
         for (size_t c = 0; c < m.cols(); c++)
@@ -224,7 +297,9 @@ template <typename T> Matrix<T>::Matrix(const Matrix<T>& m) : is_allocated_(true
     }
 }
 
-template <typename T> Matrix<T>::Matrix(const std::initializer_list<std::initializer_list<T>>& il)
+template <typename T>
+Matrix<T>::Matrix(const std::initializer_list<std::initializer_list<T>>& il)
+    : memory_resource_(defaultMemoryResource())
 {
     PT_ASSERT(il.size() > 0) << "Tried to initialize with empty vector matrix!";
     PT_ASSERT(il.begin()[0].size() > 0) << "Tried to initialize with empty vector matrix!";
@@ -238,7 +313,7 @@ template <typename T> Matrix<T>::Matrix(const std::initializer_list<std::initial
     num_rows_ = il.size();
     num_cols_ = il.begin()[0].size();
 
-    DATA_ALLOCATION(data_, num_cols_ * num_rows_, T, "Matrix");
+    data_ = internal::allocateElements<T>(memory_resource_, num_cols_ * num_rows_, "Matrix");
     is_allocated_ = true;
 
     for (size_t r = 0; r < il.size(); r++)
@@ -250,7 +325,8 @@ template <typename T> Matrix<T>::Matrix(const std::initializer_list<std::initial
     }
 }
 
-template <typename T> Matrix<T>::Matrix(const std::vector<std::vector<T>>& vm)
+template <typename T>
+Matrix<T>::Matrix(const std::vector<std::vector<T>>& vm) : memory_resource_(defaultMemoryResource())
 {
     PT_ASSERT(vm.size() > 0) << "Tried to initialize with empty vector matrix!";
     PT_ASSERT(vm[0].size() > 0) << "Tried to initialize with empty vector matrix!";
@@ -264,7 +340,7 @@ template <typename T> Matrix<T>::Matrix(const std::vector<std::vector<T>>& vm)
     num_rows_ = vm.size();
     num_cols_ = vm[0].size();
 
-    DATA_ALLOCATION(data_, num_cols_ * num_rows_, T, "Matrix");
+    data_ = internal::allocateElements<T>(memory_resource_, num_cols_ * num_rows_, "Matrix");
     is_allocated_ = true;
 
     for (size_t r = 0; r < vm.size(); r++)
@@ -280,7 +356,7 @@ template <typename T> Matrix<T>::~Matrix()
 {
     if (is_allocated_)
     {
-        delete[] data_;
+        internal::deallocateElements(memory_resource_, data_, num_rows_ * num_cols_);
         is_allocated_ = false;
     }
 }
@@ -289,17 +365,22 @@ template <typename T> void Matrix<T>::resize(const size_t num_rows, const size_t
 {
     if (is_allocated_)
     {
-        delete[] data_;
+        internal::deallocateElements(memory_resource_, data_, num_rows_ * num_cols_);
         is_allocated_ = false;
     }
 
     num_rows_ = num_rows;
     num_cols_ = num_cols;
 
-    DATA_ALLOCATION(data_, num_rows_ * num_cols_, T, "Matrix");
+    data_ = internal::allocateElements<T>(memory_resource_, num_rows_ * num_cols_, "Matrix");
     is_allocated_ = true;
 }
 
+template <typename T> MemoryResource* Matrix<T>::memoryResource() const
+{
+    return memory_resource_;
+}
+
 template <typename T> void Matrix<T>::switchRows(size_t r0, size_t r1)
 {
     assert(r0 < num_rows_ && r1 < num_rows_);
@@ -572,210 +653,12 @@ template <typename T> Matrix<T> operator*(const Matrix<T>& m0, const Matrix<T>&
     assert(m0.cols() == m1.rows());
     Matrix<T> res(m0.rows(), m1.cols());
 
-    for (size_t r = 0; r < res.rows(); r++)
-    {
-        for (size_t c = 0; c < res.cols(); c++)
-        {
-            T p = 0.0f;
-            for (size_t i = 0; i < m0.cols(); i++)
-            {
-                p = p + m0(r, i) * m1(i, c);
-            }
-            res(r, c) = p;
-        }
-    }
-    return res;
-}
-
-template <typename T> Matrix<T> operator+(const Matrix<T>& m0, const Matrix<T>& m1)
-{
-    assert(m0.cols() == m1.cols());
-    assert(m0.rows() == m1.rows());
-    Matrix<T> res(m0.rows(), m1.cols());
-
-    for (size_t r = 0; r < res.rows(); r++)
-    {
-        for (size_t c = 0; c < res.cols(); c++)
-        {
-            res(r, c) = m0(r, c) + m1(r, c);
-        }
-    }
-    return res;
-}
-
-template <typename T> Matrix<T> operator-(const Matrix<T>& m0, const Matrix<T>& m1)
-{
-    assert(m0.cols() == m1.cols());
-    assert(m0.rows() == m1.rows());
-    Matrix<T> res(m0.rows(), m1.cols());
-
-    for (size_t r = 0; r < res.rows(); r++)
-    {
-        for (size_t c = 0; c < res.cols(); c++)
-        {
-            res(r, c) = m0(r, c) - m1(r, c);
-        }
-    }
-    return res;
-}
-
-template <typename T> Matrix<T> operator*(const Matrix<T>& m, const T f)
-{
-    Matrix<T> res(m.rows(), m.cols());
-
-    for (size_t r = 0; r < res.rows(); r++)
-    {
-        for (size_t c = 0; c < res.cols(); c++)
-        {
-            res(r, c) = f * m(r, c);
-        }
-    }
-    return res;
-}
-
-template <typename T> Matrix<T> operator*(const T f, const Matrix<T>& m)
-{
-    Matrix<T> res(m.rows(), m.cols());
-
-    for (size_t r = 0; r < res.rows(); r++)
-    {
-        for (size_t c = 0; c < res.cols(); c++)
-        {
-            res(r, c) = f * m(r, c);
-        }
-    }
-    return res;
-}
-
-template <typename T> Matrix<T> operator^(const Matrix<T>& m0, const Matrix<T>& m1)
-{
-    PT_ASSERT(m0.rows() == m1.rows());
-    PT_ASSERT(m0.cols() == m1.cols());
-
-    Matrix<T> res(m0.rows(), m0.cols());
-
-    for (size_t r = 0; r < res.rows(); r++)
-    {
-        for (size_t c = 0; c < res.cols(); c++)
-        {
-            res(r, c) = m0(r, c) * m1(r, c);
-        }
-    }
-    return res;
-}
-
-template <typename T> Matrix<T> operator/(const Matrix<T>& m0, const Matrix<T>& m1)
-{
-    PT_ASSERT(m0.rows() == m1.rows());
-    PT_ASSERT(m0.cols() == m1.cols());
-
-    Matrix<T> res(m0.rows(), m0.cols());
-
-    for (size_t r = 0; r < res.rows(); r++)
-    {
-        for (size_t c = 0; c < res.cols(); c++)
-        {
-            res(r, c) = m0(r, c) / m1(r, c);
-        }
-    }
-    return res;
-}
-
-template <typename T> Matrix<T> operator/(const Matrix<T>& m, const T f)
-{
-    Matrix<T> res(m.rows(), m.cols());
-
-    for (size_t r = 0; r < res.rows(); r++)
-    {
-        for (size_t c = 0; c < res.cols(); c++)
-        {
-            res(r, c) = m(r, c) / f;
-        }
-    }
-    return res;
-}
-
-template <typename T> Matrix<T> operator/(const T f, const Matrix<T>& m)
-{
-    Matrix<T> res(m.rows(), m.cols());
-
-    for (size_t r = 0; r < res.rows(); r++)
-    {
-        for (size_t c = 0; c < res.cols(); c++)
-        {
-            res(r, c) = f / m(r, c);
-        }
-    }
-    return res;
-}
-
-template <typename T> Matrix<T> operator-(const Matrix<T>& m, const T f)
-{
-    Matrix<T> res(m.rows(), m.cols());
-
-    for (size_t r = 0; r < res.rows(); r++)
-    {
-        for (size_t c = 0; c < res.cols(); c++)
-        {
-            res(r, c) = m(r, c) - f;
-        }
-    }
-    return res;
-}
-
-template <typename T> Matrix<T> operator-(const T f, const Matrix<T>& m)
-{
-    Matrix<T> res(m.rows(), m.cols());
-
-    for (size_t r = 0; r < res.rows(); r++)
-    {
-        for (size_t c = 0; c < res.cols(); c++)
-        {
-            res(r, c) = f - m(r, c);
-        }
-    }
-    return res;
-}
-
-template <typename T> Matrix<T> operator+(const Matrix<T>& m, const T f)
-{
-    Matrix<T> res(m.rows(), m.cols());
-
-    for (size_t r = 0; r < res.rows(); r++)
-    {
-        for (size_t c = 0; c < res.cols(); c++)
-        {
-            res(r, c) = m(r, c) + f;
-        }
-    }
-    return res;
-}
-
-template <typename T> Matrix<T> operator+(const T f, const Matrix<T>& m)
-{
-    Matrix<T> res(m.rows(), m.cols());
-
-    for (size_t r = 0; r < res.rows(); r++)
-    {
-        for (size_t c = 0; c < res.cols(); c++)
-        {
-            res(r, c) = m(r, c) + f;
-        }
-    }
-    return res;
-}
-
-template <typename T> Matrix<T> operator-(const Matrix<T>& m)
-{
-    Matrix<T> res(m.rows(), m.cols());
-
-    for (size_t r = 0; r < res.rows(); r++)
-    {
-        for (size_t c = 0; c < res.cols(); c++)
-        {
-            res(r, c) = -m(r, c);
-        }
-    }
+    multiplyMatrices(m0.getDataPointer(),
+                     m1.getDataPointer(),
+                     res.getDataPointer(),
+                     m0.rows(),
+                     m0.cols(),
+                     m1.cols());
     return res;
 }
 
@@ -784,15 +667,8 @@ template <typename T> Vector<T> operator*(const Matrix<T>& m, const Vector<T>& v
     assert(m.cols() == v.size());
     Vector<T> res(m.rows());
 
-    for (size_t r = 0; r < m.rows(); r++)
-    {
-        T p = 0.0f;
-        for (size_t c = 0; c < m.cols(); c++)
-        {
-            p = p + m(r, c) * v(c);
-        }
-        res(r) = p;
-    }
+    multiplyMatrixVector(
+        m.getDataPointer(), v.getDataPointer(), res.getDataPointer(), m.rows(), m.cols());
     return res;
 }
 
@@ -801,15 +677,8 @@ template <typename T> Vector<T> operator*(const Vector<T>& v, const Matrix<T>& m
     assert(m.rows() == v.size());
     Vector<T> res(m.cols());
 
-    for (size_t c = 0; c < m.cols(); c++)
-    {
-        T p = 0.0f;
-        for (size_t r = 0; r < m.rows(); r++)
-        {
-            p = p + m(r, c) * v(r);
-        }
-        res(c) = p;
-    }
+    multiplyVectorMatrix(
+        v.getDataPointer(), m.getDataPointer(), res.getDataPointer(), m.rows(), m.cols());
     return res;
 }
 
@@ -848,7 +717,8 @@ template <typename T> void Matrix<T>::removeRowAtIndex(const size_t row_idx)
 
     T* temp_data;
 
-    DATA_ALLOCATION(temp_data, (num_rows_ - 1) * num_cols_, T, "Matrix");
+    temp_data = internal::allocateElements<T>(
+        memory_resource_, (num_rows_ - 1) * num_cols_, "Matrix");
 
     size_t current_row_idx = 0;
 
@@ -864,7 +734,7 @@ template <typename T> void Matrix<T>::removeRowAtIndex(const size_t row_idx)
         }
     }
 
-    delete[] data_;
+    internal::deallocateElements(memory_resource_, data_, num_rows_ * num_cols_);
     data_ = temp_data;
     num_rows_ = num_rows_ - 1;
 }
@@ -885,7 +755,8 @@ template <typename T> void Matrix<T>::removeRowsAtIndices(const IndexSpan& idx_s
 
     PT_ASSERT((num_rows_ - num_rows_to_remove) > 0) << "Tried to remove all elements!";
 
-    DATA_ALLOCATION(temp_data, (num_rows_ - num_rows_to_remove) * num_cols_, T, "Matrix");
+    temp_data = internal::allocateElements<T>(
+        memory_resource_, (num_rows_ - num_rows_to_remove) * num_cols_, "Matrix");
 
     size_t current_row_idx = 0;
 
@@ -901,7 +772,7 @@ template <typename T> void Matrix<T>::removeRowsAtIndices(const IndexSpan& idx_s
         }
     }
 
-    delete[] data_;
+    internal::deallocateElements(memory_resource_, data_, num_rows_ * num_cols_);
     data_ = temp_data;
     num_rows_ = num_rows_ - num_rows_to_remove;
 }
@@ -913,7 +784,8 @@ template <typename T> void Matrix<T>::removeColAtIndex(const size_t col_idx)
 
     T* temp_data;
 
-    DATA_ALLOCATION(temp_data, num_rows_ * (num_cols_ - 1), T, "Matrix");
+    temp_data = internal::allocateElements<T>(
+        memory_resource_, num_rows_ * (num_cols_ - 1), "Matrix");
 
     size_t current_col_idx = 0;
 
@@ -929,7 +801,7 @@ template <typename T> void Matrix<T>::removeColAtIndex(const size_t col_idx)
         }
     }
 
-    delete[] data_;
+    internal::deallocateElements(memory_resource_, data_, num_rows_ * num_cols_);
     data_ = temp_data;
     num_cols_ = num_cols_ - 1;
 }
@@ -950,7 +822,8 @@ template <typename T> void Matrix<T>::removeColsAtIndices(const IndexSpan& idx_s
 
     PT_ASSERT((num_cols_ - num_cols_to_remove) > 0) << "Tried to remove all elements!";
 
-    DATA_ALLOCATION(temp_data, num_rows_ * (num_cols_ - num_cols_to_remove), T, "Matrix");
+    temp_data = internal::allocateElements<T>(
+        memory_resource_, num_rows_ * (num_cols_ - num_cols_to_remove), "Matrix");
 
     size_t current_col_idx = 0;
 
@@ -967,7 +840,7 @@ template <typename T> void Matrix<T>::removeColsAtIndices(const IndexSpan& idx_s
         }
     }
 
-    delete[] data_;
+    internal::deallocateElements(memory_resource_, data_, num_rows_ * num_cols_);
     data_ = temp_data;
     num_cols_ = num_cols_ - num_cols_to_remove;
 }
@@ -1144,47 +1017,13 @@ template <typename T> Vector<T> Matrix<T>::toVector() const
 template <typename T> T Matrix<T>::max() const
 {
     ASSERT_MAT_VALID_INTERNAL();
-
-    T max_val = data_[0];
-    for (size_t c = 1; c < num_cols_; c++)
-    {
-        max_val = std::max(max_val, data_[c]);
-    }
-
-    for (size_t r = 1; r < num_rows_; r++)
-    {
-        T max_val_internal = data_[r * num_cols_];
-        for (size_t c = 1; c < num_cols_; c++)
-        {
-            max_val_internal = std::max(max_val_internal, data_[r * num_cols_ + c]);
-        }
-        max_val = std::max(max_val, max_val_internal);
-    }
-
-    return max_val;
+    return internal::maxOfArray(data_, num_rows_ * num_cols_);
 }
 
 template <typename T> T Matrix<T>::min() const
 {
     ASSERT_MAT_VALID_INTERNAL();
-
-    T min_val = data_[0];
-    for (size_t c = 1; c < num_cols_; c++)
-    {
-        min_val = std::min(min_val, data_[c]);
-    }
-
-    for (size_t r = 1; r < num_rows_; r++)
-    {
-        T min_val_internal = data_[r * num_cols_];
-        for (size_t c = 1; c < num_cols_; c++)
-        {
-            min_val_internal = std::min(min_val_internal, data_[r * num_cols_ + c]);
-        }
-        min_val = std::min(min_val, min_val_internal);
-    }
-
-    return min_val;
+    return internal::minOfArray(data_, num_rows_ * num_cols_);
 }
 
 template <typename T> Matrix<T> Matrix<T>::minAlongCols() const
@@ -1194,18 +1033,9 @@ template <typename T> Matrix<T> Matrix<T>::minAlongCols() const
     ASSERT_MAT_VALID_INTERNAL();
     Matrix<T> mres(1, num_cols_);
 
-    for (size_t c = 0; c < num_cols_; c++)
-    {
-        mres(0, c) = data_[c];
-    }
-
-    for (size_t c = 0; c < num_cols_; c++)
-    {
-        for (size_t r = 1; r < num_rows_; r++)
-        {
-            mres(0, c) = std::min(mres(0, c), data_[r * num_cols_ + c]);
-        }
-    }
+    internal::reduceAlongCols(data_, num_rows_, num_cols_, mres.data_, [](const T a, const T b) {
+        return std::min(a, b);
+    });
 
     return mres;
 }
@@ -1217,18 +1047,9 @@ template <typename T> Matrix<T> Matrix<T>::minAlongRows() const
     ASSERT_MAT_VALID_INTERNAL();
     Matrix<T> mres(num_rows_, 1);
 
-    for (size_t r = 0; r < num_rows_; r++)
-    {
-        mres(r, 0) = data_[r * num_cols_];
-    }
-
-    for (size_t r = 0; r < num_rows_; r++)
-    {
-        for (size_t c = 1; c < num_cols_; c++)
-        {
-            mres(r, 0) = std::min(mres(r, 0), data_[r * num_cols_ + c]);
-        }
-    }
+    internal::reduceAlongRows(data_, num_rows_, num_cols_, mres.data_, [](const T a, const T b) {
+        return std::min(a, b);
+    });
 
     return mres;
 }
@@ -1240,18 +1061,9 @@ template <typename T> Matrix<T> Matrix<T>::maxAlongCols() const
     ASSERT_MAT_VALID_INTERNAL();
     Matrix<T> mres(1, num_cols_);
 
-    for (size_t c = 0; c < num_cols_; c++)
-    {
-        mres(0, c) = data_[c];
-    }
-
-    for (size_t c = 0; c < num_cols_; c++)
-    {
-        for (size_t r = 1; r < num_rows_; r++)
-        {
-            mres(0, c) = std::max(mres(0, c), data_[r * num_cols_ + c]);
-        }
-    }
+    internal::reduceAlongCols(data_, num_rows_, num_cols_, mres.data_, [](const T a, const T b) {
+        return std::max(a, b);
+    });
 
     return mres;
 }
@@ -1259,66 +1071,35 @@ template <typename T> Matrix<T> Matrix<T>::maxAlongCols() const
 template <typename T> Matrix<T> Matrix<T>::maxAlongRows() const
 {
     // Creates a vector with same number of elements as "num_rows_",
-    // and each element in the vector is the min value of its corresponding row
+    // and each element in the vector is the max value of its corresponding row
     ASSERT_MAT_VALID_INTERNAL();
     Matrix<T> mres(num_rows_, 1);
 
-    for (size_t r = 0; r < num_rows_; r++)
-    {
-        mres(r, 0) = data_[r * num_cols_];
-    }
-
-    for (size_t r = 0; r < num_rows_; r++)
-    {
-        for (size_t c = 1; c < num_cols_; c++)
-        {
-            mres(r, 0) = std::max(mres(r, 0), data_[r * num_cols_ + c]);
-        }
-    }
+    internal::reduceAlongRows(data_, num_rows_, num_cols_, mres.data_, [](const T a, const T b) {
+        return std::max(a, b);
+    });
 
     return mres;
 }
 
 template <typename T> T Matrix<T>::sum() const
 {
-    T s = 0.0;
-    for (size_t r = 0; r < num_rows_; r++)
-    {
-        for (size_t c = 0; c < num_cols_; c++)
-        {
-            s = s + data_[r * num_cols_ + c];
-        }
-    }
-    return s;
+    return internal::sumOfArray(data_, num_rows_ * num_cols_);
 }
 
 template <typename T> Matrix<T> Matrix<T>::sumAlongRows() const
 {
     Matrix<T> mres(num_rows_, 1);
-    for (size_t r = 0; r < num_rows_; r++)
-    {
-        T s = 0.0;
-        for (size_t c = 0; c < num_cols_; c++)
-        {
-            s = s + data_[r * num_cols_ + c];
-        }
-        mres(r, 0) = s;
-    }
+    internal::reduceAlongRows(
+        data_, num_rows_, num_cols_, mres.data_, [](const T a, const T b) { return a + b; });
     return mres;
 }
 
 template <typename T> Matrix<T> Matrix<T>::sumAlongCols() const
 {
     Matrix<T> mres(1, num_cols_);
-    for (size_t c = 0; c < num_cols_; c++)
-    {
-        T s = 0.0;
-        for (size_t r = 0; r < num_rows_; r++)
-        {
-            s = s + data_[r * num_cols_ + c];
-        }
-        mres(0, c) = s;
-    }
+    internal::reduceAlongCols(
+        data_, num_rows_, num_cols_, mres.data_, [](const T a, const T b) { return a + b; });
     return mres;
 }
 
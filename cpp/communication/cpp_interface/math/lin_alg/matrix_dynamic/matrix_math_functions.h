@@ -2,12 +2,15 @@
 #ifndef PLOT_TOOL_MATRIX_MATH_FUNCTIONS_H_
 #define PLOT_TOOL_MATRIX_MATH_FUNCTIONS_H_
 
+#include <algorithm>
 #include <cmath>
 #include <cstdarg>
 #include <tuple>
 
 #include "logging.h"
 #include "math/math_core.h"
+#include "math/misc/array_reductions.h"
+#include "math/misc/thread_pool.h"
 
 namespace plot_tool
 {
@@ -21,34 +24,31 @@ std::tuple<Matrix<T>, Matrix<T>> meshGrid(
     const Vector<T> x_vec = linspaceFromPointsAndCount(x0, x1, xn);
     const Vector<T> y_vec = linspaceFromPointsAndCount(y0, y1, yn);
 
-    Matrix<T> x_mat(yn, xn), y_mat(yn, xn);
-    for (size_t r = 0; r < yn; r++)
-    {
-        for (size_t c = 0; c < xn; c++)
-        {
-            x_mat(r, c) = x_vec(c);
-            y_mat(r, c) = y_vec(r);
-        }
-    }
-
-    return std::tuple<Matrix<T>, Matrix<T>>(std::move(x_mat), std::move(y_mat));
+    return meshgrid(x_vec, y_vec);
 }
 
 template <typename T>
 std::tuple<Matrix<T>, Matrix<T>> meshgrid(const Vector<T>& x_vec, const Vector<T>& y_vec)
 {
-    Matrix<T> x_mat(y_vec.size(), x_vec.size()), y_mat(y_vec.size(), x_vec.size());
+    const size_t num_rows = y_vec.size();
+    const size_t num_cols = x_vec.size();
+    Matrix<T> x_mat(num_rows, num_cols), y_mat(num_rows, num_cols);
 
-    for (size_t r = 0; r < y_vec.size(); r++)
-    {
-        for (size_t c = 0; c < x_vec.size(); c++)
-        {
-            x_mat(r, c) = x_vec(c);
-            y_mat(r, c) = y_vec(r);
-        }
-    }
+    const T* const x_data = x_vec.getDataPointer();
+    const T* const y_data = y_vec.getDataPointer();
+    T* const x_mat_data = x_mat.getDataPointer();
+    T* const y_mat_data = y_mat.getDataPointer();
 
-    return std::tuple<Matrix<T>, Matrix<T>>(x_mat, y_mat);
+    internal::parallelFor(
+        num_rows, 1, 2 * num_rows * num_cols, [&](const size_t begin, const size_t end) {
+            for (size_t r = begin; r < end; r++)
+            {
+                std::copy(x_data, x_data + num_cols, x_mat_data + r * num_cols);
+                std::fill(y_mat_data + r * num_cols, y_mat_data + (r + 1) * num_cols, y_data[r]);
+            }
+        });
+
+    return std::tuple<Matrix<T>, Matrix<T>>(std::move(x_mat), std::move(y_mat));
 }
 
 template <typename T>
@@ -139,229 +139,56 @@ Matrix<T> concatenateVertically(const std::initializer_list<Matrix<T>>& init_lis
     return mres;
 }
 
-template <typename T> Matrix<T> log10(const Matrix<T>& m_in)
-{
-    assert((m_in.rows() > 0) && (m_in.cols() > 0) && (m_in.isAllocated()));
-    Matrix<T> m(m_in.rows(), m_in.cols());
-
-    for (size_t r = 0; r < m_in.rows(); r++)
-    {
-        for (size_t c = 0; c < m_in.cols(); c++)
-        {
-            m(r, c) = std::log10(m_in(r, c));
-        }
-    }
-
-    return m;
-}
-
-template <typename T> Matrix<T> pow(const Matrix<T>& m_in, const T e)
-{
-    assert((m_in.rows() > 0) && (m_in.cols() > 0) && (m_in.isAllocated()));
-    Matrix<T> m(m_in.rows(), m_in.cols());
-
-    for (size_t r = 0; r < m_in.rows(); r++)
-    {
-        for (size_t c = 0; c < m_in.cols(); c++)
-        {
-            m(r, c) = std::pow(m_in(r, c), e);
-        }
-    }
-
-    return m;
-}
-
-template <typename T> Matrix<T> log(const Matrix<T>& m_in)
-{
-    assert((m_in.rows() > 0) && (m_in.cols() > 0) && (m_in.isAllocated()));
-    Matrix<T> m(m_in.rows(), m_in.cols());
-
-    for (size_t r = 0; r < m_in.rows(); r++)
-    {
-        for (size_t c = 0; c < m_in.cols(); c++)
-        {
-            m(r, c) = std::log(m_in(r, c));
-        }
-    }
-
-    return m;
-}
-
-template <typename T> Matrix<T> exp(const Matrix<T>& m_in)
-{
-    assert((m_in.rows() > 0) && (m_in.cols() > 0) && (m_in.isAllocated()));
-    Matrix<T> m(m_in.rows(), m_in.cols());
-
-    for (size_t r = 0; r < m_in.rows(); r++)
-    {
-        for (size_t c = 0; c < m_in.cols(); c++)
-        {
-            m(r, c) = std::exp(m_in(r, c));
-        }
-    }
-
-    return m;
-}
-
-template <typename T> Matrix<T> cos(const Matrix<T>& m_in)
-{
-    assert((m_in.rows() > 0) && (m_in.cols() > 0) && (m_in.isAllocated()));
-    Matrix<T> m(m_in.rows(), m_in.cols());
-
-    for (size_t r = 0; r < m_in.rows(); r++)
-    {
-        for (size_t c = 0; c < m_in.cols(); c++)
-        {
-            m(r, c) = std::cos(m_in(r, c));
-        }
-    }
-
-    return m;
-}
-
-template <typename T> Matrix<T> sin(const Matrix<T>& m_in)
-{
-    assert((m_in.rows() > 0) && (m_in.cols() > 0) && (m_in.isAllocated()));
-    Matrix<T> m(m_in.rows(), m_in.cols());
-
-    for (size_t r = 0; r < m_in.rows(); r++)
-    {
-        for (size_t c = 0; c < m_in.cols(); c++)
-        {
-            m(r, c) = std::sin(m_in(r, c));
-        }
-    }
-
-    return m;
-}
-
-template <typename T> Matrix<T> sqrt(const Matrix<T>& m_in)
-{
-    assert((m_in.rows() > 0) && (m_in.cols() > 0) && (m_in.isAllocated()));
-    Matrix<T> m(m_in.rows(), m_in.cols());
-
-    for (size_t r = 0; r < m_in.rows(); r++)
-    {
-        for (size_t c = 0; c < m_in.cols(); c++)
-        {
-            m(r, c) = std::sqrt(m_in(r, c));
-        }
-    }
-
-    return m;
-}
-
 template <typename T> T max(const Matrix<T>& m_in)
 {
     assert((m_in.rows() > 0) && (m_in.cols() > 0) && (m_in.isAllocated()));
-    T max_val = m_in(0, 0);
-
-    for (size_t r = 0; r < m_in.rows(); r++)
-    {
-        for (size_t c = 0; c < m_in.cols(); c++)
-        {
-            max_val = std::max(max_val, m_in(r, c));
-        }
-    }
-
-    return max_val;
+    return internal::maxOfArray(m_in.getDataPointer(), m_in.rows() * m_in.cols());
 }
 
 template <typename T> T min(const Matrix<T>& m_in)
 {
     assert((m_in.rows() > 0) && (m_in.cols() > 0) && (m_in.isAllocated()));
-    T min_val = m_in(0, 0);
-
-    for (size_t r = 0; r < m_in.rows(); r++)
-    {
-        for (size_t c = 0; c < m_in.cols(); c++)
-        {
-            min_val = std::min(min_val, m_in(r, c));
-        }
-    }
-
-    return min_val;
+    return internal::minOfArray(m_in.getDataPointer(), m_in.rows() * m_in.cols());
 }
 
 template <typename T> T maxAbs(const Matrix<T>& m_in)
 {
     assert((m_in.rows() > 0) && (m_in.cols() > 0) && (m_in.isAllocated()));
-    T max_val = m_in(0, 0);
-
-    for (size_t r = 0; r < m_in.rows(); r++)
-    {
-        for (size_t c = 0; c < m_in.cols(); c++)
-        {
-            max_val = std::max(max_val, std::abs(m_in(r, c)));
-        }
-    }
-
-    return max_val;
+    return internal::maxAbsOfArray(m_in.getDataPointer(), m_in.rows() * m_in.cols());
 }
 
 template <typename T> T minAbs(const Matrix<T>& m_in)
 {
     assert((m_in.rows() > 0) && (m_in.cols() > 0) && (m_in.isAllocated()));
-    T min_val = m_in(0, 0);
-
-    for (size_t r = 0; r < m_in.rows(); r++)
-    {
-        for (size_t c = 0; c < m_in.cols(); c++)
-        {
-            min_val = std::min(min_val, std::fabs(m_in(r, c)));
-        }
-    }
-
-    return min_val;
-}
-
-template <typename T> Matrix<T> abs(const Matrix<T>& m_in)
-{
-    assert((m_in.rows() > 0) && (m_in.cols() > 0) && (m_in.isAllocated()));
-    Matrix<T> m(m_in.rows(), m_in.cols());
-
-    for (size_t r = 0; r < m_in.rows(); r++)
-    {
-        for (size_t c = 0; c < m_in.cols(); c++)
-        {
-            m(r, c) = std::fabs(m_in(r, c));
-        }
-    }
-
-    return m;
+    return internal::minAbsOfArray(m_in.getDataPointer(), m_in.rows() * m_in.cols());
 }
 
 template <typename T>
-Matrix<T> linspaceFromPointsAndCountColMat(const T x0, const T x1, const size_t num_values)
+Matrix<T> linspaceFromPointIncAndCountColMat(const T x0, const T dx, const size_t num_values)
 {
     assert(num_values > 0);
     Matrix<T> m(num_values, 1);
+    T* const data = m.getDataPointer();
 
-    const T dx = (x1 - x0) / static_cast<T>(num_values - 1);
-    m(0, 0) = x0;
-
-    for (size_t r = 1; r < num_values; r++)
-    {
-        m(r, 0) = m(r - 1, 0) + dx;
-    }
+    data[0] = x0;
+    internal::parallelFor(
+        num_values, 1, num_values, [data, x0, dx](const size_t begin, const size_t end) {
+            for (size_t r = std::max<size_t>(begin, 1); r < end; r++)
+            {
+                data[r] = x0 + static_cast<T>(r) * dx;
+            }
+        });
 
     return m;
 }
 
 template <typename T>
-Matrix<T> linspaceFromPointIncAndCountColMat(const T x0, const T dx, const size_t num_values)
+Matrix<T> linspaceFromPointsAndCountColMat(const T x0, const T x1, const size_t num_values)
 {
     assert(num_values > 0);
-    Matrix<T> m(num_values, 1);
-
-    m(0, 0) = x0;
-
-    for (size_t r = 1; r < num_values; r++)
-    {
-        m(r, 0) = m(r - 1, 0) + dx;
-    }
+    const T dx = (x1 - x0) / static_cast<T>(num_values - 1);
 
-    return m;
+    return linspaceFromPointIncAndCountColMat(x0, dx, num_values);
 }
 
 template <typename T> Matrix<T> linspaceFromPointsAndIncColMat(const T x0, const T x1, const T dx)
@@ -0,0 +1,537 @@
+#ifndef PLOT_TOOL_MATRIX_MULTIPLICATION_H_
+#define PLOT_TOOL_MATRIX_MULTIPLICATION_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "math/misc/simd.h"
+#include "math/misc/thread_pool.h"
+
+// Kernels for the Matrix * Matrix, Matrix * Vector and Vector * Matrix products, on row major
+// data. Matrix products are blocked and packed in the usual GotoBLAS way: B is packed into
+// kc x nc panels and A into mc x kc blocks, both laid out so that the micro kernel reads them
+// contiguously, and the micro kernel keeps an mr x nr tile of C in registers for the whole kc
+// loop. The AVX2/FMA kernels for float and double are used when the client is compiled with
+// AVX2 and FMA enabled, e.g. -mavx2 -mfma or -march=native, and portable kernels otherwise.
+// Large products are split into bands that run on the shared thread pool.
+
+namespace plot_tool
+{
+namespace internal
+{
+constexpr size_t matrix_multiplication_kc = 256;
+constexpr size_t matrix_multiplication_mc = 96;
+constexpr size_t matrix_multiplication_nc = 1024;
+
+// Multiplications with fewer multiply-adds than this per thread aren't worth a thread
+constexpr size_t matrix_multiplication_min_work_per_thread = 1 << 21;
+
+// Below this number of multiply-adds, packing costs more than it saves
+constexpr size_t matrix_multiplication_min_blocked_work = 1 << 15;
+
+// Adds the product of an mr x kc packed block of A and a kc x nr packed panel of B to the
+// mr x nr tile c, with row stride ldc
+template <typename T> struct MatrixMultiplicationMicroKernel
+{
+    enum
+    {
+        mr = 4,
+        nr = 4
+    };
+
+    static void run(const size_t kc, const T* a, const T* b, T* const c, const size_t ldc)
+    {
+        T acc[mr][nr];
+        for (size_t i = 0; i < mr; i++)
+        {
+            for (size_t j = 0; j < nr; j++)
+            {
+                acc[i][j] = T(0);
+            }
+        }
+
+        for (size_t k = 0; k < kc; k++)
+        {
+            for (size_t i = 0; i < mr; i++)
+            {
+                const T a_ik = a[i];
+                for (size_t j = 0; j < nr; j++)
+                {
+                    acc[i][j] = acc[i][j] + a_ik * b[j];
+                }
+            }
+            a += mr;
+            b += nr;
+        }
+
+        for (size_t i = 0; i < mr; i++)
+        {
+            for (size_t j = 0; j < nr; j++)
+            {
+                c[i * ldc + j] = c[i * ldc + j] + acc[i][j];
+            }
+        }
+    }
+};
+
+#ifdef PLOT_TOOL_SIMD_AVX2
+
+template <> struct MatrixMultiplicationMicroKernel<double>
+{
+    enum
+    {
+        mr = 6,
+        nr = 8
+    };
+
+    static void addToRow(double* const c_row, const __m256d c0, const __m256d c1)
+    {
+        _mm256_storeu_pd(c_row, _mm256_add_pd(_mm256_loadu_pd(c_row), c0));
+        _mm256_storeu_pd(c_row + 4, _mm256_add_pd(_mm256_loadu_pd(c_row + 4), c1));
+    }
+
+    static void run(
+        const size_t kc, const double* a, const double* b, double* const c, const size_t ldc)
+    {
+        // Written out, so that the twelve accumulators stay in registers also at -O2
+        __m256d c00 = _mm256_setzero_pd(), c01 = _mm256_setzero_pd();
+        __m256d c10 = _mm256_setzero_pd(), c11 = _mm256_setzero_pd();
+        __m256d c20 = _mm256_setzero_pd(), c21 = _mm256_setzero_pd();
+        __m256d c30 = _mm256_setzero_pd(), c31 = _mm256_setzero_pd();
+        __m256d c40 = _mm256_setzero_pd(), c41 = _mm256_setzero_pd();
+        __m256d c50 = _mm256_setzero_pd(), c51 = _mm256_setzero_pd();
+
+        for (size_t k = 0; k < kc; k++)
+        {
+            const __m256d b0 = _mm256_loadu_pd(b);
+            const __m256d b1 = _mm256_loadu_pd(b + 4);
+            __m256d a_k;
+
+            a_k = _mm256_broadcast_sd(a);
+            c00 = _mm256_fmadd_pd(a_k, b0, c00);
+            c01 = _mm256_fmadd_pd(a_k, b1, c01);
+
+            a_k = _mm256_broadcast_sd(a + 1);
+            c10 = _mm256_fmadd_pd(a_k, b0, c10);
+            c11 = _mm256_fmadd_pd(a_k, b1, c11);
+
+            a_k = _mm256_broadcast_sd(a + 2);
+            c20 = _mm256_fmadd_pd(a_k, b0, c20);
+            c21 = _mm256_fmadd_pd(a_k, b1, c21);
+
+            a_k = _mm256_broadcast_sd(a + 3);
+            c30 = _mm256_fmadd_pd(a_k, b0, c30);
+            c31 = _mm256_fmadd_pd(a_k, b1, c31);
+
+            a_k = _mm256_broadcast_sd(a + 4);
+            c40 = _mm256_fmadd_pd(a_k, b0, c40);
+            c41 = _mm256_fmadd_pd(a_k, b1, c41);
+
+            a_k = _mm256_broadcast_sd(a + 5);
+            c50 = _mm256_fmadd_pd(a_k, b0, c50);
+            c51 = _mm256_fmadd_pd(a_k, b1, c51);
+
+            a += mr;
+            b += nr;
+        }
+
+        addToRow(c, c00, c01);
+        addToRow(c + 1 * ldc, c10, c11);
+        addToRow(c + 2 * ldc, c20, c21);
+        addToRow(c + 3 * ldc, c30, c31);
+        addToRow(c + 4 * ldc, c40, c41);
+        addToRow(c + 5 * ldc, c50, c51);
+    }
+};
+
+template <> struct MatrixMultiplicationMicroKernel<float>
+{
+    enum
+    {
+        mr = 6,
+        nr = 16
+    };
+
+    static void addToRow(float* const c_row, const __m256 c0, const __m256 c1)
+    {
+        _mm256_storeu_ps(c_row, _mm256_add_ps(_mm256_loadu_ps(c_row), c0));
+        _mm256_storeu_ps(c_row + 8, _mm256_add_ps(_mm256_loadu_ps(c_row + 8), c1));
+    }
+
+    static void run(
+        const size_t kc, const float* a, const float* b, float* const c, const size_t ldc)
+    {
+        // Written out, so that the twelve accumulators stay in registers also at -O2
+        __m256 c00 = _mm256_setzero_ps(), c01 = _mm256_setzero_ps();
+        __m256 c10 = _mm256_setzero_ps(), c11 = _mm256_setzero_ps();
+        __m256 c20 = _mm256_setzero_ps(), c21 = _mm256_setzero_ps();
+        __m256 c30 = _mm256_setzero_ps(), c31 = _mm256_setzero_ps();
+        __m256 c40 = _mm256_setzero_ps(), c41 = _mm256_setzero_ps();
+        __m256 c50 = _mm256_setzero_ps(), c51 = _mm256_setzero_ps();
+
+        for (size_t k = 0; k < kc; k++)
+        {
+            const __m256 b0 = _mm256_loadu_ps(b);
+            const __m256 b1 = _mm256_loadu_ps(b + 8);
+            __m256 a_k;
+
+            a_k = _mm256_broadcast_ss(a);
+            c00 = _mm256_fmadd_ps(a_k, b0, c00);
+            c01 = _mm256_fmadd_ps(a_k, b1, c01);
+
+            a_k = _mm256_broadcast_ss(a + 1);
+            c10 = _mm256_fmadd_ps(a_k, b0, c10);
+            c11 = _mm256_fmadd_ps(a_k, b1, c11);
+
+            a_k = _mm256_broadcast_ss(a + 2);
+            c20 = _mm256_fmadd_ps(a_k, b0, c20);
+            c21 = _mm256_fmadd_ps(a_k, b1, c21);
+
+            a_k = _mm256_broadcast_ss(a + 3);
+            c30 = _mm256_fmadd_ps(a_k, b0, c30);
+            c31 = _mm256_fmadd_ps(a_k, b1, c31);
+
+            a_k = _mm256_broadcast_ss(a + 4);
+            c40 = _mm256_fmadd_ps(a_k, b0, c40);
+            c41 = _mm256_fmadd_ps(a_k, b1, c41);
+
+            a_k = _mm256_broadcast_ss(a + 5);
+            c50 = _mm256_fmadd_ps(a_k, b0, c50);
+            c51 = _mm256_fmadd_ps(a_k, b1, c51);
+
+            a += mr;
+            b += nr;
+        }
+
+        addToRow(c, c00, c01);
+        addToRow(c + 1 * ldc, c10, c11);
+        addToRow(c + 2 * ldc, c20, c21);
+        addToRow(c + 3 * ldc, c30, c31);
+        addToRow(c + 4 * ldc, c40, c41);
+        addToRow(c + 5 * ldc, c50, c51);
+    }
+};
+
+#endif
+
+// Packs the kc x nc block b, with row stride ldb, into panels of nr columns, zero padded
+template <typename T, size_t nr>
+void packMatrixMultiplicationB(
+    const T* const b, const size_t ldb, const size_t kc, const size_t nc, T* b_packed)
+{
+    for (size_t j0 = 0; j0 < nc; j0 += nr)
+    {
+        const size_t num_cols = std::min(nr, nc - j0);
+        for (size_t k = 0; k < kc; k++)
+        {
+            const T* const b_row = b + k * ldb + j0;
+            for (size_t j = 0; j < num_cols; j++)
+            {
+                b_packed[j] = b_row[j];
+            }
+            for (size_t j = num_cols; j < nr; j++)
+            {
+                b_packed[j] = T(0);
+            }
+            b_packed += nr;
+        }
+    }
+}
+
+// Packs the mc x kc block a, with row stride lda, into blocks of mr rows, zero padded
+template <typename T, size_t mr>
+void packMatrixMultiplicationA(
+    const T* const a, const size_t lda, const size_t mc, const size_t kc, T* a_packed)
+{
+    for (size_t i0 = 0; i0 < mc; i0 += mr)
+    {
+        const size_t num_rows = std::min(mr, mc - i0);
+        for (size_t k = 0; k < kc; k++)
+        {
+            for (size_t i = 0; i < num_rows; i++)
+            {
+                a_packed[i] = a[(i0 + i) * lda + k];
+            }
+            for (size_t i = num_rows; i < mr; i++)
+            {
+                a_packed[i] = T(0);
+            }
+            a_packed += mr;
+        }
+    }
+}
+
+// c (m x n) += a (m x k) * b (k x n), single threaded
+template <typename T>
+void multiplyMatricesBlocked(const T* const a,
+                             const T* const b,
+                             T* const c,
+                             const size_t m,
+                             const size_t k,
+                             const size_t n)
+{
+    typedef MatrixMultiplicationMicroKernel<T> Kernel;
+    const size_t mr = Kernel::mr;
+    const size_t nr = Kernel::nr;
+    const size_t kc_max = std::min(matrix_multiplication_kc, k);
+    const size_t mc_max = std::min(matrix_multiplication_mc, ((m + mr - 1) / mr) * mr);
+    const size_t nc_max = std::min(matrix_multiplication_nc, ((n + nr - 1) / nr) * nr);
+
+    std::vector<T> a_packed(mc_max * kc_max);
+    std::vector<T> b_packed(kc_max * nc_max);
+
+    for (size_t jc = 0; jc < n; jc += nc_max)
+    {
+        const size_t nc = std::min(nc_max, n - jc);
+        for (size_t pc = 0; pc < k; pc += kc_max)
+        {
+            const size_t kc = std::min(kc_max, k - pc);
+            packMatrixMultiplicationB<T, nr>(b + pc * n + jc, n, kc, nc, b_packed.data());
+
+            for (size_t ic = 0; ic < m; ic += mc_max)
+            {
+                const size_t mc = std::min(mc_max, m - ic);
+                packMatrixMultiplicationA<T, mr>(a + ic * k + pc, k, mc, kc, a_packed.data());
+
+                for (size_t jr = 0; jr < nc; jr += nr)
+                {
+                    const T* const b_panel = b_packed.data() + jr * kc;
+                    for (size_t ir = 0; ir < mc; ir += mr)
+                    {
+                        const T* const a_block = a_packed.data() + ir * kc;
+                        T* const c_tile = c + (ic + ir) * n + jc + jr;
+
+                        if (((ir + mr) <= mc) && ((jr + nr) <= nc))
+                        {
+                            Kernel::run(kc, a_block, b_panel, c_tile, n);
+                            continue;
+                        }
+
+                        // Tile on the edge of c, computed in a temporary tile
+                        T edge_tile[mr * nr];
+                        std::fill(edge_tile, edge_tile + mr * nr, T(0));
+                        Kernel::run(kc, a_block, b_panel, edge_tile, nr);
+
+                        const size_t num_rows = std::min(mr, mc - ir);
+                        const size_t num_cols = std::min(nr, nc - jr);
+                        for (size_t i = 0; i < num_rows; i++)
+                        {
+                            for (size_t j = 0; j < num_cols; j++)
+                            {
+                                c_tile[i * n + j] = c_tile[i * n + j] + edge_tile[i * nr + j];
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+inline size_t matrixMultiplicationNumThreads(const size_t work, const size_t max_num_items)
+{
+    const size_t num_threads =
+        std::min(threadPool().numThreads(), work / matrix_multiplication_min_work_per_thread);
+    return std::max<size_t>(1, std::min(num_threads, max_num_items));
+}
+
+template <typename T> T dotProduct(const T* const a, const T* const b, const size_t n)
+{
+    // Independent partial sums, so that the additions don't wait for each other
+    T s0 = T(0), s1 = T(0), s2 = T(0), s3 = T(0);
+    size_t k = 0;
+    for (; (k + 4) <= n; k += 4)
+    {
+        s0 = s0 + a[k] * b[k];
+        s1 = s1 + a[k + 1] * b[k + 1];
+        s2 = s2 + a[k + 2] * b[k + 2];
+        s3 = s3 + a[k + 3] * b[k + 3];
+    }
+    for (; k < n; k++)
+    {
+        s0 = s0 + a[k] * b[k];
+    }
+    return (s0 + s1) + (s2 + s3);
+}
+
+// y += s * x
+template <typename T> void addScaled(const T s, const T* const x, T* const y, const size_t n)
+{
+    for (size_t k = 0; k < n; k++)
+    {
+        y[k] = y[k] + s * x[k];
+    }
+}
+
+#ifdef PLOT_TOOL_SIMD_AVX2
+
+template <> inline double dotProduct(const double* const a, const double* const b, const size_t n)
+{
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+    size_t k = 0;
+    for (; (k + 8) <= n; k += 8)
+    {
+        acc0 = _mm256_fmadd_pd(_mm256_loadu_pd(a + k), _mm256_loadu_pd(b + k), acc0);
+        acc1 = _mm256_fmadd_pd(_mm256_loadu_pd(a + k + 4), _mm256_loadu_pd(b + k + 4), acc1);
+    }
+
+    double partial_sums[4];
+    _mm256_storeu_pd(partial_sums, _mm256_add_pd(acc0, acc1));
+    double s = (partial_sums[0] + partial_sums[1]) + (partial_sums[2] + partial_sums[3]);
+    for (; k < n; k++)
+    {
+        s = s + a[k] * b[k];
+    }
+    return s;
+}
+
+template <> inline float dotProduct(const float* const a, const float* const b, const size_t n)
+{
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    size_t k = 0;
+    for (; (k + 16) <= n; k += 16)
+    {
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + k), _mm256_loadu_ps(b + k), acc0);
+        acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + k + 8), _mm256_loadu_ps(b + k + 8), acc1);
+    }
+
+    float partial_sums[8];
+    _mm256_storeu_ps(partial_sums, _mm256_add_ps(acc0, acc1));
+    float s = ((partial_sums[0] + partial_sums[1]) + (partial_sums[2] + partial_sums[3])) +
+              ((partial_sums[4] + partial_sums[5]) + (partial_sums[6] + partial_sums[7]));
+    for (; k < n; k++)
+    {
+        s = s + a[k] * b[k];
+    }
+    return s;
+}
+
+template <>
+inline void addScaled(const double s, const double* const x, double* const y, const size_t n)
+{
+    const __m256d s_vec = _mm256_set1_pd(s);
+    size_t k = 0;
+    for (; (k + 4) <= n; k += 4)
+    {
+        _mm256_storeu_pd(y + k,
+                         _mm256_fmadd_pd(s_vec, _mm256_loadu_pd(x + k), _mm256_loadu_pd(y + k)));
+    }
+    for (; k < n; k++)
+    {
+        y[k] = y[k] + s * x[k];
+    }
+}
+
+template <>
+inline void addScaled(const float s, const float* const x, float* const y, const size_t n)
+{
+    const __m256 s_vec = _mm256_set1_ps(s);
+    size_t k = 0;
+    for (; (k + 8) <= n; k += 8)
+    {
+        _mm256_storeu_ps(y + k,
+                         _mm256_fmadd_ps(s_vec, _mm256_loadu_ps(x + k), _mm256_loadu_ps(y + k)));
+    }
+    for (; k < n; k++)
+    {
+        y[k] = y[k] + s * x[k];
+    }
+}
+
+#endif
+}  // namespace internal
+
+// c (m x n) = a (m x k) * b (k x n), all row major
+template <typename T>
+void multiplyMatrices(const T* const a,
+                      const T* const b,
+                      T* const c,
+                      const size_t m,
+                      const size_t k,
+                      const size_t n)
+{
+    std::fill(c, c + m * n, T(0));
+
+    if ((m * k * n) < internal::matrix_multiplication_min_blocked_work)
+    {
+        for (size_t r = 0; r < m; r++)
+        {
+            for (size_t i = 0; i < k; i++)
+            {
+                internal::addScaled(a[r * k + i], b + i * n, c + r * n, n);
+            }
+        }
+        return;
+    }
+
+    const size_t mr = internal::MatrixMultiplicationMicroKernel<T>::mr;
+    const size_t num_threads = internal::matrixMultiplicationNumThreads(m * k * n, m / mr);
+    if (num_threads == 1)
+    {
+        internal::multiplyMatricesBlocked(a, b, c, m, k, n);
+        return;
+    }
+
+    // Each thread takes a band of rows of c, and packs all of b by itself
+    internal::threadPool().run(
+        m, mr, num_threads, [=](const size_t row_begin, const size_t row_end) {
+            internal::multiplyMatricesBlocked(
+                a + row_begin * k, b, c + row_begin * n, row_end - row_begin, k, n);
+        });
+}
+
+// y (m) = a (m x n) * x (n)
+template <typename T>
+void multiplyMatrixVector(
+    const T* const a, const T* const x, T* const y, const size_t m, const size_t n)
+{
+    const auto multiply_rows = [=](const size_t row_begin, const size_t row_end) {
+        for (size_t r = row_begin; r < row_end; r++)
+        {
+            y[r] = internal::dotProduct(a + r * n, x, n);
+        }
+    };
+
+    const size_t num_threads = internal::matrixMultiplicationNumThreads(m * n, m);
+    if (num_threads == 1)
+    {
+        multiply_rows(0, m);
+    }
+    else
+    {
+        internal::threadPool().run(m, 1, num_threads, multiply_rows);
+    }
+}
+
+// y (n) = x (m) * a (m x n), accumulated row by row, so that a is read contiguously
+template <typename T>
+void multiplyVectorMatrix(
+    const T* const x, const T* const a, T* const y, const size_t m, const size_t n)
+{
+    const auto multiply_cols = [=](const size_t col_begin, const size_t col_end) {
+        std::fill(y + col_begin, y + col_end, T(0));
+        for (size_t r = 0; r < m; r++)
+        {
+            internal::addScaled(x[r], a + r * n + col_begin, y + col_begin, col_end - col_begin);
+        }
+    };
+
+    // Column bands of whole cache lines, so that threads don't write to the same line
+    const size_t col_granularity = 64 / sizeof(T) > 0 ? 64 / sizeof(T) : 1;
+    const size_t num_threads =
+        internal::matrixMultiplicationNumThreads(m * n, n / col_granularity);
+    if (num_threads == 1)
+    {
+        multiply_cols(0, n);
+    }
+    else
+    {
+        internal::threadPool().run(n, col_granularity, num_threads, multiply_cols);
+    }
+}
+}  // namespace plot_tool
+
+#endif
@@ -1,80 +1,76 @@
 #ifndef PLOT_TOOL_MATRIX_FIXED_H_
 #define PLOT_TOOL_MATRIX_FIXED_H_
 
+#include <cmath>
 #include <initializer_list>
 #include <iostream>
+#include <type_traits>
+
+#include "math/math_core.h"
+#include "math/misc/simd.h"
 
 namespace plot_tool
 {
+// Matrix with the dimensions as template parameters only, stored row major on the stack.
+// Copies are trivial, and the loops over the elements have compile time bounds that the
+// compiler unrolls. Determinants and inverses of matrices up to 4 x 4 are computed in closed
+// form, and 3 x 3 and 4 x 4 products use SIMD when PLOT_TOOL_SIMD_AVX2 is defined.
 template <size_t R, size_t C, typename T> class MatrixFixed
 {
 private:
+    static_assert(R > 0, "Number of rows can't be 0!");
+    static_assert(C > 0, "Number of columns can't be 0!");
+
     T data_[R * C];
-    const size_t num_rows_;
-    const size_t num_cols_;
 
 public:
-    MatrixFixed();
-    MatrixFixed(const MatrixFixed<R, C, T>& mf);
-    MatrixFixed<R, C, T>(const std::initializer_list<std::initializer_list<T>>& il);
-    MatrixFixed<R, C, T>& operator=(const MatrixFixed<R, C, T>& m);
+    MatrixFixed() = default;
+    MatrixFixed(const std::initializer_list<std::initializer_list<T>>& il);
 
     void switchRows(const size_t r0, const size_t r1);
     void switchCols(const size_t c0, const size_t c1);
 
-    T* getDataPointer() const;
-    size_t rows() const;
-    size_t cols() const;
+    T* getDataPointer();
+    const T* getDataPointer() const;
 
-    T& operator()(const size_t r, const size_t c);
-    const T& operator()(const size_t r, const size_t c) const;
-};
-
-template <size_t R, size_t C, typename T>
-MatrixFixed<R, C, T>::MatrixFixed() : num_rows_(R), num_cols_(C)
-{
-    static_assert(R > 0, "Number of rows can't be 0!");
-    static_assert(C > 0, "Number of columns can't be 0!");
-}
+    static constexpr size_t rows()
+    {
+        return R;
+    }
 
-template <size_t R, size_t C, typename T> size_t MatrixFixed<R, C, T>::rows() const
-{
-    return num_rows_;
-}
-template <size_t R, size_t C, typename T> size_t MatrixFixed<R, C, T>::cols() const
-{
-    return num_cols_;
-}
+    static constexpr size_t cols()
+    {
+        return C;
+    }
 
-template <size_t R, size_t C, typename T>
-MatrixFixed<R, C, T>::MatrixFixed(const MatrixFixed<R, C, T>& mf) : num_rows_(R), num_cols_(C)
-{
-    for (size_t r = 0; r < mf.rows(); r++)
+    static constexpr size_t numElements()
     {
-        for (size_t c = 0; c < mf.cols(); c++)
-        {
-            data_[r * num_cols_ + c] = mf(r, c);
-        }
+        return R * C;
     }
-}
+
+    T& operator()(const size_t r, const size_t c);
+    const T& operator()(const size_t r, const size_t c) const;
+
+    MatrixFixed<C, R, T> transposed() const;
+};
 
 template <size_t R, size_t C, typename T>
 T& MatrixFixed<R, C, T>::operator()(const size_t r, const size_t c)
 {
-    PT_ASSERT(r < num_rows_) << "Tried to access element outside of num_rows_!";
-    PT_ASSERT(c < num_cols_) << "Tried to access element outside of num_cols_!";
-    return data_[r * num_cols_ + c];
+    PT_ASSERT(r < R) << "Tried to access element outside of the number of rows!";
+    PT_ASSERT(c < C) << "Tried to access element outside of the number of columns!";
+    return data_[r * C + c];
 }
 
 template <size_t R, size_t C, typename T>
 const T& MatrixFixed<R, C, T>::operator()(const size_t r, const size_t c) const
 {
-    PT_ASSERT(r < num_rows_) << "Tried to access element outside of num_rows_!";
-    PT_ASSERT(c < num_cols_) << "Tried to access element outside of num_cols_!";
-    return data_[r * num_cols_ + c];
+    PT_ASSERT(r < R) << "Tried to access element outside of the number of rows!";
+    PT_ASSERT(c < C) << "Tried to access element outside of the number of columns!";
+    return data_[r * C + c];
 }
 
-template <typename T> MatrixFixed<3, 3, T> rotationMatrixX(const T angle)
+template <typename T> MatrixFixed<3, 3, T> rotationMatrixXFixed(const T angle)
 {
     const T ca = std::cos(angle);
     const T sa = std::sin(angle);
@@ -95,7 +91,7 @@ template <typename T> MatrixFixed<3, 3, T> rotationMatrixX(const T angle)
     return rotation_matrix;
 }
 
-template <typename T> MatrixFixed<3, 3, T> rotationMatrixY(const T angle)
+template <typename T> MatrixFixed<3, 3, T> rotationMatrixYFixed(const T angle)
 {
     const T ca = std::cos(angle);
     const T sa = std::sin(angle);
@@ -116,7 +112,7 @@ template <typename T> MatrixFixed<3, 3, T> rotationMatrixY(const T angle)
     return rotation_matrix;
 }
 
-template <typename T> MatrixFixed<3, 3, T> rotationMatrixZ(const T angle)
+template <typename T> MatrixFixed<3, 3, T> rotationMatrixZFixed(const T angle)
 {
     const T ca = std::cos(angle);
     const T sa = std::sin(angle);
@@ -137,7 +133,7 @@ template <typename T> MatrixFixed<3, 3, T> rotationMatrixZ(const T angle)
     return rotation_matrix;
 }
 
-template <typename T> MatrixFixed<2, 2, T> rotationMatrix2D(const T angle)
+template <typename T> MatrixFixed<2, 2, T> rotationMatrix2DFixed(const T angle)
 {
     const T ca = std::cos(angle);
     const T sa = std::sin(angle);
@@ -152,25 +148,8 @@ template <typename T> MatrixFixed<2, 2, T> rotationMatrix2D(const T angle)
     return rotation_matrix;
 }
 
-template <size_t R, size_t C, typename T>
-MatrixFixed<R, C, T>& MatrixFixed<R, C, T>::operator=(const MatrixFixed<R, C, T>& m)
-{
-    if (this != &m)
-    {
-        for (size_t r = 0; r < m.rows(); r++)
-        {
-            for (size_t c = 0; c < m.cols(); c++)
-            {
-                data_[r * num_cols_ + c] = m(r, c);
-            }
-        }
-    }
-    return *this;
-}
-
 template <size_t R, size_t C, typename T>
 MatrixFixed<R, C, T>::MatrixFixed(const std::initializer_list<std::initializer_list<T>>& il)
-    : num_rows_(R), num_cols_(C)
 {
     PT_ASSERT(il.size() == R) << "Incorrect number of rows for templated matrix size!";
     PT_ASSERT(il.begin()[0].size() == C)
@@ -186,7 +165,7 @@ MatrixFixed<R, C, T>::MatrixFixed(const std::initializer_list<std::initializer_l
     {
         for (size_t c = 0; c < il.begin()[r].size(); c++)
         {
-            data_[r * num_cols_ + c] = il.begin()[r].begin()[c];
+            data_[r * C + c] = il.begin()[r].begin()[c];
         }
     }
 }
@@ -218,34 +197,55 @@ std::ostream& operator<<(std::ostream& os, const MatrixFixed<R, C, T>& m)
 template <size_t R, size_t C, typename T>
 void MatrixFixed<R, C, T>::switchRows(const size_t r0, const size_t r1)
 {
-    assert(r0 < num_rows_ && r1 < num_rows_);
+    assert(r0 < R && r1 < R);
 
-    for (size_t c = 0; c < num_cols_; c++)
+    for (size_t c = 0; c < C; c++)
     {
-        const T tmp_var = data_[num_cols_ * r0 + c];
-        data_[num_cols_ * r0 + c] = data_[num_cols_ * r1 + c];
-        data_[num_cols_ * r1 + c] = tmp_var;
+        const T tmp_var = data_[C * r0 + c];
+        data_[C * r0 + c] = data_[C * r1 + c];
+        data_[C * r1 + c] = tmp_var;
     }
 }
 
 template <size_t R, size_t C, typename T>
 void MatrixFixed<R, C, T>::switchCols(const size_t c0, const size_t c1)
 {
-    assert(c0 < num_cols_ && c1 < num_cols_);
+    assert(c0 < C && c1 < C);
 
-    for (size_t r = 0; r < num_rows_; r++)
+    for (size_t r = 0; r < R; r++)
     {
-        const T tmp_var = data_[num_cols_ * r + c0];
-        data_[num_cols_ * r + c0] = data_[num_cols_ * r + c1];
-        data_[num_cols_ * r + c1] = tmp_var;
+        const T tmp_var = data_[C * r + c0];
+        data_[C * r + c0] = data_[C * r + c1];
+        data_[C * r + c1] = tmp_var;
     }
 }
 
-template <size_t R, size_t C, typename T> T* MatrixFixed<R, C, T>::getDataPointer() const
+template <size_t R, size_t C, typename T> T* MatrixFixed<R, C, T>::getDataPointer()
+{
+    return data_;
+}
+
+template <size_t R, size_t C, typename T> const T* MatrixFixed<R, C, T>::getDataPointer() const
 {
     return data_;
 }
 
+template <size_t R, size_t C, typename T>
+MatrixFixed<C, R, T> MatrixFixed<R, C, T>::transposed() const
+{
+    MatrixFixed<C, R, T> mres;
+
+    for (size_t r = 0; r < R; r++)
+    {
+        for (size_t c = 0; c < C; c++)
+        {
+            mres(c, r) = data_[r * C + c];
+        }
+    }
+
+    return mres;
+}
+
 template <size_t R, size_t C0, size_t C1, typename T>
 MatrixFixed<R, C0 + C1, T> hCatFixed(const MatrixFixed<R, C0, T>& m0,
                                      const MatrixFixed<R, C1, T>& m1)
@@ -316,6 +316,362 @@ MatrixFixed<R0, C1, T> operator*(const MatrixFixed<R0, C0R1, T>& m0,
     return mres;
 }
 
+#ifdef PLOT_TOOL_SIMD_AVX2
+
+// Each row of the product is a combination of the rows of m1, so it's accumulated with one
+// broadcast and one fma per element of m0. Rows of 3 are loaded and stored with masks.
+inline MatrixFixed<4, 4, double> operator*(const MatrixFixed<4, 4, double>& m0,
+                                           const MatrixFixed<4, 4, double>& m1)
+{
+    MatrixFixed<4, 4, double> mres;
+    const double* const a = m0.getDataPointer();
+    const double* const b = m1.getDataPointer();
+
+    const __m256d b0 = _mm256_loadu_pd(b);
+    const __m256d b1 = _mm256_loadu_pd(b + 4);
+    const __m256d b2 = _mm256_loadu_pd(b + 8);
+    const __m256d b3 = _mm256_loadu_pd(b + 12);
+
+    for (size_t r = 0; r < 4; r++)
+    {
+        __m256d row = _mm256_mul_pd(_mm256_set1_pd(a[4 * r]), b0);
+        row = _mm256_fmadd_pd(_mm256_set1_pd(a[4 * r + 1]), b1, row);
+        row = _mm256_fmadd_pd(_mm256_set1_pd(a[4 * r + 2]), b2, row);
+        row = _mm256_fmadd_pd(_mm256_set1_pd(a[4 * r + 3]), b3, row);
+        _mm256_storeu_pd(mres.getDataPointer() + 4 * r, row);
+    }
+
+    return mres;
+}
+
+inline MatrixFixed<4, 4, float> operator*(const MatrixFixed<4, 4, float>& m0,
+                                          const MatrixFixed<4, 4, float>& m1)
+{
+    MatrixFixed<4, 4, float> mres;
+    const float* const a = m0.getDataPointer();
+    const float* const b = m1.getDataPointer();
+
+    const __m128 b0 = _mm_loadu_ps(b);
+    const __m128 b1 = _mm_loadu_ps(b + 4);
+    const __m128 b2 = _mm_loadu_ps(b + 8);
+    const __m128 b3 = _mm_loadu_ps(b + 12);
+
+    for (size_t r = 0; r < 4; r++)
+    {
+        __m128 row = _mm_mul_ps(_mm_set1_ps(a[4 * r]), b0);
+        row = _mm_fmadd_ps(_mm_set1_ps(a[4 * r + 1]), b1, row);
+        row = _mm_fmadd_ps(_mm_set1_ps(a[4 * r + 2]), b2, row);
+        row = _mm_fmadd_ps(_mm_set1_ps(a[4 * r + 3]), b3, row);
+        _mm_storeu_ps(mres.getDataPointer() + 4 * r, row);
+    }
+
+    return mres;
+}
+
+inline MatrixFixed<3, 3, double> operator*(const MatrixFixed<3, 3, double>& m0,
+                                           const MatrixFixed<3, 3, double>& m1)
+{
+    MatrixFixed<3, 3, double> mres;
+    const double* const a = m0.getDataPointer();
+    const double* const b = m1.getDataPointer();
+    const __m256i mask = _mm256_setr_epi64x(-1, -1, -1, 0);
+
+    const __m256d b0 = _mm256_maskload_pd(b, mask);
+    const __m256d b1 = _mm256_maskload_pd(b + 3, mask);
+    const __m256d b2 = _mm256_maskload_pd(b + 6, mask);
+
+    for (size_t r = 0; r < 3; r++)
+    {
+        __m256d row = _mm256_mul_pd(_mm256_set1_pd(a[3 * r]), b0);
+        row = _mm256_fmadd_pd(_mm256_set1_pd(a[3 * r + 1]), b1, row);
+        row = _mm256_fmadd_pd(_mm256_set1_pd(a[3 * r + 2]), b2, row);
+        _mm256_maskstore_pd(mres.getDataPointer() + 3 * r, mask, row);
+    }
+
+    return mres;
+}
+
+inline MatrixFixed<3, 3, float> operator*(const MatrixFixed<3, 3, float>& m0,
+                                          const MatrixFixed<3, 3, float>& m1)
+{
+    MatrixFixed<3, 3, float> mres;
+    const float* const a = m0.getDataPointer();
+    const float* const b = m1.getDataPointer();
+    const __m128i mask = _mm_setr_epi32(-1, -1, -1, 0);
+
+    const __m128 b0 = _mm_maskload_ps(b, mask);
+    const __m128 b1 = _mm_maskload_ps(b + 3, mask);
+    const __m128 b2 = _mm_maskload_ps(b + 6, mask);
+
+    for (size_t r = 0; r < 3; r++)
+    {
+        __m128 row = _mm_mul_ps(_mm_set1_ps(a[3 * r]), b0);
+        row = _mm_fmadd_ps(_mm_set1_ps(a[3 * r + 1]), b1, row);
+        row = _mm_fmadd_ps(_mm_set1_ps(a[3 * r + 2]), b2, row);
+        _mm_maskstore_ps(mres.getDataPointer() + 3 * r, mask, row);
+    }
+
+    return mres;
+}
+
+#endif
+
+template <size_t N, typename T> MatrixFixed<N, N, T> identityMatrixFixed()
+{
+    MatrixFixed<N, N, T> m;
+
+    for (size_t r = 0; r < N; r++)
+    {
+        for (size_t c = 0; c < N; c++)
+        {
+            m(r, c) = (r == c) ? static_cast<T>(1) : static_cast<T>(0);
+        }
+    }
+
+    return m;
+}
+
+namespace internal
+{
+template <size_t N> using MatrixSize = std::integral_constant<size_t, N>;
+
+template <typename T> T determinantFixed(const MatrixFixed<1, 1, T>& m, MatrixSize<1>)
+{
+    return m(0, 0);
+}
+
+template <typename T> T determinantFixed(const MatrixFixed<2, 2, T>& m, MatrixSize<2>)
+{
+    return m(0, 0) * m(1, 1) - m(0, 1) * m(1, 0);
+}
+
+template <typename T> T determinantFixed(const MatrixFixed<3, 3, T>& m, MatrixSize<3>)
+{
+    return m(0, 0) * (m(1, 1) * m(2, 2) - m(1, 2) * m(2, 1)) -
+           m(0, 1) * (m(1, 0) * m(2, 2) - m(1, 2) * m(2, 0)) +
+           m(0, 2) * (m(1, 0) * m(2, 1) - m(1, 1) * m(2, 0));
+}
+
+// Laplace expansion along the first two rows, with the 2 x 2 minors of both row pairs
+template <typename T> T determinantFixed(const MatrixFixed<4, 4, T>& m, MatrixSize<4>)
+{
+    const T s0 = m(0, 0) * m(1, 1) - m(1, 0) * m(0, 1);
+    const T s1 = m(0, 0) * m(1, 2) - m(1, 0) * m(0, 2);
+    const T s2 = m(0, 0) * m(1, 3) - m(1, 0) * m(0, 3);
+    const T s3 = m(0, 1) * m(1, 2) - m(1, 1) * m(0, 2);
+    const T s4 = m(0, 1) * m(1, 3) - m(1, 1) * m(0, 3);
+    const T s5 = m(0, 2) * m(1, 3) - m(1, 2) * m(0, 3);
+
+    const T c5 = m(2, 2) * m(3, 3) - m(3, 2) * m(2, 3);
+    const T c4 = m(2, 1) * m(3, 3) - m(3, 1) * m(2, 3);
+    const T c3 = m(2, 1) * m(3, 2) - m(3, 1) * m(2, 2);
+    const T c2 = m(2, 0) * m(3, 3) - m(3, 0) * m(2, 3);
+    const T c1 = m(2, 0) * m(3, 2) - m(3, 0) * m(2, 2);
+    const T c0 = m(2, 0) * m(3, 1) - m(3, 0) * m(2, 1);
+
+    return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+}
+
+// LU decomposition with partial pivoting for larger matrices
+template <size_t N, typename T> T determinantFixed(MatrixFixed<N, N, T> m, MatrixSize<N>)
+{
+    T det = static_cast<T>(1);
+
+    for (size_t k = 0; k < N; k++)
+    {
+        size_t pivot = k;
+        for (size_t r = k + 1; r < N; r++)
+        {
+            if (std::fabs(m(r, k)) > std::fabs(m(pivot, k)))
+            {
+                pivot = r;
+            }
+        }
+
+        if (m(pivot, k) == static_cast<T>(0))
+        {
+            return static_cast<T>(0);
+        }
+        else if (pivot != k)
+        {
+            m.switchRows(pivot, k);
+            det = -det;
+        }
+
+        det = det * m(k, k);
+        for (size_t r = k + 1; r < N; r++)
+        {
+            const T f = m(r, k) / m(k, k);
+            for (size_t c = k + 1; c < N; c++)
+            {
+                m(r, c) = m(r, c) - f * m(k, c);
+            }
+        }
+    }
+
+    return det;
+}
+
+template <typename T>
+MatrixFixed<1, 1, T> inverseFixed(const MatrixFixed<1, 1, T>& m, MatrixSize<1>)
+{
+    MatrixFixed<1, 1, T> mres;
+    mres(0, 0) = static_cast<T>(1) / m(0, 0);
+    return mres;
+}
+
+template <typename T>
+MatrixFixed<2, 2, T> inverseFixed(const MatrixFixed<2, 2, T>& m, MatrixSize<2>)
+{
+    const T inv_det = static_cast<T>(1) / (m(0, 0) * m(1, 1) - m(0, 1) * m(1, 0));
+    MatrixFixed<2, 2, T> mres;
+
+    mres(0, 0) = m(1, 1) * inv_det;
+    mres(0, 1) = -m(0, 1) * inv_det;
+    mres(1, 0) = -m(1, 0) * inv_det;
+    mres(1, 1) = m(0, 0) * inv_det;
+
+    return mres;
+}
+
+// Adjugate divided by the determinant
+template <typename T>
+MatrixFixed<3, 3, T> inverseFixed(const MatrixFixed<3, 3, T>& m, MatrixSize<3>)
+{
+    const T c00 = m(1, 1) * m(2, 2) - m(1, 2) * m(2, 1);
+    const T c01 = m(1, 2) * m(2, 0) - m(1, 0) * m(2, 2);
+    const T c02 = m(1, 0) * m(2, 1) - m(1, 1) * m(2, 0);
+
+    const T inv_det = static_cast<T>(1) / (m(0, 0) * c00 + m(0, 1) * c01 + m(0, 2) * c02);
+    MatrixFixed<3, 3, T> mres;
+
+    mres(0, 0) = c00 * inv_det;
+    mres(0, 1) = (m(0, 2) * m(2, 1) - m(0, 1) * m(2, 2)) * inv_det;
+    mres(0, 2) = (m(0, 1) * m(1, 2) - m(0, 2) * m(1, 1)) * inv_det;
+
+    mres(1, 0) = c01 * inv_det;
+    mres(1, 1) = (m(0, 0) * m(2, 2) - m(0, 2) * m(2, 0)) * inv_det;
+    mres(1, 2) = (m(0, 2) * m(1, 0) - m(0, 0) * m(1, 2)) * inv_det;
+
+    mres(2, 0) = c02 * inv_det;
+    mres(2, 1) = (m(0, 1) * m(2, 0) - m(0, 0) * m(2, 1)) * inv_det;
+    mres(2, 2) = (m(0, 0) * m(1, 1) - m(0, 1) * m(1, 0)) * inv_det;
+
+    return mres;
+}
+
+// Adjugate from the same 2 x 2 minors as the determinant
+template <typename T>
+MatrixFixed<4, 4, T> inverseFixed(const MatrixFixed<4, 4, T>& m, MatrixSize<4>)
+{
+    const T s0 = m(0, 0) * m(1, 1) - m(1, 0) * m(0, 1);
+    const T s1 = m(0, 0) * m(1, 2) - m(1, 0) * m(0, 2);
+    const T s2 = m(0, 0) * m(1, 3) - m(1, 0) * m(0, 3);
+    const T s3 = m(0, 1) * m(1, 2) - m(1, 1) * m(0, 2);
+    const T s4 = m(0, 1) * m(1, 3) - m(1, 1) * m(0, 3);
+    const T s5 = m(0, 2) * m(1, 3) - m(1, 2) * m(0, 3);
+
+    const T c5 = m(2, 2) * m(3, 3) - m(3, 2) * m(2, 3);
+    const T c4 = m(2, 1) * m(3, 3) - m(3, 1) * m(2, 3);
+    const T c3 = m(2, 1) * m(3, 2) - m(3, 1) * m(2, 2);
+    const T c2 = m(2, 0) * m(3, 3) - m(3, 0) * m(2, 3);
+    const T c1 = m(2, 0) * m(3, 2) - m(3, 0) * m(2, 2);
+    const T c0 = m(2, 0) * m(3, 1) - m(3, 0) * m(2, 1);
+
+    const T inv_det =
+        static_cast<T>(1) / (s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0);
+    MatrixFixed<4, 4, T> mres;
+
+    mres(0, 0) = (m(1, 1) * c5 - m(1, 2) * c4 + m(1, 3) * c3) * inv_det;
+    mres(0, 1) = (-m(0, 1) * c5 + m(0, 2) * c4 - m(0, 3) * c3) * inv_det;
+    mres(0, 2) = (m(3, 1) * s5 - m(3, 2) * s4 + m(3, 3) * s3) * inv_det;
+    mres(0, 3) = (-m(2, 1) * s5 + m(2, 2) * s4 - m(2, 3) * s3) * inv_det;
+
+    mres(1, 0) = (-m(1, 0) * c5 + m(1, 2) * c2 - m(1, 3) * c1) * inv_det;
+    mres(1, 1) = (m(0, 0) * c5 - m(0, 2) * c2 + m(0, 3) * c1) * inv_det;
+    mres(1, 2) = (-m(3, 0) * s5 + m(3, 2) * s2 - m(3, 3) * s1) * inv_det;
+    mres(1, 3) = (m(2, 0) * s5 - m(2, 2) * s2 + m(2, 3) * s1) * inv_det;
+
+    mres(2, 0) = (m(1, 0) * c4 - m(1, 1) * c2 + m(1, 3) * c0) * inv_det;
+    mres(2, 1) = (-m(0, 0) * c4 + m(0, 1) * c2 - m(0, 3) * c0) * inv_det;
+    mres(2, 2) = (m(3, 0) * s4 - m(3, 1) * s2 + m(3, 3) * s0) * inv_det;
+    mres(2, 3) = (-m(2, 0) * s4 + m(2, 1) * s2 - m(2, 3) * s0) * inv_det;
+
+    mres(3, 0) = (-m(1, 0) * c3 + m(1, 1) * c1 - m(1, 2) * c0) * inv_det;
+    mres(3, 1) = (m(0, 0) * c3 - m(0, 1) * c1 + m(0, 2) * c0) * inv_det;
+    mres(3, 2) = (-m(3, 0) * s3 + m(3, 1) * s1 - m(3, 2) * s0) * inv_det;
+    mres(3, 3) = (m(2, 0) * s3 - m(2, 1) * s1 + m(2, 2) * s0) * inv_det;
+
+    return mres;
+}
+
+// Gauss-Jordan elimination with partial pivoting for larger matrices
+template <size_t N, typename T>
+MatrixFixed<N, N, T> inverseFixed(MatrixFixed<N, N, T> m, MatrixSize<N>)
+{
+    MatrixFixed<N, N, T> mres = identityMatrixFixed<N, T>();
+
+    for (size_t k = 0; k < N; k++)
+    {
+        size_t pivot = k;
+        for (size_t r = k + 1; r < N; r++)
+        {
+            if (std::fabs(m(r, k)) > std::fabs(m(pivot, k)))
+            {
+                pivot = r;
+            }
+        }
+
+        if (pivot != k)
+        {
+            m.switchRows(pivot, k);
+            mres.switchRows(pivot, k);
+        }
+
+        const T inv_pivot = static_cast<T>(1) / m(k, k);
+        for (size_t c = 0; c < N; c++)
+        {
+            m(k, c) = m(k, c) * inv_pivot;
+            mres(k, c) = mres(k, c) * inv_pivot;
+        }
+
+        for (size_t r = 0; r < N; r++)
+        {
+            const T f = m(r, k);
+            if ((r == k) || (f == static_cast<T>(0)))
+            {
+                continue;
+            }
+
+            for (size_t c = 0; c < N; c++)
+            {
+                m(r, c) = m(r, c) - f * m(k, c);
+                mres(r, c) = mres(r, c) - f * mres(k, c);
+            }
+        }
+    }
+
+    return mres;
+}
+}  // namespace internal
+
+template <size_t N, typename T> T determinant(const MatrixFixed<N, N, T>& m)
+{
+    return internal::determinantFixed(m, internal::MatrixSize<N>());
+}
+
+// The elements of the inverse of a singular matrix are not finite
+template <size_t N, typename T> MatrixFixed<N, N, T> inverse(const MatrixFixed<N, N, T>& m)
+{
+    return internal::inverseFixed(m, internal::MatrixSize<N>());
+}
+
+template <size_t R, size_t C, typename T>
+MatrixFixed<C, R, T> transpose(const MatrixFixed<R, C, T>& m)
+{
+    return m.transposed();
+}
+
 // New functions
 
 template <size_t R, size_t C, typename T>
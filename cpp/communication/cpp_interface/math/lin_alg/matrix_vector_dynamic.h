@@ -149,7 +149,8 @@ template <typename T> void Matrix<T>::hCat(const Vector<T>& v)
     PT_ASSERT(num_rows_ == v.size()) << "Mismatch in number of cols!";
 
     T* temp_data;
-    DATA_ALLOCATION(temp_data, num_rows_ * (num_cols_ + 1), T, "Matrix");
+    temp_data = internal::allocateElements<T>(
+        memory_resource_, num_rows_ * (num_cols_ + 1), "Matrix");
 
     for (size_t r = 0; r < num_rows_; r++)
     {
@@ -166,7 +167,7 @@ template <typename T> void Matrix<T>::hCat(const Vector<T>& v)
         temp_data[r * num_cols_ + num_cols_ - 1] = v(r);
     }
 
-    delete[] data_;
+    internal::deallocateElements(memory_resource_, data_, num_rows_ * (num_cols_ - 1));
     data_ = temp_data;
 }
 
@@ -177,7 +178,8 @@ template <typename T> void Matrix<T>::vCat(const Vector<T>& v)
     PT_ASSERT(num_rows_ == v.size()) << "Mismatch in number of cols!";
 
     T* temp_data;
-    DATA_ALLOCATION(temp_data, (num_rows_ + 1) * num_cols_, T, "Matrix");
+    temp_data = internal::allocateElements<T>(
+        memory_resource_, (num_rows_ + 1) * num_cols_, "Matrix");
 
     for (size_t r = 0; r < num_rows_; r++)
     {
@@ -194,7 +196,7 @@ template <typename T> void Matrix<T>::vCat(const Vector<T>& v)
         temp_data[(num_rows_ - 1) * num_cols_ + c] = v(c);
     }
 
-    delete[] data_;
+    internal::deallocateElements(memory_resource_, data_, (num_rows_ - 1) * num_cols_);
     data_ = temp_data;
 }
 
@@ -236,7 +238,7 @@ template <typename T> void Matrix<T>::hCat(const Matrix<T>& m)
     const size_t new_num_cols = num_cols_ + m.cols();
 
     T* temp_data;
-    DATA_ALLOCATION(temp_data, num_rows_ * new_num_cols, T, "Matrix");
+    temp_data = internal::allocateElements<T>(memory_resource_, num_rows_ * new_num_cols, "Matrix");
 
     for (size_t r = 0; r < num_rows_; r++)
     {
@@ -253,7 +255,7 @@ template <typename T> void Matrix<T>::hCat(const Matrix<T>& m)
             temp_data[r * new_num_cols + c] = m(r, c - num_cols_);
         }
     }
-    delete data_;
+    internal::deallocateElements(memory_resource_, data_, num_rows_ * num_cols_);
     data_ = temp_data;
     num_cols_ = new_num_cols;
 }
@@ -266,7 +268,7 @@ template <typename T> void Matrix<T>::vCat(const Matrix<T>& m)
     const size_t new_num_rows = num_rows_ + m.rows();
 
     T* temp_data;
-    DATA_ALLOCATION(temp_data, new_num_rows * num_cols_, T, "Matrix");
+    temp_data = internal::allocateElements<T>(memory_resource_, new_num_rows * num_cols_, "Matrix");
 
     for (size_t r = 0; r < num_rows_; r++)
     {
@@ -283,7 +285,7 @@ template <typename T> void Matrix<T>::vCat(const Matrix<T>& m)
             temp_data[r * num_cols_ + c] = m(r - num_rows_, c);
         }
     }
-    delete data_;
+    internal::deallocateElements(memory_resource_, data_, num_rows_ * num_cols_);
     data_ = temp_data;
     num_rows_ = new_num_rows;
 }
@@ -1,27 +1,51 @@
 #ifndef PLOT_TOOL_MATRIX_VECTOR_FIXED_H_
 #define PLOT_TOOL_MATRIX_VECTOR_FIXED_H_
 
-#include "math/matrix_fixed.h"
-#include "math/vector_fixed.h"
+#include "math/lin_alg/matrix_fixed/matrix_fixed.h"
+#include "math/lin_alg/vector_fixed/vector_fixed.h"
+#include "math/misc/simd.h"
 
 namespace plot_tool
 {
-/*template <size_t N, typename T>
-MatrixFixed<N, N, T> VectorFixed<N, T>::outerProduct(const VectorFixed<N, T>& v) const
+template <size_t N, typename T> MatrixFixed<1, N, T> VectorFixed<N, T>::toRowVectorMat() const
 {
-    assert(vector_length_ == v.size());
-    MatrixFixed<N, N, T> mat;
+    MatrixFixed<1, N, T> mres;
 
-    for (size_t r = 0; r < vector_length_; r++)
+    for (size_t k = 0; k < N; k++)
     {
-        for (size_t c = 0; c < vector_length_; c++)
+        mres(0, k) = data_[k];
+    }
+
+    return mres;
+}
+
+template <size_t N, typename T> MatrixFixed<N, 1, T> VectorFixed<N, T>::toColVectorMat() const
+{
+    MatrixFixed<N, 1, T> mres;
+
+    for (size_t k = 0; k < N; k++)
+    {
+        mres(k, 0) = data_[k];
+    }
+
+    return mres;
+}
+
+template <size_t N, typename T>
+MatrixFixed<N, N, T> outerProduct(const VectorFixed<N, T>& v0, const VectorFixed<N, T>& v1)
+{
+    MatrixFixed<N, N, T> mres;
+
+    for (size_t r = 0; r < N; r++)
+    {
+        for (size_t c = 0; c < N; c++)
         {
-            mat(r, c) = data_[r] * v(c);
+            mres(r, c) = v0(r) * v1(c);
         }
     }
 
-    return mat;
-}*/
+    return mres;
+}
 
 template <size_t R, size_t C, typename T>
 VectorFixed<R, T> operator*(const MatrixFixed<R, C, T>& m, const VectorFixed<C, T>& v)
@@ -33,7 +57,7 @@ VectorFixed<R, T> operator*(const MatrixFixed<R, C, T>& m, const VectorFixed<C,
         T s = 0.0;
         for (size_t c = 0; c < m.cols(); c++)
         {
-            s = s + m(r, c) + v(c);
+            s = s + m(r, c) * v(c);
         }
         vres(r) = s;
     }
@@ -41,7 +65,7 @@ VectorFixed<R, T> operator*(const MatrixFixed<R, C, T>& m, const VectorFixed<C,
 }
 
 template <size_t R, size_t C, typename T>
-VectorFixed<R, T> operator*(const VectorFixed<R, T>& v, const MatrixFixed<R, C, T>& m)
+VectorFixed<C, T> operator*(const VectorFixed<R, T>& v, const MatrixFixed<R, C, T>& m)
 {
     VectorFixed<C, T> vres;
 
@@ -50,13 +74,40 @@ VectorFixed<R, T> operator*(const VectorFixed<R, T>& v, const MatrixFixed<R, C,
         T s = 0.0;
         for (size_t r = 0; r < m.rows(); r++)
         {
-            s = s + m(r, c) + v(r);
+            s = s + m(r, c) * v(r);
         }
         vres(c) = s;
     }
     return vres;
 }
 
+#ifdef PLOT_TOOL_SIMD_AVX2
+
+// The four row products are summed pairwise with horizontal adds, which leaves the sums of
+// the low and high halves of each row in the two 128 bit lanes
+inline VectorFixed<4, double> operator*(const MatrixFixed<4, 4, double>& m,
+                                        const VectorFixed<4, double>& v)
+{
+    const double* const a = m.getDataPointer();
+    const __m256d x = _mm256_loadu_pd(v.getDataPointer());
+
+    const __m256d p0 = _mm256_mul_pd(_mm256_loadu_pd(a), x);
+    const __m256d p1 = _mm256_mul_pd(_mm256_loadu_pd(a + 4), x);
+    const __m256d p2 = _mm256_mul_pd(_mm256_loadu_pd(a + 8), x);
+    const __m256d p3 = _mm256_mul_pd(_mm256_loadu_pd(a + 12), x);
+
+    const __m256d h01 = _mm256_hadd_pd(p0, p1);
+    const __m256d h23 = _mm256_hadd_pd(p2, p3);
+    const __m256d lanes_swapped = _mm256_permute2f128_pd(h01, h23, 0x21);
+    const __m256d lanes_blended = _mm256_blend_pd(h01, h23, 0xC);
+
+    VectorFixed<4, double> vres;
+    _mm256_storeu_pd(vres.getDataPointer(), _mm256_add_pd(lanes_swapped, lanes_blended));
+    return vres;
+}
+
+#endif
+
 }  // namespace plot_tool
 
 #endif
@@ -5,19 +5,27 @@
 
 namespace plot_tool
 {
-template <typename T> class Vector
+template <typename T> class Vector : public ElementwiseExpression<Vector<T>, Vector<T>>
 {
 protected:
     T* data_;
     size_t vector_length_;
+    size_t capacity_;
     bool is_allocated_;
+    MemoryResource* memory_resource_;
+
+    void reallocate(const size_t new_capacity);
+    void growForNumElements(const size_t num_elements);
+    void allocateForAssignment(const size_t num_elements);
 
 public:
     Vector();
     Vector(const size_t vector_length);
+    Vector(const size_t vector_length, MemoryResource* const memory_resource);
     Vector(const Vector<T>& v);
     Vector(Vector<T>&& v);
     template <typename Y> Vector(const Vector<Y>& v);
+    template <typename E, typename Y> Vector(const ElementwiseExpression<E, Vector<Y>>& e);
 
     Vec2D<T> toVec2D() const;
     Vec3D<T> toVec3D() const;
@@ -32,6 +40,8 @@ public:
 
     Vector<T>& operator=(const Vector<T>& v);
     Vector<T>& operator=(Vector<T>&& v);
+    template <typename E, typename Y>
+    Vector<T>& operator=(const ElementwiseExpression<E, Vector<Y>>& e);
     T& operator()(const size_t idx);
     const T& operator()(const size_t idx) const;
     T& operator()(const EndIndex& end_idx);
@@ -50,6 +60,11 @@ public:
     size_t endIndex() const;
     T* getDataPointer() const;
 
+    MemoryResource* memoryResource() const;
+    size_t capacity() const;
+    void reserve(const size_t new_capacity);
+    void shrinkToFit();
+
     void pushBack(const T& new_value);
     void pushFront(const T& new_value);
     void insertAtIndex(const T& new_value, const size_t idx);
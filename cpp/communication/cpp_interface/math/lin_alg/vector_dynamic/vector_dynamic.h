@@ -1,32 +1,59 @@
 #ifndef PLOT_TOOL_VECTOR_DYNAMIC_H_
 #define PLOT_TOOL_VECTOR_DYNAMIC_H_
 
+#include <algorithm>
 #include <cmath>
 #include <type_traits>
 #include <utility>
 
 #include "logging.h"
+#include "math/lin_alg/elementwise_expression/elementwise_expression.h"
 #include "math/math_core.h"
+#include "math/misc/array_reductions.h"
 #include "math/misc/math_macros.h"
+#include "math/misc/memory_resource.h"
+#include "math/misc/sorting.h"
 
 namespace plot_tool
 {
-template <typename T> Vector<T>::Vector() : data_(nullptr), vector_length_(0), is_allocated_(false)
+template <typename T>
+Vector<T>::Vector()
+    : data_(nullptr),
+      vector_length_(0),
+      capacity_(0),
+      is_allocated_(false),
+      memory_resource_(defaultMemoryResource())
+{
+}
+
+template <typename T>
+Vector<T>::Vector(const size_t vector_length)
+    : is_allocated_(true), memory_resource_(defaultMemoryResource())
 {
+    vector_length_ = vector_length;
+    capacity_ = vector_length;
+
+    data_ = internal::allocateElements<T>(memory_resource_, vector_length, "Vector");
 }
 
-template <typename T> Vector<T>::Vector(const size_t vector_length) : is_allocated_(true)
+template <typename T>
+Vector<T>::Vector(const size_t vector_length, MemoryResource* const memory_resource)
+    : is_allocated_(true), memory_resource_(memory_resource)
 {
     vector_length_ = vector_length;
+    capacity_ = vector_length;
 
-    DATA_ALLOCATION(data_, vector_length, T, "Vector");
+    data_ = internal::allocateElements<T>(memory_resource_, vector_length, "Vector");
 }
 
-template <typename T> Vector<T>::Vector(const Vector<T>& v) : is_allocated_(true)
+template <typename T>
+Vector<T>::Vector(const Vector<T>& v)
+    : is_allocated_(true), memory_resource_(defaultMemoryResource())
 {
     vector_length_ = v.size();
+    capacity_ = v.size();
 
-    DATA_ALLOCATION(data_, v.size(), T, "Vector");
+    data_ = internal::allocateElements<T>(memory_resource_, v.size(), "Vector");
 
     for (size_t k = 0; k < v.size(); k++)
     {
@@ -39,7 +66,9 @@ template <typename T> Vector<T>::Vector(Vector<T>&& v)
     PT_ASSERT(v.isAllocated()) << "Input vector not allocated!";
     data_ = v.getDataPointer();
     vector_length_ = v.size();
+    capacity_ = v.capacity_;
     is_allocated_ = true;
+    memory_resource_ = v.memory_resource_;
 
     v.setInternalData(nullptr, 0);
 }
@@ -52,11 +81,13 @@ template <typename T> Vector<T>& Vector<T>::operator=(Vector<T>&& v)
 
         if (is_allocated_)
         {
-            delete[] data_;
+            internal::deallocateElements(memory_resource_, data_, capacity_);
         }
 
         vector_length_ = v.size();
+        capacity_ = v.capacity_;
         is_allocated_ = true;
+        memory_resource_ = v.memory_resource_;
 
         data_ = v.getDataPointer();
 
@@ -70,7 +101,7 @@ template <typename T> Vector<T>::~Vector()
 {
     if (is_allocated_)
     {
-        delete[] data_;
+        internal::deallocateElements(memory_resource_, data_, capacity_);
         is_allocated_ = false;
     }
 }
@@ -81,21 +112,7 @@ template <typename T> Vector<T>& Vector<T>::operator=(const Vector<T>& v)
 
     if (this != &v)
     {
-        if (is_allocated_)
-        {
-            if (v.size() != vector_length_)
-            {
-                delete[] data_;
-                DATA_ALLOCATION(data_, v.size(), T, "Vector");
-            }
-        }
-        else
-        {
-            DATA_ALLOCATION(data_, v.size(), T, "Vector");
-        }
-        vector_length_ = v.size();
-
-        is_allocated_ = true;
+        allocateForAssignment(v.size());
 
         for (size_t k = 0; k < v.size(); k++)
         {
@@ -108,11 +125,13 @@ template <typename T> Vector<T>& Vector<T>::operator=(const Vector<T>& v)
 
 template <typename T>
 template <typename Y>
-Vector<T>::Vector(const Vector<Y>& v) : is_allocated_(true)
+Vector<T>::Vector(const Vector<Y>& v)
+    : is_allocated_(true), memory_resource_(defaultMemoryResource())
 {
     vector_length_ = v.size();
+    capacity_ = v.size();
 
-    DATA_ALLOCATION(data_, v.size(), T, "Vector");
+    data_ = internal::allocateElements<T>(memory_resource_, v.size(), "Vector");
 
     for (size_t k = 0; k < v.size(); k++)
     {
@@ -120,22 +139,39 @@ Vector<T>::Vector(const Vector<Y>& v) : is_allocated_(true)
     }
 }
 
+template <typename T>
+template <typename E, typename Y>
+Vector<T>::Vector(const ElementwiseExpression<E, Vector<Y>>& e)
+    : is_allocated_(true), memory_resource_(defaultMemoryResource())
+{
+    const typename ExpressionOperand<E>::Type expr(e.derived());
+    vector_length_ = expr.rows();
+    capacity_ = vector_length_;
+
+    data_ = internal::allocateElements<T>(memory_resource_, vector_length_, "Vector");
+    evaluateExpression(expr, data_);
+}
+
+template <typename T>
+template <typename E, typename Y>
+Vector<T>& Vector<T>::operator=(const ElementwiseExpression<E, Vector<Y>>& e)
+{
+    const typename ExpressionOperand<E>::Type expr(e.derived());
+
+    // Evaluated in place if the size is the same, which is safe also if this vector is in the
+    // expression, since each element only depends on the elements at the same index, and each
+    // block is evaluated before it's written. If the size differs, this vector can't be in the
+    // expression.
+    allocateForAssignment(expr.rows());
+
+    evaluateExpression(expr, data_);
+
+    return *this;
+}
+
 template <typename T> template <typename Y> Vector<T>& Vector<T>::operator=(const Vector<Y>& v)
 {
-    if (is_allocated_)
-    {
-        if (v.size() != vector_length_)
-        {
-            delete[] data_;
-            DATA_ALLOCATION(data_, v.size(), T, "Vector");
-        }
-    }
-    else
-    {
-        DATA_ALLOCATION(data_, v.size(), T, "Vector");
-    }
-    vector_length_ = v.size();
-    is_allocated_ = true;
+    allocateForAssignment(v.size());
 
     for (size_t k = 0; k < v.size(); k++)
     {
@@ -145,14 +181,16 @@ template <typename T> template <typename Y> Vector<T>& Vector<T>::operator=(cons
     return *this;
 }
 
-template <typename T> Vector<T>::Vector(const std::initializer_list<T>& il)
+template <typename T>
+Vector<T>::Vector(const std::initializer_list<T>& il) : memory_resource_(defaultMemoryResource())
 {
     PT_ASSERT(il.size() > 0) << "Tried to initialize with empty vector!";
 
-    DATA_ALLOCATION(data_, il.size(), T, "Vector");
+    data_ = internal::allocateElements<T>(memory_resource_, il.size(), "Vector");
     is_allocated_ = true;
 
     vector_length_ = il.size();
+    capacity_ = il.size();
 
     size_t idx = 0;
     for (auto list_element : il)
@@ -162,18 +200,22 @@ template <typename T> Vector<T>::Vector(const std::initializer_list<T>& il)
     }
 }
 
-template <typename T> Vector<T>::Vector(const std::vector<T>& v)
+template <typename T>
+Vector<T>::Vector(const std::vector<T>& v) : memory_resource_(defaultMemoryResource())
 {
     if (v.size() == 0)
     {
+        data_ = nullptr;
         vector_length_ = 0;
+        capacity_ = 0;
         is_allocated_ = false;
     }
     else
     {
         vector_length_ = v.size();
+        capacity_ = v.size();
 
-        DATA_ALLOCATION(data_, v.size(), T, "Vector");
+        data_ = internal::allocateElements<T>(memory_resource_, v.size(), "Vector");
         is_allocated_ = true;
 
         size_t idx = 0;
@@ -192,78 +234,124 @@ template <typename T> Vector<T>&& Vector<T>::move()
     return std::move(*this);
 }
 
-template <typename T> void Vector<T>::pushBack(const T& new_value)
+// Moves the elements to a new array of new_capacity >= vector_length_ elements
+template <typename T> void Vector<T>::reallocate(const size_t new_capacity)
 {
+    T* new_data;
+    new_data = internal::allocateElements<T>(memory_resource_, new_capacity, "Vector");
+    std::move(data_, data_ + vector_length_, new_data);
+
     if (is_allocated_)
     {
-        T* tmp_ptr;
-        DATA_ALLOCATION(tmp_ptr, vector_length_ + 1, T, "Vector");
-        for (size_t k = 0; k < vector_length_; k++)
-        {
-            tmp_ptr[k] = data_[k];
-        }
-        vector_length_ = vector_length_ + 1;
-        tmp_ptr[vector_length_ - 1] = new_value;
-
-        delete[] data_;
-        data_ = tmp_ptr;
+        internal::deallocateElements(memory_resource_, data_, capacity_);
     }
-    else
+    data_ = new_data;
+    capacity_ = new_capacity;
+    is_allocated_ = true;
+}
+
+// Grows the capacity geometrically, so that adding n elements one at a time moves each element
+// a constant number of times on average
+template <typename T> void Vector<T>::growForNumElements(const size_t num_elements)
+{
+    if (num_elements > capacity_)
     {
-        DATA_ALLOCATION(data_, 1, T, "Vector");
-        is_allocated_ = true;
-        vector_length_ = 1;
-        data_[0] = new_value;
+        reallocate(std::max(num_elements, std::max<size_t>(2 * capacity_, 4)));
     }
 }
 
-template <typename T> void Vector<T>::pushFront(const T& new_value)
+// Makes room for num_elements elements that are about to be overwritten. The current array is
+// kept if it's large enough, otherwise it's replaced without moving the old elements.
+template <typename T> void Vector<T>::allocateForAssignment(const size_t num_elements)
 {
-    if (is_allocated_)
+    if (!is_allocated_ || (num_elements > capacity_))
     {
-        T* tmp_ptr;
-        DATA_ALLOCATION(tmp_ptr, vector_length_ + 1, T, "Vector");
-        for (size_t k = 0; k < vector_length_; k++)
+        if (is_allocated_)
         {
-            tmp_ptr[k + 1] = data_[k];
+            internal::deallocateElements(memory_resource_, data_, capacity_);
         }
-        vector_length_ = vector_length_ + 1;
-        tmp_ptr[0] = new_value;
-
-        delete[] data_;
-        data_ = tmp_ptr;
+        data_ = internal::allocateElements<T>(memory_resource_, num_elements, "Vector");
+        capacity_ = num_elements;
+        is_allocated_ = true;
     }
-    else
+    vector_length_ = num_elements;
+}
+
+template <typename T> MemoryResource* Vector<T>::memoryResource() const
+{
+    return memory_resource_;
+}
+
+template <typename T> size_t Vector<T>::capacity() const
+{
+    return capacity_;
+}
+
+template <typename T> void Vector<T>::reserve(const size_t new_capacity)
+{
+    if (new_capacity > capacity_)
     {
-        DATA_ALLOCATION(data_, 1, T, "Vector");
-        is_allocated_ = true;
-        vector_length_ = 1;
-        data_[0] = new_value;
+        reallocate(new_capacity);
     }
 }
 
-template <typename T> void Vector<T>::insertAtIndex(const T& new_value, const size_t idx)
+template <typename T> void Vector<T>::shrinkToFit()
 {
-    PT_ASSERT(is_allocated_) << "Vector not allocated!";
-    PT_ASSERT(idx < vector_length_);
+    if (capacity_ == vector_length_)
+    {
+        return;
+    }
 
-    T* tmp_ptr;
-    DATA_ALLOCATION(tmp_ptr, vector_length_ + 1, T, "Vector");
+    if (vector_length_ == 0)
+    {
+        internal::deallocateElements(memory_resource_, data_, capacity_);
+        data_ = nullptr;
+        capacity_ = 0;
+        is_allocated_ = false;
+    }
+    else
+    {
+        reallocate(vector_length_);
+    }
+}
 
-    for (size_t k = 0; k < idx; k++)
+template <typename T> void Vector<T>::pushBack(const T& new_value)
+{
+    if (vector_length_ == capacity_)
     {
-        tmp_ptr[k] = data_[k];
+        // new_value may refer to an element of this vector
+        T value_copy = new_value;
+        growForNumElements(vector_length_ + 1);
+        data_[vector_length_] = std::move(value_copy);
     }
-    tmp_ptr[idx] = new_value;
-    for (size_t k = idx; k < vector_length_; k++)
+    else
     {
-        tmp_ptr[k + 1] = data_[k];
+        data_[vector_length_] = new_value;
     }
+    vector_length_ = vector_length_ + 1;
+}
+
+template <typename T> void Vector<T>::pushFront(const T& new_value)
+{
+    T value_copy = new_value;
+    growForNumElements(vector_length_ + 1);
 
+    std::move_backward(data_, data_ + vector_length_, data_ + vector_length_ + 1);
+    data_[0] = std::move(value_copy);
     vector_length_ = vector_length_ + 1;
+}
+
+template <typename T> void Vector<T>::insertAtIndex(const T& new_value, const size_t idx)
+{
+    PT_ASSERT(is_allocated_) << "Vector not allocated!";
+    PT_ASSERT(idx < vector_length_);
 
-    delete[] data_;
-    data_ = tmp_ptr;
+    T value_copy = new_value;
+    growForNumElements(vector_length_ + 1);
+
+    std::move_backward(data_ + idx, data_ + vector_length_, data_ + vector_length_ + 1);
+    data_[idx] = std::move(value_copy);
+    vector_length_ = vector_length_ + 1;
 }
 
 template <typename T> T& Vector<T>::operator()(const size_t idx)
@@ -387,11 +475,15 @@ template <typename T> void Vector<T>::fill(const T& val)
 
 template <typename T> void Vector<T>::resize(const size_t vector_length)
 {
-    if ((vector_length != vector_length_) && (vector_length != 0))
+    if (is_allocated_ && (vector_length != 0) && (vector_length <= capacity_))
+    {
+        vector_length_ = vector_length;
+    }
+    else if ((vector_length != vector_length_) && (vector_length != 0))
     {
         if (is_allocated_)
         {
-            delete[] data_;
+            internal::deallocateElements(memory_resource_, data_, capacity_);
         }
 
         if (vector_length == 0)
@@ -402,8 +494,9 @@ template <typename T> void Vector<T>::resize(const size_t vector_length)
         else
         {
             is_allocated_ = true;
-            DATA_ALLOCATION(data_, vector_length, T, "Vector");
+            data_ = internal::allocateElements<T>(memory_resource_, vector_length, "Vector");
             vector_length_ = vector_length;
+            capacity_ = vector_length;
         }
     }
 }
@@ -459,6 +552,7 @@ template <typename T> void Vector<T>::setInternalData(T* const input_ptr, const
 
     data_ = input_ptr;
     vector_length_ = num_elements;
+    capacity_ = num_elements;
 }
 
 template <typename T> Vector<T> Vector<T>::sorted() const
@@ -471,27 +565,7 @@ template <typename T> Vector<T> Vector<T>::sorted() const
 
 template <typename T> void Vector<T>::sort()
 {
-    bool done = false;
-
-    while (!done)
-    {
-        bool did_swap = false;
-        for (size_t k = 0; k < vector_length_ - 1; k++)
-        {
-            if (data_[k] > data_[k + 1])
-            {
-                const T temp = data_[k];
-                data_[k] = data_[k + 1];
-                data_[k + 1] = temp;
-
-                did_swap = true;
-            }
-        }
-        if (!did_swap)
-        {
-            done = true;
-        }
-    }
+    internal::sortArray(data_, vector_length_);
 }
 
 template <typename T> T Vector<T>::norm() const
@@ -568,140 +642,6 @@ template <typename T> Vector<T> operator%(const Vector<T>& v, const int i)
     return vout;
 }
 
-template <typename T> Vector<T> operator*(const T f, const Vector<T>& v)
-{
-    Vector<T> v_res(v.size());
-    for (size_t k = 0; k < v.size(); k++)
-    {
-        v_res(k) = f * v(k);
-    }
-    return v_res;
-}
-
-template <typename T> Vector<T> operator*(const Vector<T>& v, const T f)
-{
-    Vector<T> v_res(v.size());
-    for (size_t k = 0; k < v.size(); k++)
-    {
-        v_res(k) = f * v(k);
-    }
-    return v_res;
-}
-
-template <typename T> Vector<T> operator^(const Vector<T>& v0, const Vector<T>& v1)
-{
-    assert(v0.size() == v1.size());
-    Vector<T> v_res(v0.size());
-    for (size_t k = 0; k < v0.size(); k++)
-    {
-        v_res(k) = v0(k) * v1(k);
-    }
-    return v_res;
-}
-
-template <typename T> Vector<T> operator/(const Vector<T>& v0, const Vector<T>& v1)
-{
-    assert(v0.size() == v1.size());
-    Vector<T> v_res(v0.size());
-    for (size_t k = 0; k < v0.size(); k++)
-    {
-        v_res(k) = v0(k) / v1(k);
-    }
-    return v_res;
-}
-
-template <typename T> Vector<T> operator/(const Vector<T>& v, const T f)
-{
-    Vector<T> v_res(v.size());
-    for (size_t k = 0; k < v.size(); k++)
-    {
-        v_res(k) = v(k) / f;
-    }
-    return v_res;
-}
-
-template <typename T> Vector<T> operator/(const T f, const Vector<T>& v)
-{
-    Vector<T> v_res(v.size());
-    for (size_t k = 0; k < v.size(); k++)
-    {
-        v_res(k) = f / v(k);
-    }
-    return v_res;
-}
-
-template <typename T> Vector<T> operator+(const Vector<T>& v, const T f)
-{
-    Vector<T> v_res(v.size());
-    for (size_t k = 0; k < v.size(); k++)
-    {
-        v_res(k) = v(k) + f;
-    }
-    return v_res;
-}
-
-template <typename T> Vector<T> operator+(const T f, const Vector<T>& v)
-{
-    Vector<T> v_res(v.size());
-    for (size_t k = 0; k < v.size(); k++)
-    {
-        v_res(k) = v(k) + f;
-    }
-    return v_res;
-}
-
-template <typename T> Vector<T> operator-(const Vector<T>& v, const T f)
-{
-    Vector<T> v_res(v.size());
-    for (size_t k = 0; k < v.size(); k++)
-    {
-        v_res(k) = v(k) - f;
-    }
-    return v_res;
-}
-
-template <typename T> Vector<T> operator-(const T f, const Vector<T>& v)
-{
-    Vector<T> v_res(v.size());
-    for (size_t k = 0; k < v.size(); k++)
-    {
-        v_res(k) = f - v(k);
-    }
-    return v_res;
-}
-
-template <typename T> Vector<T> operator-(const Vector<T>& v)
-{
-    Vector<T> v_res(v.size());
-    for (size_t k = 0; k < v.size(); k++)
-    {
-        v_res(k) = -v(k);
-    }
-    return v_res;
-}
-
-template <typename T> Vector<T> operator+(const Vector<T>& v0, const Vector<T>& v1)
-{
-    assert(v0.size() == v1.size());
-    Vector<T> v_res(v0.size());
-    for (size_t k = 0; k < v0.size(); k++)
-    {
-        v_res(k) = v0(k) + v1(k);
-    }
-    return v_res;
-}
-
-template <typename T> Vector<T> operator-(const Vector<T>& v0, const Vector<T>& v1)
-{
-    assert(v0.size() == v1.size());
-    Vector<T> v_res(v0.size());
-    for (size_t k = 0; k < v0.size(); k++)
-    {
-        v_res(k) = v0(k) - v1(k);
-    }
-    return v_res;
-}
-
 template <typename T> Vector<bool> operator==(const Vector<T>& v0, const Vector<T>& v1)
 {
     assert(v0.size() == v1.size());
@@ -1054,21 +994,7 @@ template <typename T> void Vector<T>::removeElementAtIndex(const size_t idx)
     PT_ASSERT(is_allocated_) << "Vector not allocated!";
     PT_ASSERT(idx < vector_length_) << "Tried to remove element outside bounds!";
 
-    T* temp_data;
-
-    DATA_ALLOCATION(temp_data, vector_length_ - 1, T, "Vector");
-
-    size_t current_idx = 0;
-    for (size_t k = 0; k < vector_length_; k++)
-    {
-        if (current_idx != idx)
-        {
-            temp_data[current_idx] = data_[k];
-            current_idx++;
-        }
-    }
-    delete[] data_;
-    data_ = temp_data;
+    std::move(data_ + idx + 1, data_ + vector_length_, data_ + idx);
     vector_length_ = vector_length_ - 1;
 }
 
@@ -1082,23 +1008,11 @@ template <typename T> void Vector<T>::removeElementsAtIndices(const IndexSpan& i
         PT_LOG_WARNING() << "From and to indices are equal!";
     }
 
-    T* temp_data;
     size_t num_elements_to_remove = idx_span.to - idx_span.from + 1;
-    DATA_ALLOCATION(temp_data, vector_length_ - num_elements_to_remove, T, "Vector");
 
     PT_ASSERT((vector_length_ - num_elements_to_remove) > 0) << "Tried to remove all elements!";
 
-    size_t current_idx = 0;
-    for (size_t k = 0; k < vector_length_; k++)
-    {
-        if (current_idx < idx_span.from || idx_span.to < current_idx)
-        {
-            temp_data[current_idx] = data_[k];
-            current_idx++;
-        }
-    }
-    delete[] data_;
-    data_ = temp_data;
+    std::move(data_ + idx_span.to + 1, data_ + vector_length_, data_ + idx_span.from);
     vector_length_ = vector_length_ - num_elements_to_remove;
 }
 
@@ -1129,7 +1043,7 @@ template <typename T>
 Vector<T> Vector<T>::normalizedVectorBetweenPoints(const Point<T>& end_point) const
 {
     // "This" is start point
-    return (end_point - *this).normalized();
+    return vectorBetweenPoints(end_point).normalized();
 }
 
 template <typename T> T* Vector<T>::begin() const
@@ -1145,40 +1059,19 @@ template <typename T> T* Vector<T>::end() const
 template <typename T> T Vector<T>::min() const
 {
     ASSERT_VEC_VALID_INTERNAL();
-    T min_val = data_[0];
-
-    for (size_t k = 1; k < vector_length_; k++)
-    {
-        min_val = std::min(data_[k], min_val);
-    }
-
-    return min_val;
+    return internal::minOfArray(data_, vector_length_);
 }
 
 template <typename T> T Vector<T>::max() const
 {
     ASSERT_VEC_VALID_INTERNAL();
-    T max_val = data_[0];
-
-    for (size_t k = 1; k < vector_length_; k++)
-    {
-        max_val = std::max(data_[k], max_val);
-    }
-
-    return max_val;
+    return internal::maxOfArray(data_, vector_length_);
 }
 
 template <typename T> T Vector<T>::sum() const
 {
     ASSERT_VEC_VALID_INTERNAL();
-    T s = 0.0;
-
-    for (size_t k = 0; k < vector_length_; k++)
-    {
-        s = s + data_[k];
-    }
-
-    return s;
+    return internal::sumOfArray(data_, vector_length_);
 }
 
 }  // namespace plot_tool
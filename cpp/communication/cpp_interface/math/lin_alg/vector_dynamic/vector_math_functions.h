@@ -1,6 +1,7 @@
 #ifndef PLOT_TOOL_VECTOR_MATH_FUNCTIONS_H_
 #define PLOT_TOOL_VECTOR_MATH_FUNCTIONS_H_
 
+#include <algorithm>
 #include <cmath>
 #include <cstdarg>
 #include <cstdlib>
@@ -8,6 +9,10 @@
 
 #include "logging.h"
 #include "math/math_core.h"
+#include "math/misc/array_reductions.h"
+#include "math/misc/random_number_generator.h"
+#include "math/misc/sorting.h"
+#include "math/misc/thread_pool.h"
 
 namespace plot_tool
 {
@@ -68,182 +73,57 @@ template <typename T> Vector<T> concatenate(const std::initializer_list<Vector<T
     return vres;
 }
 
-template <typename T> Vector<T> round(const Vector<T>& vin)
-{
-    assert(vin.size() > 0);
-    Vector<T> v(vin.size());
-    for (size_t k = 0; k < vin.size(); k++)
-    {
-        v(k) = std::round(vin(k));
-    }
-
-    return v;
-}
-
 template <typename T> T max(const Vector<T>& vin)
 {
     assert(vin.size() > 0);
-    T max_val = vin(0);
-    for (size_t k = 1; k < vin.size(); k++)
-    {
-        max_val = std::max(vin(k), max_val);
-    }
-
-    return max_val;
-}
-
-template <typename T> Vector<T> abs(const Vector<T>& vin)
-{
-    assert(vin.size() > 0);
-    Vector<T> vout(vin.size());
-
-    for (size_t k = 0; k < vin.size(); k++)
-    {
-        vout(k) = std::fabs(vin(k));
-    }
-
-    return vout;
+    return internal::maxOfArray(vin.getDataPointer(), vin.size());
 }
 
 template <typename T> T maxAbs(const Vector<T>& vin)
 {
     assert(vin.size() > 0);
-    T max_val = std::fabs(vin(0));
-    for (size_t k = 1; k < vin.size(); k++)
-    {
-        max_val = std::max(std::fabs(vin(k)), max_val);
-    }
-
-    return max_val;
+    return internal::maxAbsOfArray(vin.getDataPointer(), vin.size());
 }
 
 template <typename T> T minAbs(const Vector<T>& vin)
 {
     assert(vin.size() > 0);
-    T min_val = std::fabs(vin(0));
-    for (size_t k = 1; k < vin.size(); k++)
-    {
-        min_val = std::min(std::fabs(vin(k)), min_val);
-    }
-
-    return min_val;
+    return internal::minAbsOfArray(vin.getDataPointer(), vin.size());
 }
 
 template <typename T> T min(const Vector<T>& vin)
 {
     assert(vin.size() > 0);
-    T min_val = vin(0);
-    for (size_t k = 1; k < vin.size(); k++)
-    {
-        min_val = std::min(vin(k), min_val);
-    }
-
-    return min_val;
-}
-
-template <typename T> Vector<T> log10(const Vector<T>& vin)
-{
-    assert(vin.size() > 0);
-    Vector<T> v(vin.size());
-    for (size_t k = 0; k < vin.size(); k++)
-    {
-        v(k) = std::log10(vin(k));
-    }
-
-    return v;
-}
-
-template <typename T> Vector<T> pow(const Vector<T>& vin, const T e)
-{
-    assert(vin.size() > 0);
-    Vector<T> v(vin.size());
-    for (size_t k = 0; k < vin.size(); k++)
-    {
-        v(k) = std::pow(vin(k), e);
-    }
-
-    return v;
-}
-
-template <typename T> Vector<T> log(const Vector<T>& vin)
-{
-    assert(vin.size() > 0);
-    Vector<T> v(vin.size());
-    for (size_t k = 0; k < vin.size(); k++)
-    {
-        v(k) = std::log(vin(k));
-    }
-
-    return v;
-}
-
-template <typename T> Vector<T> exp(const Vector<T>& vin)
-{
-    assert(vin.size() > 0);
-    Vector<T> v(vin.size());
-    for (size_t k = 0; k < vin.size(); k++)
-    {
-        v(k) = std::exp(vin(k));
-    }
-
-    return v;
-}
-
-template <typename T> Vector<T> cos(const Vector<T>& vin)
-{
-    assert(vin.size() > 0);
-    Vector<T> v(vin.size());
-    for (size_t k = 0; k < vin.size(); k++)
-    {
-        v(k) = std::cos(vin(k));
-    }
-
-    return v;
-}
-
-template <typename T> Vector<T> sin(const Vector<T>& vin)
-{
-    assert(vin.size() > 0);
-    Vector<T> v(vin.size());
-    for (size_t k = 0; k < vin.size(); k++)
-    {
-        v(k) = std::sin(vin(k));
-    }
-
-    return v;
+    return internal::minOfArray(vin.getDataPointer(), vin.size());
 }
 
 template <typename T>
-Vector<T> linspaceFromPointsAndCount(const T x0, const T x1, const size_t num_values)
+Vector<T> linspaceFromPointIncAndCount(const T x0, const T dx, const size_t num_values)
 {
     assert(num_values > 0);
     Vector<T> v(num_values);
+    T* const data = v.getDataPointer();
 
-    const T dx = (x1 - x0) / static_cast<T>(num_values - 1);
-    v(0) = x0;
-
-    for (size_t k = 1; k < num_values; k++)
-    {
-        v(k) = v(k - 1) + dx;
-    }
+    // Each element computed from x0 directly, so that ranges can be filled independently
+    data[0] = x0;
+    internal::parallelFor(
+        num_values, 1, num_values, [data, x0, dx](const size_t begin, const size_t end) {
+            for (size_t k = std::max<size_t>(begin, 1); k < end; k++)
+            {
+                data[k] = x0 + static_cast<T>(k) * dx;
+            }
+        });
 
     return v;
 }
 
 template <typename T>
-Vector<T> linspaceFromPointIncAndCount(const T x0, const T dx, const size_t num_values)
+Vector<T> linspaceFromPointsAndCount(const T x0, const T x1, const size_t num_values)
 {
     assert(num_values > 0);
-    Vector<T> v(num_values);
-
-    v(0) = x0;
-
-    for (size_t k = 1; k < num_values; k++)
-    {
-        v(k) = v(k - 1) + dx;
-    }
+    const T dx = (x1 - x0) / static_cast<T>(num_values - 1);
 
-    return v;
+    return linspaceFromPointIncAndCount(x0, dx, num_values);
 }
 
 template <typename T> Vector<T> linspaceFromPointsAndInc(const T x0, const T x1, const T dx)
@@ -259,14 +139,7 @@ template <typename T> Vector<T> linspaceFromPointsAndInc(const T x0, const T x1,
 template <typename T> T sum(const Vector<T>& vin)
 {
     assert(vin.size() > 0);
-
-    T s = vin(0);
-    for (size_t k = 1; k < vin.size(); k++)
-    {
-        s = s + vin(k);
-    }
-
-    return s;
+    return internal::sumOfArray(vin.getDataPointer(), vin.size());
 }
 
 template <typename T> T mean(const Vector<T>& vin)
@@ -331,80 +204,32 @@ template <typename T> Vector<T> uniformRandomInt(const size_t num_elements, cons
     return vout;
 }
 
+// Fisher-Yates shuffle of 0...num_elements - 1, seeded from rand()
 inline Vector<size_t> randomPermutation(const size_t num_elements)
 {
     Vector<size_t> v_numbers(num_elements);
-    Vector<float> v_rand = uniformRandom<float>(num_elements);
-
     for (size_t k = 0; k < num_elements; k++)
     {
         v_numbers(k) = k;
     }
 
-    bool done = false;
-
-    while (!done)
+    internal::RandomNumberGenerator rng;
+    for (size_t k = num_elements; k > 1; k--)
     {
-        bool did_swap = false;
-        for (size_t k = 0; k < num_elements - 1; k++)
-        {
-            if (v_rand(k) > v_rand(k + 1))
-            {
-                const float temp = v_rand(k);
-                v_rand(k) = v_rand(k + 1);
-                v_rand(k + 1) = temp;
-
-                const size_t temp_i = v_numbers(k);
-                v_numbers(k) = v_numbers(k + 1);
-                v_numbers(k + 1) = temp_i;
-
-                did_swap = true;
-            }
-        }
-        if (!did_swap)
-        {
-            done = true;
-        }
+        std::swap(v_numbers(k - 1), v_numbers(rng.nextBelow(k)));
     }
 
     return v_numbers;
 }
 
+// Indices that sort vin in ascending order, equal values keep their order
 template <typename T> Vector<size_t> sortedIndices(const Vector<T>& vin)
 {
     Vector<size_t> v_indices(vin.size());
     Vector<T> v_temp(vin);
 
-    for (size_t k = 0; k < vin.size(); k++)
-    {
-        v_indices(k) = k;
-    }
-
-    bool done = false;
-
-    while (!done)
-    {
-        bool did_swap = false;
-        for (size_t k = 0; k < vin.size() - 1; k++)
-        {
-            if (v_temp(k) > v_temp(k + 1))
-            {
-                const T temp = v_temp(k);
-                v_temp(k) = v_temp(k + 1);
-                v_temp(k + 1) = temp;
-
-                const size_t temp_i = v_indices(k);
-                v_indices(k) = v_indices(k + 1);
-                v_indices(k + 1) = temp_i;
-
-                did_swap = true;
-            }
-        }
-        if (!did_swap)
-        {
-            done = true;
-        }
-    }
+    internal::sortArrayWithIndices(
+        v_temp.getDataPointer(), v_indices.getDataPointer(), vin.size());
 
     return v_indices;
 }
@@ -415,38 +240,10 @@ std::pair<Vector<T>, Vector<size_t>> sortValuesAndIndices(const Vector<T>& vin)
     Vector<size_t> v_indices(vin.size());
     Vector<T> v_values(vin);
 
-    for (size_t k = 0; k < vin.size(); k++)
-    {
-        v_indices(k) = k;
-    }
-
-    bool done = false;
-
-    while (!done)
-    {
-        bool did_swap = false;
-        for (size_t k = 0; k < vin.size() - 1; k++)
-        {
-            if (v_values(k) > v_values(k + 1))
-            {
-                const T temp = v_values(k);
-                v_values(k) = v_values(k + 1);
-                v_values(k + 1) = temp;
-
-                const size_t temp_i = v_indices(k);
-                v_indices(k) = v_indices(k + 1);
-                v_indices(k + 1) = temp_i;
-
-                did_swap = true;
-            }
-        }
-        if (!did_swap)
-        {
-            done = true;
-        }
-    }
+    internal::sortArrayWithIndices(
+        v_values.getDataPointer(), v_indices.getDataPointer(), vin.size());
 
-    return std::pair<Vector<T>, Vector<size_t>>(v_values, v_indices);
+    return std::pair<Vector<T>, Vector<size_t>>(std::move(v_values), std::move(v_indices));
 }
 
 template <typename Y, typename T> Vector<Y> roundAndCast(const Vector<T>& vin)
@@ -5,17 +5,29 @@
 
 namespace plot_tool
 {
+// Vector with the size as a template parameter only, stored on the stack. Copies are
+// trivial, and the loops over the elements have compile time bounds that the compiler unrolls.
 template <size_t N, typename T> class VectorFixed
 {
 private:
+    static_assert(N > 0, "Vector size can't be 0!");
+
     T data_[N];
-    const size_t vector_length_;
 
 public:
-    VectorFixed();
-    VectorFixed(const VectorFixed<N, T>& vf);
+    VectorFixed() = default;
+    VectorFixed(const std::initializer_list<T>& il);
+
+    static constexpr size_t size()
+    {
+        return N;
+    }
+
+    static constexpr size_t numElements()
+    {
+        return N;
+    }
 
-    size_t size() const;
     void fill(const T& val);
 
     T& operator()(const size_t idx);
@@ -26,59 +38,64 @@ public:
     size_t endIndex() const;
     size_t countNumNonZeroElements() const;
 
-    T* getDataPointer() const;
+    T* getDataPointer();
+    const T* getDataPointer() const;
 
-    // MatrixFixed<N, N, T> outerProduct(const VectorFixed<N, T>& v) const;
     MatrixFixed<1, N, T> toRowVectorMat() const;
     MatrixFixed<N, 1, T> toColVectorMat() const;
 };
 
-template <size_t N, typename T> VectorFixed<N, T>::VectorFixed() : vector_length_(N) {}
-
 template <size_t N, typename T>
-VectorFixed<N, T>::VectorFixed(const VectorFixed<N, T>& vf) : vector_length_(N)
+VectorFixed<N, T>::VectorFixed(const std::initializer_list<T>& il)
 {
+    PT_ASSERT(il.size() == N) << "Incorrect number of elements for templated vector size!";
+
     for (size_t k = 0; k < N; k++)
     {
-        data_[k] = vf(k);
+        data_[k] = il.begin()[k];
     }
 }
 
-template <size_t N, typename T> T* VectorFixed<N, T>::getDataPointer() const
+template <size_t N, typename T> T* VectorFixed<N, T>::getDataPointer()
+{
+    return data_;
+}
+
+template <size_t N, typename T> const T* VectorFixed<N, T>::getDataPointer() const
 {
     return data_;
 }
 
 template <size_t N, typename T> T& VectorFixed<N, T>::operator()(const size_t idx)
 {
-    assert(idx < vector_length_);
+    assert(idx < N);
     return data_[idx];
 }
 
 template <size_t N, typename T> const T& VectorFixed<N, T>::operator()(const size_t idx) const
 {
-    assert(idx < vector_length_);
+    assert(idx < N);
     return data_[idx];
 }
 
 template <size_t N, typename T> T& VectorFixed<N, T>::operator()(const EndIndex& end_idx)
 {
-    const size_t idx = static_cast<size_t>(static_cast<int>(vector_length_) - 1 + end_idx.offset);
-    assert(idx < vector_length_);
+    const size_t idx = static_cast<size_t>(static_cast<int>(N) - 1 + end_idx.offset);
+    assert(idx < N);
     return data_[idx];
 }
 
 template <size_t N, typename T>
 const T& VectorFixed<N, T>::operator()(const EndIndex& end_idx) const
 {
-    const size_t idx = static_cast<size_t>(static_cast<int>(vector_length_) - 1 + end_idx.offset);
-    assert(idx < vector_length_);
+    const size_t idx = static_cast<size_t>(static_cast<int>(N) - 1 + end_idx.offset);
+    assert(idx < N);
     return data_[idx];
 }
 
 template <size_t N, typename T> void VectorFixed<N, T>::fill(const T& val)
 {
-    for (size_t k = 0; k < vector_length_; k++)
+    for (size_t k = 0; k < N; k++)
     {
         data_[k] = val;
     }
@@ -87,7 +104,7 @@ template <size_t N, typename T> void VectorFixed<N, T>::fill(const T& val)
 template <size_t N, typename T> size_t VectorFixed<N, T>::countNumNonZeroElements() const
 {
     size_t cnt = 0;
-    for (size_t k = 0; k < vector_length_; k++)
+    for (size_t k = 0; k < N; k++)
     {
         if (data_[k])
         {
@@ -99,7 +116,7 @@ template <size_t N, typename T> size_t VectorFixed<N, T>::countNumNonZeroElement
 
 template <size_t N, typename T> size_t VectorFixed<N, T>::endIndex() const
 {
-    return vector_length_ - 1;
+    return N - 1;
 }
 
 template <size_t N, typename T>
@@ -123,7 +140,6 @@ std::ostream& operator<<(std::ostream& os, const VectorFixed<N, T>& v)
 template <size_t N, typename T>
 T operator*(const VectorFixed<N, T>& v0, const VectorFixed<N, T>& v1)
 {
-    assert(v0.size() == v1.size());
     T d = 0.0;
     for (size_t k = 0; k < v0.size(); k++)
     {
@@ -134,7 +150,7 @@ T operator*(const VectorFixed<N, T>& v0, const VectorFixed<N, T>& v1)
 
 template <size_t N, typename T> VectorFixed<N, T> operator*(const T& f, const VectorFixed<N, T>& v)
 {
-    VectorFixed<N, T> v_res(v.size());
+    VectorFixed<N, T> v_res;
     for (size_t k = 0; k < v.size(); k++)
     {
         v_res(k) = f * v(k);
@@ -144,7 +160,7 @@ template <size_t N, typename T> VectorFixed<N, T> operator*(const T& f, const Ve
 
 template <size_t N, typename T> VectorFixed<N, T> operator*(const VectorFixed<N, T>& v, const T& f)
 {
-    VectorFixed<N, T> v_res(v.size());
+    VectorFixed<N, T> v_res;
     for (size_t k = 0; k < v.size(); k++)
     {
         v_res(k) = f * v(k);
@@ -154,7 +170,7 @@ template <size_t N, typename T> VectorFixed<N, T> operator*(const VectorFixed<N,
 
 template <size_t N, typename T> VectorFixed<N, T> operator/(const VectorFixed<N, T>& v, const T& f)
 {
-    VectorFixed<N, T> v_res(v.size());
+    VectorFixed<N, T> v_res;
     for (size_t k = 0; k < v.size(); k++)
     {
         v_res(k) = v(k) / f;
@@ -164,7 +180,7 @@ template <size_t N, typename T> VectorFixed<N, T> operator/(const VectorFixed<N,
 
 template <size_t N, typename T> VectorFixed<N, T> operator/(const T& f, const VectorFixed<N, T>& v)
 {
-    VectorFixed<N, T> v_res(v.size());
+    VectorFixed<N, T> v_res;
     for (size_t k = 0; k < v.size(); k++)
     {
         v_res(k) = f / v(k);
@@ -174,7 +190,7 @@ template <size_t N, typename T> VectorFixed<N, T> operator/(const T& f, const Ve
 
 template <size_t N, typename T> VectorFixed<N, T> operator+(const VectorFixed<N, T>& v, const T& f)
 {
-    VectorFixed<N, T> v_res(v.size());
+    VectorFixed<N, T> v_res;
     for (size_t k = 0; k < v.size(); k++)
     {
         v_res(k) = v(k) + f;
@@ -184,7 +200,7 @@ template <size_t N, typename T> VectorFixed<N, T> operator+(const VectorFixed<N,
 
 template <size_t N, typename T> VectorFixed<N, T> operator+(const T& f, const VectorFixed<N, T>& v)
 {
-    VectorFixed<N, T> v_res(v.size());
+    VectorFixed<N, T> v_res;
     for (size_t k = 0; k < v.size(); k++)
     {
         v_res(k) = v(k) + f;
@@ -194,7 +210,7 @@ template <size_t N, typename T> VectorFixed<N, T> operator+(const T& f, const Ve
 
 template <size_t N, typename T> VectorFixed<N, T> operator-(const VectorFixed<N, T>& v, const T& f)
 {
-    VectorFixed<N, T> v_res(v.size());
+    VectorFixed<N, T> v_res;
     for (size_t k = 0; k < v.size(); k++)
     {
         v_res(k) = v(k) - f;
@@ -204,7 +220,7 @@ template <size_t N, typename T> VectorFixed<N, T> operator-(const VectorFixed<N,
 
 template <size_t N, typename T> VectorFixed<N, T> operator-(const T& f, const VectorFixed<N, T>& v)
 {
-    VectorFixed<N, T> v_res(v.size());
+    VectorFixed<N, T> v_res;
     for (size_t k = 0; k < v.size(); k++)
     {
         v_res(k) = f - v(k);
@@ -214,7 +230,7 @@ template <size_t N, typename T> VectorFixed<N, T> operator-(const T& f, const Ve
 
 template <size_t N, typename T> VectorFixed<N, T> operator-(const VectorFixed<N, T>& v)
 {
-    VectorFixed<N, T> v_res(v.size());
+    VectorFixed<N, T> v_res;
     for (size_t k = 0; k < v.size(); k++)
     {
         v_res(k) = -v(k);
@@ -225,8 +241,7 @@ template <size_t N, typename T> VectorFixed<N, T> operator-(const VectorFixed<N,
 template <size_t N, typename T>
 VectorFixed<N, T> operator+(const VectorFixed<N, T>& v0, const VectorFixed<N, T>& v1)
 {
-    assert(v0.size() == v1.size());
-    VectorFixed<N, T> v_res(v0.size());
+    VectorFixed<N, T> v_res;
     for (size_t k = 0; k < v0.size(); k++)
     {
         v_res(k) = v0(k) + v1(k);
@@ -237,8 +252,7 @@ VectorFixed<N, T> operator+(const VectorFixed<N, T>& v0, const VectorFixed<N, T>
 template <size_t N, typename T>
 VectorFixed<N, T> operator-(const VectorFixed<N, T>& v0, const VectorFixed<N, T>& v1)
 {
-    assert(v0.size() == v1.size());
-    VectorFixed<N, T> v_res(v0.size());
+    VectorFixed<N, T> v_res;
     for (size_t k = 0; k < v0.size(); k++)
     {
         v_res(k) = v0(k) - v1(k);
@@ -249,8 +263,7 @@ VectorFixed<N, T> operator-(const VectorFixed<N, T>& v0, const VectorFixed<N, T>
 template <size_t N, typename T>
 VectorFixed<N, bool> operator==(const VectorFixed<N, T>& v0, const VectorFixed<N, T>& v1)
 {
-    assert(v0.size() == v1.size());
-    VectorFixed<N, bool> v_res(v0.size());
+    VectorFixed<N, bool> v_res;
     for (size_t k = 0; k < v0.size(); k++)
     {
         v_res(k) = v0(k) == v1(k);
@@ -261,7 +274,7 @@ VectorFixed<N, bool> operator==(const VectorFixed<N, T>& v0, const VectorFixed<N
 template <size_t N, typename T>
 VectorFixed<N, bool> operator==(const VectorFixed<N, T>& v, const T& s)
 {
-    VectorFixed<N, bool> v_res(v.size());
+    VectorFixed<N, bool> v_res;
     for (size_t k = 0; k < v.size(); k++)
     {
         v_res(k) = v(k) == s;
@@ -272,7 +285,7 @@ VectorFixed<N, bool> operator==(const VectorFixed<N, T>& v, const T& s)
 template <size_t N, typename T>
 VectorFixed<N, bool> operator==(const T& s, const VectorFixed<N, T>& v)
 {
-    VectorFixed<N, bool> v_res(v.size());
+    VectorFixed<N, bool> v_res;
     for (size_t k = 0; k < v.size(); k++)
     {
         v_res(k) = v(k) == s;
@@ -283,8 +296,7 @@ VectorFixed<N, bool> operator==(const T& s, const VectorFixed<N, T>& v)
 template <size_t N, typename T>
 VectorFixed<N, bool> operator!=(const VectorFixed<N, T>& v0, const VectorFixed<N, T>& v1)
 {
-    assert(v0.size() == v1.size());
-    VectorFixed<N, bool> v_res(v0.size());
+    VectorFixed<N, bool> v_res;
     for (size_t k = 0; k < v0.size(); k++)
     {
         v_res(k) = v0(k) != v1(k);
@@ -295,7 +307,7 @@ VectorFixed<N, bool> operator!=(const VectorFixed<N, T>& v0, const VectorFixed<N
 template <size_t N, typename T>
 VectorFixed<N, bool> operator!=(const VectorFixed<N, T>& v, const T& s)
 {
-    VectorFixed<N, bool> v_res(v.size());
+    VectorFixed<N, bool> v_res;
     for (size_t k = 0; k < v.size(); k++)
     {
         v_res(k) = v(k) != s;
@@ -306,7 +318,7 @@ VectorFixed<N, bool> operator!=(const VectorFixed<N, T>& v, const T& s)
 template <size_t N, typename T>
 VectorFixed<N, bool> operator!=(const T& s, const VectorFixed<N, T>& v)
 {
-    VectorFixed<N, bool> v_res(v.size());
+    VectorFixed<N, bool> v_res;
     for (size_t k = 0; k < v.size(); k++)
     {
         v_res(k) = v(k) != s;
@@ -317,8 +329,7 @@ VectorFixed<N, bool> operator!=(const T& s, const VectorFixed<N, T>& v)
 template <size_t N, typename T>
 VectorFixed<N, bool> operator<(const VectorFixed<N, T>& v0, const VectorFixed<N, T>& v1)
 {
-    assert(v0.size() == v1.size());
-    VectorFixed<N, bool> v_res(v0.size());
+    VectorFixed<N, bool> v_res;
     for (size_t k = 0; k < v0.size(); k++)
     {
         v_res(k) = v0(k) < v1(k);
@@ -329,7 +340,7 @@ VectorFixed<N, bool> operator<(const VectorFixed<N, T>& v0, const VectorFixed<N,
 template <size_t N, typename T>
 VectorFixed<N, bool> operator<(const VectorFixed<N, T>& v, const T& s)
 {
-    VectorFixed<N, bool> v_res(v.size());
+    VectorFixed<N, bool> v_res;
     for (size_t k = 0; k < v.size(); k++)
     {
         v_res(k) = v(k) < s;
@@ -340,7 +351,7 @@ VectorFixed<N, bool> operator<(const VectorFixed<N, T>& v, const T& s)
 template <size_t N, typename T>
 VectorFixed<N, bool> operator<(const T& s, const VectorFixed<N, T>& v)
 {
-    VectorFixed<N, bool> v_res(v.size());
+    VectorFixed<N, bool> v_res;
     for (size_t k = 0; k < v.size(); k++)
     {
         v_res(k) = s < v(k);
@@ -351,8 +362,7 @@ VectorFixed<N, bool> operator<(const T& s, const VectorFixed<N, T>& v)
 template <size_t N, typename T>
 VectorFixed<N, bool> operator>(const VectorFixed<N, T>& v0, const VectorFixed<N, T>& v1)
 {
-    assert(v0.size() == v1.size());
-    VectorFixed<N, bool> v_res(v0.size());
+    VectorFixed<N, bool> v_res;
     for (size_t k = 0; k < v0.size(); k++)
     {
         v_res(k) = v0(k) > v1(k);
@@ -363,7 +373,7 @@ VectorFixed<N, bool> operator>(const VectorFixed<N, T>& v0, const VectorFixed<N,
 template <size_t N, typename T>
 VectorFixed<N, bool> operator>(const VectorFixed<N, T>& v, const T& s)
 {
-    VectorFixed<N, bool> v_res(v.size());
+    VectorFixed<N, bool> v_res;
     for (size_t k = 0; k < v.size(); k++)
     {
         v_res(k) = v(k) > s;
@@ -374,7 +384,7 @@ VectorFixed<N, bool> operator>(const VectorFixed<N, T>& v, const T& s)
 template <size_t N, typename T>
 VectorFixed<N, bool> operator>(const T& s, const VectorFixed<N, T>& v)
 {
-    VectorFixed<N, bool> v_res(v.size());
+    VectorFixed<N, bool> v_res;
     for (size_t k = 0; k < v.size(); k++)
     {
         v_res(k) = s > v(k);
@@ -385,8 +395,7 @@ VectorFixed<N, bool> operator>(const T& s, const VectorFixed<N, T>& v)
 template <size_t N, typename T>
 VectorFixed<N, bool> operator<=(const VectorFixed<N, T>& v0, const VectorFixed<N, T>& v1)
 {
-    assert(v0.size() == v1.size());
-    VectorFixed<N, bool> v_res(v0.size());
+    VectorFixed<N, bool> v_res;
     for (size_t k = 0; k < v0.size(); k++)
     {
         v_res(k) = v0(k) <= v1(k);
@@ -397,7 +406,7 @@ VectorFixed<N, bool> operator<=(const VectorFixed<N, T>& v0, const VectorFixed<N
 template <size_t N, typename T>
 VectorFixed<N, bool> operator<=(const VectorFixed<N, T>& v, const T& s)
 {
-    VectorFixed<N, bool> v_res(v.size());
+    VectorFixed<N, bool> v_res;
     for (size_t k = 0; k < v.size(); k++)
     {
         v_res(k) = v(k) <= s;
@@ -408,7 +417,7 @@ VectorFixed<N, bool> operator<=(const VectorFixed<N, T>& v, const T& s)
 template <size_t N, typename T>
 VectorFixed<N, bool> operator<=(const T& s, const VectorFixed<N, T>& v)
 {
-    VectorFixed<N, bool> v_res(v.size());
+    VectorFixed<N, bool> v_res;
     for (size_t k = 0; k < v.size(); k++)
     {
         v_res(k) = s <= v(k);
@@ -419,8 +428,7 @@ VectorFixed<N, bool> operator<=(const T& s, const VectorFixed<N, T>& v)
 template <size_t N, typename T>
 VectorFixed<N, bool> operator>=(const VectorFixed<N, T>& v0, const VectorFixed<N, T>& v1)
 {
-    assert(v0.size() == v1.size());
-    VectorFixed<N, bool> v_res(v0.size());
+    VectorFixed<N, bool> v_res;
     for (size_t k = 0; k < v0.size(); k++)
     {
         v_res(k) = v0(k) >= v1(k);
@@ -431,7 +439,7 @@ VectorFixed<N, bool> operator>=(const VectorFixed<N, T>& v0, const VectorFixed<N
 template <size_t N, typename T>
 VectorFixed<N, bool> operator>=(const VectorFixed<N, T>& v, const T& s)
 {
-    VectorFixed<N, bool> v_res(v.size());
+    VectorFixed<N, bool> v_res;
     for (size_t k = 0; k < v.size(); k++)
     {
         v_res(k) = v(k) >= s;
@@ -442,7 +450,7 @@ VectorFixed<N, bool> operator>=(const VectorFixed<N, T>& v, const T& s)
 template <size_t N, typename T>
 VectorFixed<N, bool> operator>=(const T& s, const VectorFixed<N, T>& v)
 {
-    VectorFixed<N, bool> v_res(v.size());
+    VectorFixed<N, bool> v_res;
     for (size_t k = 0; k < v.size(); k++)
     {
         v_res(k) = s >= v(k);
@@ -453,8 +461,7 @@ VectorFixed<N, bool> operator>=(const T& s, const VectorFixed<N, T>& v)
 template <size_t N, typename T>
 VectorFixed<N, bool> operator&&(const VectorFixed<N, T>& v0, const VectorFixed<N, T>& v1)
 {
-    assert(v0.size() == v1.size());
-    VectorFixed<N, bool> v_res(v0.size());
+    VectorFixed<N, bool> v_res;
     for (size_t k = 0; k < v0.size(); k++)
     {
         v_res(k) = v0(k) && v1(k);
@@ -465,7 +472,7 @@ VectorFixed<N, bool> operator&&(const VectorFixed<N, T>& v0, const VectorFixed<N
 template <size_t N, typename T>
 VectorFixed<N, bool> operator&&(const VectorFixed<N, T>& v, const T& s)
 {
-    VectorFixed<N, bool> v_res(v.size());
+    VectorFixed<N, bool> v_res;
     for (size_t k = 0; k < v.size(); k++)
     {
         v_res(k) = v(k) && s;
@@ -476,7 +483,7 @@ VectorFixed<N, bool> operator&&(const VectorFixed<N, T>& v, const T& s)
 template <size_t N, typename T>
 VectorFixed<N, bool> operator&&(const T& s, const VectorFixed<N, T>& v)
 {
-    VectorFixed<N, bool> v_res(v.size());
+    VectorFixed<N, bool> v_res;
     for (size_t k = 0; k < v.size(); k++)
     {
         v_res(k) = s && v(k);
@@ -487,8 +494,7 @@ VectorFixed<N, bool> operator&&(const T& s, const VectorFixed<N, T>& v)
 template <size_t N, typename T>
 VectorFixed<N, bool> operator||(const VectorFixed<N, T>& v0, const VectorFixed<N, T>& v1)
 {
-    assert(v0.size() == v1.size());
-    VectorFixed<N, bool> v_res(v0.size());
+    VectorFixed<N, bool> v_res;
     for (size_t k = 0; k < v0.size(); k++)
     {
         v_res(k) = v0(k) || v1(k);
@@ -499,7 +505,7 @@ VectorFixed<N, bool> operator||(const VectorFixed<N, T>& v0, const VectorFixed<N
 template <size_t N, typename T>
 VectorFixed<N, bool> operator||(const VectorFixed<N, T>& v, const T& s)
 {
-    VectorFixed<N, bool> v_res(v.size());
+    VectorFixed<N, bool> v_res;
     for (size_t k = 0; k < v.size(); k++)
     {
         v_res(k) = v(k) || s;
@@ -510,7 +516,7 @@ VectorFixed<N, bool> operator||(const VectorFixed<N, T>& v, const T& s)
 template <size_t N, typename T>
 VectorFixed<N, bool> operator||(const T& s, const VectorFixed<N, T>& v)
 {
-    VectorFixed<N, bool> v_res(v.size());
+    VectorFixed<N, bool> v_res;
     for (size_t k = 0; k < v.size(); k++)
     {
         v_res(k) = s || v(k);
@@ -520,7 +526,7 @@ VectorFixed<N, bool> operator||(const T& s, const VectorFixed<N, T>& v)
 
 template <size_t N, typename T> VectorFixed<N, bool> operator!(const VectorFixed<N, T>& v)
 {
-    VectorFixed<N, bool> v_res(v.size());
+    VectorFixed<N, bool> v_res;
     for (size_t k = 0; k < v.size(); k++)
     {
         v_res(k) = !v(k);
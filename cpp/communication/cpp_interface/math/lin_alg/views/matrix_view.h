@@ -0,0 +1,152 @@
+#ifndef PLOT_TOOL_MATRIX_VIEW_H_
+#define PLOT_TOOL_MATRIX_VIEW_H_
+
+#include <cassert>
+#include <cstddef>
+
+#include "math/lin_alg/views/vector_view.h"
+#include "math/math_core.h"
+
+namespace plot_tool
+{
+// Non-owning view of a num_rows x num_cols matrix where element (r, c) is at
+// data[r * row_stride + c * col_stride]. Row major arrays have row_stride = num_cols and
+// col_stride = 1, column major arrays, e.g. the data of an Eigen matrix, have row_stride = 1
+// and col_stride = num_rows, or the outer stride. The viewed memory must outlive the view.
+template <typename T> class MatrixView
+{
+private:
+    const T* data_;
+    size_t num_rows_;
+    size_t num_cols_;
+    ptrdiff_t row_stride_;
+    ptrdiff_t col_stride_;
+
+public:
+    MatrixView() : data_(nullptr), num_rows_(0), num_cols_(0), row_stride_(0), col_stride_(1) {}
+
+    MatrixView(const T* const data,
+               const size_t num_rows,
+               const size_t num_cols,
+               const ptrdiff_t row_stride,
+               const ptrdiff_t col_stride)
+        : data_(data),
+          num_rows_(num_rows),
+          num_cols_(num_cols),
+          row_stride_(row_stride),
+          col_stride_(col_stride)
+    {
+    }
+
+    MatrixView(const T* const data, const size_t num_rows, const size_t num_cols)
+        : MatrixView(data, num_rows, num_cols, static_cast<ptrdiff_t>(num_cols), 1)
+    {
+    }
+
+    MatrixView(const Matrix<T>& m) : MatrixView(m.getDataPointer(), m.rows(), m.cols()) {}
+
+    const T& operator()(const size_t r, const size_t c) const
+    {
+        assert(r < num_rows_ && "Row index out of bounds!");
+        assert(c < num_cols_ && "Column index out of bounds!");
+        return data_[static_cast<ptrdiff_t>(r) * row_stride_ +
+                     static_cast<ptrdiff_t>(c) * col_stride_];
+    }
+
+    size_t rows() const
+    {
+        return num_rows_;
+    }
+
+    size_t cols() const
+    {
+        return num_cols_;
+    }
+
+    size_t numElements() const
+    {
+        return num_rows_ * num_cols_;
+    }
+
+    ptrdiff_t rowStride() const
+    {
+        return row_stride_;
+    }
+
+    ptrdiff_t colStride() const
+    {
+        return col_stride_;
+    }
+
+    // True if the elements are stored contiguously in row major order
+    bool isContiguous() const
+    {
+        return ((col_stride_ == 1) || (num_cols_ < 2)) &&
+               ((row_stride_ == static_cast<ptrdiff_t>(num_cols_)) || (num_rows_ < 2));
+    }
+
+    const T* getDataPointer() const
+    {
+        return data_;
+    }
+
+    VectorView<T> row(const size_t r) const
+    {
+        assert(r < num_rows_ && "Row index out of bounds!");
+        return VectorView<T>(
+            data_ + static_cast<ptrdiff_t>(r) * row_stride_, num_cols_, col_stride_);
+    }
+
+    VectorView<T> col(const size_t c) const
+    {
+        assert(c < num_cols_ && "Column index out of bounds!");
+        return VectorView<T>(
+            data_ + static_cast<ptrdiff_t>(c) * col_stride_, num_rows_, row_stride_);
+    }
+
+    // Copies the elements [begin, end) in row major order to dst, converted to Y
+    template <typename Y> void copyTo(Y* const dst, const size_t begin, const size_t end) const
+    {
+        size_t k = begin;
+        while (k < end)
+        {
+            const size_t r = k / num_cols_;
+            const size_t c0 = k % num_cols_;
+            const size_t c1 = (end - k < num_cols_ - c0) ? c0 + (end - k) : num_cols_;
+
+            row(r).copyTo(dst + (k - begin), c0, c1);
+            k += c1 - c0;
+        }
+    }
+
+    Matrix<T> toMatrix() const
+    {
+        Matrix<T> m(num_rows_, num_cols_);
+        copyTo(m.getDataPointer(), 0, numElements());
+        return m;
+    }
+};
+
+template <typename T>
+MatrixView<T> makeMatrixView(const T* const data, const size_t num_rows, const size_t num_cols)
+{
+    return MatrixView<T>(data, num_rows, num_cols);
+}
+
+template <typename T>
+MatrixView<T> makeMatrixView(const T* const data,
+                             const size_t num_rows,
+                             const size_t num_cols,
+                             const ptrdiff_t row_stride,
+                             const ptrdiff_t col_stride)
+{
+    return MatrixView<T>(data, num_rows, num_cols, row_stride, col_stride);
+}
+
+template <typename T> MatrixView<T> makeMatrixView(const Matrix<T>& m)
+{
+    return MatrixView<T>(m);
+}
+}  // namespace plot_tool
+
+#endif
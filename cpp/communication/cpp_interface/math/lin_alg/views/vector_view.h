@@ -0,0 +1,108 @@
+#ifndef PLOT_TOOL_VECTOR_VIEW_H_
+#define PLOT_TOOL_VECTOR_VIEW_H_
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+#include "math/math_core.h"
+
+namespace plot_tool
+{
+// Non-owning view of num_elements elements that are stride elements apart, e.g. one channel
+// of interleaved samples or one column of a row major array. The viewed memory must outlive
+// the view and is never copied by it.
+template <typename T> class VectorView
+{
+private:
+    const T* data_;
+    size_t num_elements_;
+    ptrdiff_t stride_;
+
+public:
+    VectorView() : data_(nullptr), num_elements_(0), stride_(1) {}
+
+    VectorView(const T* const data, const size_t num_elements, const ptrdiff_t stride = 1)
+        : data_(data), num_elements_(num_elements), stride_(stride)
+    {
+    }
+
+    VectorView(const std::vector<T>& v) : data_(v.data()), num_elements_(v.size()), stride_(1)
+    {
+    }
+
+    VectorView(const Vector<T>& v)
+        : data_(v.getDataPointer()), num_elements_(v.size()), stride_(1)
+    {
+    }
+
+    const T& operator()(const size_t idx) const
+    {
+        assert(idx < num_elements_ && "Index out of bounds!");
+        return data_[static_cast<ptrdiff_t>(idx) * stride_];
+    }
+
+    size_t size() const
+    {
+        return num_elements_;
+    }
+
+    size_t numElements() const
+    {
+        return num_elements_;
+    }
+
+    ptrdiff_t stride() const
+    {
+        return stride_;
+    }
+
+    bool isContiguous() const
+    {
+        return (stride_ == 1) || (num_elements_ < 2);
+    }
+
+    const T* getDataPointer() const
+    {
+        return data_;
+    }
+
+    // Copies the elements [begin, end) to dst, converted to Y
+    template <typename Y> void copyTo(Y* const dst, const size_t begin, const size_t end) const
+    {
+        const T* src = data_ + static_cast<ptrdiff_t>(begin) * stride_;
+        for (size_t k = begin; k < end; k++)
+        {
+            dst[k - begin] = static_cast<Y>(*src);
+            src += stride_;
+        }
+    }
+
+    Vector<T> toVector() const
+    {
+        Vector<T> v(num_elements_);
+        copyTo(v.getDataPointer(), 0, num_elements_);
+        return v;
+    }
+};
+
+template <typename T>
+VectorView<T> makeVectorView(const T* const data,
+                             const size_t num_elements,
+                             const ptrdiff_t stride = 1)
+{
+    return VectorView<T>(data, num_elements, stride);
+}
+
+template <typename T> VectorView<T> makeVectorView(const std::vector<T>& v)
+{
+    return VectorView<T>(v);
+}
+
+template <typename T> VectorView<T> makeVectorView(const Vector<T>& v)
+{
+    return VectorView<T>(v);
+}
+}  // namespace plot_tool
+
+#endif
@@ -4,20 +4,25 @@
 // clang-format off
 #include "math/math_core.h"
 
+#include "math/lin_alg/elementwise_expression/elementwise_expression.h"
 #include "math/lin_alg/matrix_dynamic/matrix_dynamic.h"
 #include "math/lin_alg/matrix_dynamic/matrix_math_functions.h"
 #include "math/lin_alg/matrix_vector_dynamic.h"
+#include "math/lin_alg/matrix_vector_fixed.h"
 #include "math/lin_alg/vector_dynamic/vector_dynamic.h"
 #include "math/lin_alg/vector_dynamic/vector_math_functions.h"
 #include "math/lin_alg/vector_low_dim/vec2d.h"
 #include "math/lin_alg/vector_low_dim/vec3d.h"
 #include "math/lin_alg/vector_low_dim/vec4d.h"
+#include "math/lin_alg/views/matrix_view.h"
+#include "math/lin_alg/views/vector_view.h"
 
 
 #include "math/geometry/line_3d.h"
 #include "math/geometry/plane.h"
 #include "math/misc/math_type_definitions.h"
 #include "math/transformations/axis_angle.h"
+#include "math/transformations/batch_transformations.h"
 #include "math/transformations/quaternion.h"
 #include "math/transformations/roll_pitch_yaw.h"
 // clang-format on
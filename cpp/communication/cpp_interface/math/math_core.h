@@ -12,6 +12,7 @@
 
 #include "logging.h"
 #include "math/misc/math_macros.h"
+#include "math/misc/memory_resource.h"
 
 namespace plot_tool
 {
@@ -25,6 +26,9 @@ template <typename T> struct VecYZ;
 
 template <typename T> class Vector;
 template <typename T> class Matrix;
+template <size_t N, typename T> class VectorFixed;
+template <size_t R, size_t C, typename T> class MatrixFixed;
+template <typename E, typename C> class ElementwiseExpression;
 
 template <typename T> struct ComplexCoord;
 template <typename T> struct PolarCoord;
@@ -68,6 +72,7 @@ template <typename T> using PointYZ = VecYZ<T>;
 }  // namespace plot_tool
 
 // clang-format off
+#include "math/lin_alg/elementwise_expression/class_defs/elementwise_expression_class_def.h"
 #include "math/lin_alg/matrix_dynamic/class_defs/matrix_dynamic_class_def.h"
 #include "math/lin_alg/vector_dynamic/class_defs/vector_dynamic_class_def.h"
 #include "math/lin_alg/vector_low_dim/class_defs/vec2d_class_def.h"
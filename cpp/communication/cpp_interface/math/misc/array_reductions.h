@@ -0,0 +1,154 @@
+#ifndef PLOT_TOOL_ARRAY_REDUCTIONS_H_
+#define PLOT_TOOL_ARRAY_REDUCTIONS_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+#include "math/misc/thread_pool.h"
+
+// Reductions over the data of Vector and Matrix, in chunks that are reduced in parallel for
+// large arrays. The results are the same for any number of threads.
+
+namespace plot_tool
+{
+namespace internal
+{
+template <typename T> T sumOfArray(const T* const data, const size_t num_elements)
+{
+    return parallelReduce<T>(
+        num_elements,
+        [data](const size_t begin, const size_t end) {
+            T s = static_cast<T>(0);
+            for (size_t k = begin; k < end; k++)
+            {
+                s = s + data[k];
+            }
+            return s;
+        },
+        [](const T a, const T b) { return a + b; });
+}
+
+template <typename T> T minOfArray(const T* const data, const size_t num_elements)
+{
+    return parallelReduce<T>(
+        num_elements,
+        [data](const size_t begin, const size_t end) {
+            T min_val = data[begin];
+            for (size_t k = begin + 1; k < end; k++)
+            {
+                min_val = std::min(data[k], min_val);
+            }
+            return min_val;
+        },
+        [](const T a, const T b) { return std::min(b, a); });
+}
+
+template <typename T> T maxOfArray(const T* const data, const size_t num_elements)
+{
+    return parallelReduce<T>(
+        num_elements,
+        [data](const size_t begin, const size_t end) {
+            T max_val = data[begin];
+            for (size_t k = begin + 1; k < end; k++)
+            {
+                max_val = std::max(data[k], max_val);
+            }
+            return max_val;
+        },
+        [](const T a, const T b) { return std::max(b, a); });
+}
+
+template <typename T> T minAbsOfArray(const T* const data, const size_t num_elements)
+{
+    return parallelReduce<T>(
+        num_elements,
+        [data](const size_t begin, const size_t end) {
+            T min_val = std::fabs(data[begin]);
+            for (size_t k = begin + 1; k < end; k++)
+            {
+                min_val = std::min<T>(std::fabs(data[k]), min_val);
+            }
+            return min_val;
+        },
+        [](const T a, const T b) { return std::min(b, a); });
+}
+
+template <typename T> T maxAbsOfArray(const T* const data, const size_t num_elements)
+{
+    return parallelReduce<T>(
+        num_elements,
+        [data](const size_t begin, const size_t end) {
+            T max_val = std::fabs(data[begin]);
+            for (size_t k = begin + 1; k < end; k++)
+            {
+                max_val = std::max<T>(std::fabs(data[k]), max_val);
+            }
+            return max_val;
+        },
+        [](const T a, const T b) { return std::max(b, a); });
+}
+
+// res[r] = combine(...combine(combine(x[r][0], x[r][1]), x[r][2])..., x[r][num_cols - 1]) for
+// the row major num_rows x num_cols array x, with rows in parallel for large arrays. Rows
+// without elements give 0.
+template <typename T, typename F>
+void reduceAlongRows(const T* const data,
+                     const size_t num_rows,
+                     const size_t num_cols,
+                     T* const res,
+                     const F& combine)
+{
+    if (num_cols == 0)
+    {
+        std::fill(res, res + num_rows, static_cast<T>(0));
+        return;
+    }
+
+    parallelFor(num_rows, 1, num_rows * num_cols, [&](const size_t begin, const size_t end) {
+        for (size_t r = begin; r < end; r++)
+        {
+            const T* const row = data + r * num_cols;
+            T val = row[0];
+            for (size_t c = 1; c < num_cols; c++)
+            {
+                val = combine(val, row[c]);
+            }
+            res[r] = val;
+        }
+    });
+}
+
+// The same along the columns, res[c] for column c. Each thread takes a band of whole cache
+// lines of columns and goes through it row by row, so that the array is read contiguously.
+template <typename T, typename F>
+void reduceAlongCols(const T* const data,
+                     const size_t num_rows,
+                     const size_t num_cols,
+                     T* const res,
+                     const F& combine)
+{
+    if (num_rows == 0)
+    {
+        std::fill(res, res + num_cols, static_cast<T>(0));
+        return;
+    }
+
+    const size_t col_granularity = 64 / sizeof(T) > 0 ? 64 / sizeof(T) : 1;
+    parallelFor(
+        num_cols, col_granularity, num_rows * num_cols, [&](const size_t begin, const size_t end) {
+            std::copy(data + begin, data + end, res + begin);
+            for (size_t r = 1; r < num_rows; r++)
+            {
+                const T* const row = data + r * num_cols;
+                for (size_t c = begin; c < end; c++)
+                {
+                    res[c] = combine(res[c], row[c]);
+                }
+            }
+        });
+}
+}  // namespace internal
+}  // namespace plot_tool
+
+#endif
@@ -5,17 +5,6 @@
 
 namespace plot_tool
 {
-#define DATA_ALLOCATION(data, data_size, data_type, alloc_type)                                   \
-    try                                                                                           \
-    {                                                                                             \
-        data = new data_type[data_size];                                                          \
-    }                                                                                             \
-    catch (std::bad_alloc & ba)                                                                   \
-    {                                                                                             \
-        std::cerr << alloc_type << " allocation failed, bad_alloc caught: " << ba.what() << '\n'; \
-        exit(-1);                                                                                 \
-    }
-
 #define ASSERT_MAT_VALID(mat)                                \
     PT_ASSERT(mat.isAllocated()) << "Matrix not allocated!"; \
     PT_ASSERT(mat.rows() > 0) << "Number of rows is 0!";     \
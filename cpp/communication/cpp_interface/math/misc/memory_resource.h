@@ -0,0 +1,314 @@
+#ifndef PLOT_TOOL_MEMORY_RESOURCE_H_
+#define PLOT_TOOL_MEMORY_RESOURCE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+// Memory resources that Vector, Matrix and ImageC1 allocate their data from. Each object keeps
+// the resource it was constructed with, defaultMemoryResource() unless one is given to the
+// constructor, and returns its data to it. Moved-to objects take over the resource of the
+// moved-from object, copies use the default resource.
+//
+// The default is the heap with default_data_alignment byte alignment, so that the data can be
+// loaded with aligned SIMD instructions and rows don't share cache lines with other objects.
+// setDefaultMemoryResource() can change it for objects created after the call, e.g. to a
+// PoolMemoryResource for code that creates many short lived temporaries.
+
+namespace plot_tool
+{
+constexpr size_t default_data_alignment = 64;
+
+class MemoryResource
+{
+public:
+    virtual ~MemoryResource() = default;
+
+    // Returns at least num_bytes bytes aligned to alignment, a power of two, or nullptr if the
+    // memory can't be allocated
+    virtual void* allocate(const size_t num_bytes, const size_t alignment) = 0;
+    virtual void deallocate(void* const ptr) = 0;
+};
+
+// Heap memory with any alignment. The pointer returned by malloc is stored in front of the
+// aligned block.
+class AlignedMemoryResource : public MemoryResource
+{
+public:
+    void* allocate(const size_t num_bytes, const size_t alignment) override
+    {
+        const size_t header_size = sizeof(void*) + alignment - 1;
+        void* const raw_ptr = std::malloc(num_bytes + header_size);
+        if (raw_ptr == nullptr)
+        {
+            return nullptr;
+        }
+
+        const uintptr_t aligned_address =
+            (reinterpret_cast<uintptr_t>(raw_ptr) + header_size) & ~(alignment - 1);
+        void* const aligned_ptr = reinterpret_cast<void*>(aligned_address);
+        static_cast<void**>(aligned_ptr)[-1] = raw_ptr;
+
+        return aligned_ptr;
+    }
+
+    void deallocate(void* const ptr) override
+    {
+        if (ptr != nullptr)
+        {
+            std::free(static_cast<void**>(ptr)[-1]);
+        }
+    }
+};
+
+inline MemoryResource* alignedMemoryResource()
+{
+    static AlignedMemoryResource aligned_memory_resource;
+    return &aligned_memory_resource;
+}
+
+// Keeps deallocated blocks in free lists, one per power of two size class, and hands them out
+// again for later allocations of the same class, so that temporaries that are created and
+// destroyed in a loop don't go to the upstream resource every time. Blocks larger than
+// max_pooled_block_size bytes, or with larger alignment than default_data_alignment, are not
+// pooled. Thread safe.
+class PoolMemoryResource : public MemoryResource
+{
+private:
+    // Stored just in front of each block
+    struct BlockHeader
+    {
+        void* raw_ptr;
+        size_t size_class;
+    };
+
+    static constexpr size_t min_block_size = 64;
+    static constexpr size_t header_size = default_data_alignment;
+    static constexpr size_t not_pooled = static_cast<size_t>(-1);
+
+    static_assert(sizeof(BlockHeader) <= header_size, "Block header doesn't fit");
+
+    MemoryResource* const upstream_;
+    const size_t max_pooled_block_size_;
+    std::vector<std::vector<void*>> free_lists_;
+    std::mutex mutex_;
+
+    static size_t blockSize(const size_t size_class)
+    {
+        return min_block_size << size_class;
+    }
+
+    static BlockHeader& header(void* const ptr)
+    {
+        return *reinterpret_cast<BlockHeader*>(static_cast<char*>(ptr) - header_size);
+    }
+
+    void* allocateFromUpstream(const size_t num_bytes,
+                               const size_t alignment,
+                               const size_t size_class)
+    {
+        const size_t block_header_size = alignment > header_size ? alignment : header_size;
+        char* const raw_ptr =
+            static_cast<char*>(upstream_->allocate(num_bytes + block_header_size, alignment));
+        if (raw_ptr == nullptr)
+        {
+            return nullptr;
+        }
+
+        void* const ptr = raw_ptr + block_header_size;
+        header(ptr).raw_ptr = raw_ptr;
+        header(ptr).size_class = size_class;
+        return ptr;
+    }
+
+public:
+    explicit PoolMemoryResource(MemoryResource* const upstream = alignedMemoryResource(),
+                                const size_t max_pooled_block_size = size_t(1) << 26)
+        : upstream_(upstream), max_pooled_block_size_(max_pooled_block_size)
+    {
+    }
+
+    PoolMemoryResource(const PoolMemoryResource&) = delete;
+    PoolMemoryResource& operator=(const PoolMemoryResource&) = delete;
+
+    ~PoolMemoryResource() override
+    {
+        release();
+    }
+
+    void* allocate(const size_t num_bytes, const size_t alignment) override
+    {
+        if ((num_bytes > max_pooled_block_size_) || (alignment > default_data_alignment))
+        {
+            return allocateFromUpstream(num_bytes, alignment, not_pooled);
+        }
+
+        size_t size_class = 0;
+        while (blockSize(size_class) < num_bytes)
+        {
+            size_class++;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if ((size_class < free_lists_.size()) && !free_lists_[size_class].empty())
+            {
+                void* const ptr = free_lists_[size_class].back();
+                free_lists_[size_class].pop_back();
+                return ptr;
+            }
+        }
+
+        return allocateFromUpstream(blockSize(size_class), default_data_alignment, size_class);
+    }
+
+    void deallocate(void* const ptr) override
+    {
+        if (ptr == nullptr)
+        {
+            return;
+        }
+
+        const size_t size_class = header(ptr).size_class;
+        if (size_class == not_pooled)
+        {
+            upstream_->deallocate(header(ptr).raw_ptr);
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (size_class >= free_lists_.size())
+        {
+            free_lists_.resize(size_class + 1);
+        }
+        free_lists_[size_class].push_back(ptr);
+    }
+
+    // Returns the blocks in the free lists to the upstream resource
+    void release()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (std::vector<void*>& free_list : free_lists_)
+        {
+            for (void* const ptr : free_list)
+            {
+                upstream_->deallocate(header(ptr).raw_ptr);
+            }
+            free_list.clear();
+        }
+    }
+};
+
+// Hook for memory that is managed outside of the library, e.g. a shared memory segment that
+// plot data can be written to directly and handed to another process without copying. The
+// functions are called for every allocation and deallocation, and allocate_function must
+// return memory with the requested alignment, or nullptr.
+class SharedMemoryResource : public MemoryResource
+{
+public:
+    using AllocateFunction = std::function<void*(size_t num_bytes, size_t alignment)>;
+    using DeallocateFunction = std::function<void(void* ptr)>;
+
+private:
+    const AllocateFunction allocate_function_;
+    const DeallocateFunction deallocate_function_;
+
+public:
+    SharedMemoryResource(const AllocateFunction& allocate_function,
+                         const DeallocateFunction& deallocate_function)
+        : allocate_function_(allocate_function), deallocate_function_(deallocate_function)
+    {
+    }
+
+    void* allocate(const size_t num_bytes, const size_t alignment) override
+    {
+        return allocate_function_(num_bytes, alignment);
+    }
+
+    void deallocate(void* const ptr) override
+    {
+        if (ptr != nullptr)
+        {
+            deallocate_function_(ptr);
+        }
+    }
+};
+
+namespace internal
+{
+inline MemoryResource*& defaultMemoryResourcePointer()
+{
+    static MemoryResource* default_memory_resource = alignedMemoryResource();
+    return default_memory_resource;
+}
+
+// Allocates num_elements default initialized elements, exits if the allocation fails, as the
+// library has always done
+template <typename T>
+T* allocateElements(MemoryResource* const memory_resource,
+                    const size_t num_elements,
+                    const char* const alloc_type)
+{
+    void* const ptr = memory_resource->allocate(
+        num_elements * sizeof(T), std::max(default_data_alignment, alignof(T)));
+    if (ptr == nullptr)
+    {
+        std::cerr << alloc_type << " allocation failed, " << num_elements * sizeof(T)
+                  << " bytes" << '\n';
+        exit(-1);
+    }
+
+    T* const data = static_cast<T*>(ptr);
+    if (!std::is_trivially_default_constructible<T>::value)
+    {
+        for (size_t k = 0; k < num_elements; k++)
+        {
+            new (data + k) T;
+        }
+    }
+    return data;
+}
+
+template <typename T>
+void deallocateElements(MemoryResource* const memory_resource,
+                        T* const data,
+                        const size_t num_elements)
+{
+    if (data == nullptr)
+    {
+        return;
+    }
+
+    if (!std::is_trivially_destructible<T>::value)
+    {
+        for (size_t k = 0; k < num_elements; k++)
+        {
+            data[k].~T();
+        }
+    }
+    memory_resource->deallocate(data);
+}
+}  // namespace internal
+
+inline MemoryResource* defaultMemoryResource()
+{
+    return internal::defaultMemoryResourcePointer();
+}
+
+// Resource for the data of Vector, Matrix and ImageC1 objects created after the call, nullptr
+// restores alignedMemoryResource(). The resource must outlive the objects that use it.
+inline void setDefaultMemoryResource(MemoryResource* const memory_resource)
+{
+    internal::defaultMemoryResourcePointer() =
+        memory_resource != nullptr ? memory_resource : alignedMemoryResource();
+}
+}  // namespace plot_tool
+
+#endif
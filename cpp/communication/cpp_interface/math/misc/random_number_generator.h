@@ -0,0 +1,46 @@
+#ifndef PLOT_TOOL_RANDOM_NUMBER_GENERATOR_H_
+#define PLOT_TOOL_RANDOM_NUMBER_GENERATOR_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+namespace plot_tool
+{
+namespace internal
+{
+// SplitMix64, a small and fast generator with a 64 bit state that passes BigCrush. Not for
+// cryptographic use.
+class RandomNumberGenerator
+{
+private:
+    uint64_t state_;
+
+public:
+    explicit RandomNumberGenerator(const uint64_t seed) : state_(seed) {}
+
+    // Seeded from rand(), so that srand() gives reproducible sequences
+    RandomNumberGenerator()
+        : state_((static_cast<uint64_t>(std::rand()) << 32) ^ static_cast<uint64_t>(std::rand()))
+    {
+    }
+
+    uint64_t next()
+    {
+        state_ += 0x9E3779B97F4A7C15ULL;
+        uint64_t z = state_;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    // Uniform in [0, bound), bound > 0. The bias of the modulo is below bound / 2^64.
+    size_t nextBelow(const size_t bound)
+    {
+        return static_cast<size_t>(next() % static_cast<uint64_t>(bound));
+    }
+};
+}  // namespace internal
+}  // namespace plot_tool
+
+#endif
@@ -0,0 +1,343 @@
+#ifndef PLOT_TOOL_SIMD_H_
+#define PLOT_TOOL_SIMD_H_
+
+// SIMD types for the math kernels of the client library. They are only available when the
+// client is compiled with AVX2 and FMA enabled, e.g. with -mavx2 -mfma or -march=native, in
+// which case PLOT_TOOL_SIMD_AVX2 is defined. Otherwise the kernels use portable code.
+
+#if defined(__AVX2__) && defined(__FMA__)
+#define PLOT_TOOL_SIMD_AVX2
+#endif
+
+#ifdef PLOT_TOOL_SIMD_AVX2
+
+#include <immintrin.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace plot_tool
+{
+namespace internal
+{
+// Four doubles. Comparisons return masks with all bits set in the lanes where they hold.
+struct SimdDouble
+{
+    typedef double Scalar;
+    enum
+    {
+        width = 4
+    };
+
+    __m256d v;
+
+    SimdDouble() = default;
+    SimdDouble(const __m256d v_in) : v(v_in) {}
+    SimdDouble(const double s) : v(_mm256_set1_pd(s)) {}
+
+    static SimdDouble load(const double* const p)
+    {
+        return _mm256_loadu_pd(p);
+    }
+
+    void store(double* const p) const
+    {
+        _mm256_storeu_pd(p, v);
+    }
+};
+
+inline SimdDouble operator+(const SimdDouble a, const SimdDouble b)
+{
+    return _mm256_add_pd(a.v, b.v);
+}
+
+inline SimdDouble operator-(const SimdDouble a, const SimdDouble b)
+{
+    return _mm256_sub_pd(a.v, b.v);
+}
+
+inline SimdDouble operator*(const SimdDouble a, const SimdDouble b)
+{
+    return _mm256_mul_pd(a.v, b.v);
+}
+
+inline SimdDouble operator/(const SimdDouble a, const SimdDouble b)
+{
+    return _mm256_div_pd(a.v, b.v);
+}
+
+inline SimdDouble operator-(const SimdDouble a)
+{
+    return _mm256_xor_pd(a.v, _mm256_set1_pd(-0.0));
+}
+
+inline SimdDouble operator&(const SimdDouble a, const SimdDouble b)
+{
+    return _mm256_and_pd(a.v, b.v);
+}
+
+inline SimdDouble operator|(const SimdDouble a, const SimdDouble b)
+{
+    return _mm256_or_pd(a.v, b.v);
+}
+
+inline SimdDouble operator<(const SimdDouble a, const SimdDouble b)
+{
+    return _mm256_cmp_pd(a.v, b.v, _CMP_LT_OQ);
+}
+
+inline SimdDouble operator>(const SimdDouble a, const SimdDouble b)
+{
+    return _mm256_cmp_pd(a.v, b.v, _CMP_GT_OQ);
+}
+
+inline SimdDouble operator==(const SimdDouble a, const SimdDouble b)
+{
+    return _mm256_cmp_pd(a.v, b.v, _CMP_EQ_OQ);
+}
+
+// a * b + c, rounded once
+inline SimdDouble fma(const SimdDouble a, const SimdDouble b, const SimdDouble c)
+{
+    return _mm256_fmadd_pd(a.v, b.v, c.v);
+}
+
+inline SimdDouble min(const SimdDouble a, const SimdDouble b)
+{
+    return _mm256_min_pd(a.v, b.v);
+}
+
+inline SimdDouble max(const SimdDouble a, const SimdDouble b)
+{
+    return _mm256_max_pd(a.v, b.v);
+}
+
+inline SimdDouble abs(const SimdDouble a)
+{
+    return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a.v);
+}
+
+inline SimdDouble sqrt(const SimdDouble a)
+{
+    return _mm256_sqrt_pd(a.v);
+}
+
+inline SimdDouble roundToNearest(const SimdDouble a)
+{
+    return _mm256_round_pd(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+}
+
+inline SimdDouble floor(const SimdDouble a)
+{
+    return _mm256_floor_pd(a.v);
+}
+
+inline SimdDouble isNan(const SimdDouble a)
+{
+    return _mm256_cmp_pd(a.v, a.v, _CMP_UNORD_Q);
+}
+
+// mask ? a : b, lane by lane
+inline SimdDouble select(const SimdDouble mask, const SimdDouble a, const SimdDouble b)
+{
+    return _mm256_blendv_pd(b.v, a.v, mask.v);
+}
+
+inline bool any(const SimdDouble mask)
+{
+    return _mm256_movemask_pd(mask.v) != 0;
+}
+
+// 2^n for integer valued n in [-1022, 1023]
+inline SimdDouble exp2Integer(const SimdDouble n)
+{
+    const __m256i n_64 = _mm256_cvtepi32_epi64(_mm256_cvtpd_epi32(n.v));
+    const __m256i biased = _mm256_add_epi64(n_64, _mm256_set1_epi64x(1023));
+    return _mm256_castsi256_pd(_mm256_slli_epi64(biased, 52));
+}
+
+// Splits positive normal a into a mantissa in [1, 2), returned, and an exponent
+inline SimdDouble splitExponent(const SimdDouble a, SimdDouble& exponent)
+{
+    const __m256i bits = _mm256_castpd_si256(a.v);
+
+    // The biased exponent placed in the mantissa of 2^52 gives 2^52 + biased exponent
+    const __m256d two_52 = _mm256_set1_pd(4503599627370496.0);
+    const __m256i biased =
+        _mm256_or_si256(_mm256_srli_epi64(bits, 52), _mm256_castpd_si256(two_52));
+    const __m256d bias = _mm256_set1_pd(4503599627370496.0 + 1023.0);
+    exponent = _mm256_sub_pd(_mm256_castsi256_pd(biased), bias);
+
+    const __m256i mantissa_bits = _mm256_or_si256(
+        _mm256_and_si256(bits, _mm256_set1_epi64x(0x000FFFFFFFFFFFFFLL)),
+        _mm256_set1_epi64x(0x3FF0000000000000LL));
+    return _mm256_castsi256_pd(mantissa_bits);
+}
+
+// Eight floats. Comparisons return masks with all bits set in the lanes where they hold.
+struct SimdFloat
+{
+    typedef float Scalar;
+    enum
+    {
+        width = 8
+    };
+
+    __m256 v;
+
+    SimdFloat() = default;
+    SimdFloat(const __m256 v_in) : v(v_in) {}
+    SimdFloat(const float s) : v(_mm256_set1_ps(s)) {}
+
+    static SimdFloat load(const float* const p)
+    {
+        return _mm256_loadu_ps(p);
+    }
+
+    void store(float* const p) const
+    {
+        _mm256_storeu_ps(p, v);
+    }
+};
+
+inline SimdFloat operator+(const SimdFloat a, const SimdFloat b)
+{
+    return _mm256_add_ps(a.v, b.v);
+}
+
+inline SimdFloat operator-(const SimdFloat a, const SimdFloat b)
+{
+    return _mm256_sub_ps(a.v, b.v);
+}
+
+inline SimdFloat operator*(const SimdFloat a, const SimdFloat b)
+{
+    return _mm256_mul_ps(a.v, b.v);
+}
+
+inline SimdFloat operator/(const SimdFloat a, const SimdFloat b)
+{
+    return _mm256_div_ps(a.v, b.v);
+}
+
+inline SimdFloat operator-(const SimdFloat a)
+{
+    return _mm256_xor_ps(a.v, _mm256_set1_ps(-0.0f));
+}
+
+inline SimdFloat operator&(const SimdFloat a, const SimdFloat b)
+{
+    return _mm256_and_ps(a.v, b.v);
+}
+
+inline SimdFloat operator|(const SimdFloat a, const SimdFloat b)
+{
+    return _mm256_or_ps(a.v, b.v);
+}
+
+inline SimdFloat operator<(const SimdFloat a, const SimdFloat b)
+{
+    return _mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ);
+}
+
+inline SimdFloat operator>(const SimdFloat a, const SimdFloat b)
+{
+    return _mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ);
+}
+
+inline SimdFloat operator==(const SimdFloat a, const SimdFloat b)
+{
+    return _mm256_cmp_ps(a.v, b.v, _CMP_EQ_OQ);
+}
+
+inline SimdFloat fma(const SimdFloat a, const SimdFloat b, const SimdFloat c)
+{
+    return _mm256_fmadd_ps(a.v, b.v, c.v);
+}
+
+inline SimdFloat min(const SimdFloat a, const SimdFloat b)
+{
+    return _mm256_min_ps(a.v, b.v);
+}
+
+inline SimdFloat max(const SimdFloat a, const SimdFloat b)
+{
+    return _mm256_max_ps(a.v, b.v);
+}
+
+inline SimdFloat abs(const SimdFloat a)
+{
+    return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v);
+}
+
+inline SimdFloat sqrt(const SimdFloat a)
+{
+    return _mm256_sqrt_ps(a.v);
+}
+
+inline SimdFloat roundToNearest(const SimdFloat a)
+{
+    return _mm256_round_ps(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+}
+
+inline SimdFloat floor(const SimdFloat a)
+{
+    return _mm256_floor_ps(a.v);
+}
+
+inline SimdFloat isNan(const SimdFloat a)
+{
+    return _mm256_cmp_ps(a.v, a.v, _CMP_UNORD_Q);
+}
+
+inline SimdFloat select(const SimdFloat mask, const SimdFloat a, const SimdFloat b)
+{
+    return _mm256_blendv_ps(b.v, a.v, mask.v);
+}
+
+inline bool any(const SimdFloat mask)
+{
+    return _mm256_movemask_ps(mask.v) != 0;
+}
+
+// 2^n for integer valued n in [-126, 127]
+inline SimdFloat exp2Integer(const SimdFloat n)
+{
+    const __m256i biased = _mm256_add_epi32(_mm256_cvtps_epi32(n.v), _mm256_set1_epi32(127));
+    return _mm256_castsi256_ps(_mm256_slli_epi32(biased, 23));
+}
+
+inline SimdFloat splitExponent(const SimdFloat a, SimdFloat& exponent)
+{
+    const __m256i bits = _mm256_castps_si256(a.v);
+    const __m256 biased = _mm256_cvtepi32_ps(_mm256_srli_epi32(bits, 23));
+    exponent = _mm256_sub_ps(biased, _mm256_set1_ps(127.0f));
+
+    const __m256i mantissa_bits = _mm256_or_si256(
+        _mm256_and_si256(bits, _mm256_set1_epi32(0x007FFFFF)), _mm256_set1_epi32(0x3F800000));
+    return _mm256_castsi256_ps(mantissa_bits);
+}
+
+// The lower and upper four lanes of a, as doubles
+inline SimdDouble lowerToDouble(const SimdFloat a)
+{
+    return _mm256_cvtps_pd(_mm256_castps256_ps128(a.v));
+}
+
+inline SimdDouble upperToDouble(const SimdFloat a)
+{
+    return _mm256_cvtps_pd(_mm256_extractf128_ps(a.v, 1));
+}
+
+// lower and upper rounded to float, as the lower and upper four lanes
+inline SimdFloat toFloat(const SimdDouble lower, const SimdDouble upper)
+{
+    return _mm256_insertf128_ps(
+        _mm256_castps128_ps256(_mm256_cvtpd_ps(lower.v)), _mm256_cvtpd_ps(upper.v), 1);
+}
+}  // namespace internal
+}  // namespace plot_tool
+
+#endif
+
+#endif
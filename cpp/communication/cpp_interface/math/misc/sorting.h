@@ -0,0 +1,307 @@
+#ifndef PLOT_TOOL_SORTING_H_
+#define PLOT_TOOL_SORTING_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+// Sorting of Vector data in ascending order. Integer and floating point arrays of at least
+// radix_sort_min_num_elements elements are first given to an insertion sort that stops after a
+// linear number of moves, which sorts nearly sorted data such as timestamps, and otherwise
+// sorted with an LSD radix sort on one byte per pass. Passes over bytes that are the same for
+// all elements, such as the high bytes of small integers, are skipped. Other arrays are sorted
+// with std::sort (introsort) and std::stable_sort. NaNs are sorted last.
+
+namespace plot_tool
+{
+namespace internal
+{
+constexpr size_t radix_sort_min_num_elements = 2048;
+
+// Unsigned keys with the same order as the values, one overload per supported type
+template <typename T>
+typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value &&
+                            !std::is_same<T, bool>::value,
+                        typename std::conditional<sizeof(T) <= 4, uint32_t, uint64_t>::type>::type
+radixSortKey(const T x)
+{
+    return x;
+}
+
+template <typename T>
+typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value,
+                        typename std::conditional<sizeof(T) <= 4, uint32_t, uint64_t>::type>::type
+radixSortKey(const T x)
+{
+    using U = typename std::make_unsigned<T>::type;
+    using Key = typename std::conditional<sizeof(T) <= 4, uint32_t, uint64_t>::type;
+
+    // Flipping the sign bit maps the two's complement range onto 0...2^N - 1 in order
+    return static_cast<Key>(static_cast<U>(x) ^ (static_cast<U>(1) << (8 * sizeof(T) - 1)));
+}
+
+// Negative values have all bits flipped, so that larger magnitudes give smaller keys, and
+// positive values only the sign bit. -0 gets the key of 0 and NaNs the largest key.
+inline uint32_t radixSortKey(const float x)
+{
+    if (std::isnan(x))
+    {
+        return 0xFFFFFFFFU;
+    }
+    else if (x == 0.0f)
+    {
+        return 0x80000000U;
+    }
+    uint32_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    return (bits & 0x80000000U) ? ~bits : (bits | 0x80000000U);
+}
+
+inline uint64_t radixSortKey(const double x)
+{
+    if (std::isnan(x))
+    {
+        return 0xFFFFFFFFFFFFFFFFULL;
+    }
+    else if (x == 0.0)
+    {
+        return 0x8000000000000000ULL;
+    }
+    uint64_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    return (bits & 0x8000000000000000ULL) ? ~bits : (bits | 0x8000000000000000ULL);
+}
+
+template <typename T> struct IsRadixSortable
+{
+    static constexpr bool value =
+        (std::is_integral<T>::value && !std::is_same<T, bool>::value) ||
+        std::is_same<T, float>::value || std::is_same<T, double>::value;
+};
+
+template <typename T> bool isNanValue(const T&)
+{
+    return false;
+}
+
+inline bool isNanValue(const float x)
+{
+    return std::isnan(x);
+}
+
+inline bool isNanValue(const double x)
+{
+    return std::isnan(x);
+}
+
+// Strict weak ordering for std::sort also with NaNs, which are sorted last
+template <typename T> bool lessNanLast(const T& a, const T& b)
+{
+    return (a < b) || (!isNanValue(a) && isNanValue(b));
+}
+
+// Stable LSD radix sort of elements by key_of(element)
+template <typename E, typename K>
+void radixSort(E* const elements, const size_t num_elements, const K& key_of)
+{
+    using Key = decltype(key_of(elements[0]));
+    constexpr size_t num_bytes = sizeof(Key);
+
+    // Histograms of all bytes in one pass over the data
+    std::vector<size_t> counts(num_bytes * 256, 0);
+    for (size_t k = 0; k < num_elements; k++)
+    {
+        const Key key = key_of(elements[k]);
+        for (size_t b = 0; b < num_bytes; b++)
+        {
+            counts[b * 256 + ((key >> (8 * b)) & 0xFF)]++;
+        }
+    }
+
+    std::vector<E> buffer(num_elements);
+    E* src = elements;
+    E* dst = buffer.data();
+
+    for (size_t b = 0; b < num_bytes; b++)
+    {
+        size_t* const byte_counts = counts.data() + b * 256;
+        const size_t shift = 8 * b;
+        if (byte_counts[(key_of(src[0]) >> shift) & 0xFF] == num_elements)
+        {
+            continue;
+        }
+
+        size_t offset = 0;
+        for (size_t d = 0; d < 256; d++)
+        {
+            const size_t count = byte_counts[d];
+            byte_counts[d] = offset;
+            offset += count;
+        }
+
+        for (size_t k = 0; k < num_elements; k++)
+        {
+            dst[byte_counts[(key_of(src[k]) >> shift) & 0xFF]++] = src[k];
+        }
+
+        std::swap(src, dst);
+    }
+
+    if (src != elements)
+    {
+        std::copy(src, src + num_elements, elements);
+    }
+}
+
+// Insertion sort that gives up after max_num_moves moves, returns true if data was sorted.
+// Sorts nearly sorted data, such as merged timestamps, in linear time.
+template <typename T, typename L>
+bool boundedInsertionSort(T* const data,
+                          const size_t num_elements,
+                          const size_t max_num_moves,
+                          const L& less)
+{
+    size_t num_moves = 0;
+    for (size_t k = 1; k < num_elements; k++)
+    {
+        if (!less(data[k], data[k - 1]))
+        {
+            continue;
+        }
+
+        const T val = data[k];
+        size_t idx = k;
+        do
+        {
+            data[idx] = data[idx - 1];
+            idx--;
+        } while ((idx > 0) && less(val, data[idx - 1]));
+        data[idx] = val;
+
+        num_moves += k - idx;
+        if (num_moves > max_num_moves)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename T> struct ValueAndIndex
+{
+    T value;
+    size_t index;
+};
+
+template <typename T>
+void comparisonSortWithIndices(T* const values, size_t* const indices, const size_t num_elements)
+{
+    std::stable_sort(indices, indices + num_elements, [values](const size_t a, const size_t b) {
+        return lessNanLast(values[a], values[b]);
+    });
+
+    const std::vector<T> unsorted_values(values, values + num_elements);
+    for (size_t k = 0; k < num_elements; k++)
+    {
+        values[k] = unsorted_values[indices[k]];
+    }
+}
+
+template <typename T>
+void sortArray(T* const data, const size_t num_elements, std::true_type /* radix sortable */)
+{
+    if (num_elements < radix_sort_min_num_elements)
+    {
+        std::sort(data, data + num_elements, [](const T& a, const T& b) {
+            return lessNanLast(a, b);
+        });
+    }
+    else if (!boundedInsertionSort(
+                 data, num_elements, 8 * num_elements, [](const T& a, const T& b) {
+                     return lessNanLast(a, b);
+                 }))
+    {
+        radixSort(data, num_elements, [](const T x) { return radixSortKey(x); });
+    }
+}
+
+template <typename T>
+void sortArray(T* const data, const size_t num_elements, std::false_type /* radix sortable */)
+{
+    std::sort(data, data + num_elements, [](const T& a, const T& b) {
+        return lessNanLast(a, b);
+    });
+}
+
+template <typename T> void sortArray(T* const data, const size_t num_elements)
+{
+    sortArray(data, num_elements, std::integral_constant<bool, IsRadixSortable<T>::value>());
+}
+
+template <typename T>
+void sortArrayWithIndices(T* const values,
+                          size_t* const indices,
+                          const size_t num_elements,
+                          std::true_type /* radix sortable */)
+{
+    if (num_elements < radix_sort_min_num_elements)
+    {
+        comparisonSortWithIndices(values, indices, num_elements);
+        return;
+    }
+
+    // Values and indices are moved together, so that each pass scatters one array
+    std::vector<ValueAndIndex<T>> elements(num_elements);
+    for (size_t k = 0; k < num_elements; k++)
+    {
+        elements[k].value = values[k];
+        elements[k].index = k;
+    }
+
+    const auto less = [](const ValueAndIndex<T>& a, const ValueAndIndex<T>& b) {
+        return lessNanLast(a.value, b.value);
+    };
+    if (!boundedInsertionSort(elements.data(), num_elements, 8 * num_elements, less))
+    {
+        radixSort(elements.data(), num_elements, [](const ValueAndIndex<T>& e) {
+            return radixSortKey(e.value);
+        });
+    }
+
+    for (size_t k = 0; k < num_elements; k++)
+    {
+        values[k] = elements[k].value;
+        indices[k] = elements[k].index;
+    }
+}
+
+template <typename T>
+void sortArrayWithIndices(T* const values,
+                          size_t* const indices,
+                          const size_t num_elements,
+                          std::false_type /* radix sortable */)
+{
+    comparisonSortWithIndices(values, indices, num_elements);
+}
+
+// Sorts values and sets indices[k] to the original index of values[k]. Equal values keep
+// their original order.
+template <typename T>
+void sortArrayWithIndices(T* const values, size_t* const indices, const size_t num_elements)
+{
+    for (size_t k = 0; k < num_elements; k++)
+    {
+        indices[k] = k;
+    }
+
+    sortArrayWithIndices(
+        values, indices, num_elements, std::integral_constant<bool, IsRadixSortable<T>::value>());
+}
+}  // namespace internal
+}  // namespace plot_tool
+
+#endif
@@ -0,0 +1,338 @@
+#ifndef PLOT_TOOL_THREAD_POOL_H_
+#define PLOT_TOOL_THREAD_POOL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Shared thread pool for the client math library. Large elementwise expressions, reductions,
+// generators such as linspace and meshGrid, and matrix products split their work into ranges
+// that run on the pool, with the calling thread taking part. Each worker has its own task
+// queue and takes tasks from the back of it, and workers that run out of tasks steal from the
+// front of the other queues. The workers are started when the pool is first used.
+//
+// Work below setParallelExecutionMinNumElements elements runs on the calling thread only, and
+// setMaxNumThreads(1) turns multithreading off.
+
+namespace plot_tool
+{
+namespace internal
+{
+class ThreadPool
+{
+private:
+    struct Job
+    {
+        const std::function<void(size_t, size_t)>* f;
+        size_t num_remaining;
+        std::mutex mutex;
+        std::condition_variable done;
+    };
+
+    struct Task
+    {
+        Job* job;
+        size_t begin;
+        size_t end;
+    };
+
+    struct TaskQueue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<TaskQueue>> queues_;
+    std::vector<std::thread> workers_;
+    size_t max_num_threads_;
+    size_t next_queue_;
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::atomic<size_t> num_queued_;
+    bool stop_;
+
+    bool tryPop(const size_t queue_idx, const bool from_back, Task& task)
+    {
+        TaskQueue& queue = *queues_[queue_idx];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty())
+        {
+            return false;
+        }
+
+        if (from_back)
+        {
+            task = queue.tasks.back();
+            queue.tasks.pop_back();
+        }
+        else
+        {
+            task = queue.tasks.front();
+            queue.tasks.pop_front();
+        }
+        num_queued_--;
+        return true;
+    }
+
+    // Own queue first, then the other queues in order, starting after the own one
+    bool tryPopOrSteal(const size_t own_queue_idx, Task& task)
+    {
+        if (tryPop(own_queue_idx, true, task))
+        {
+            return true;
+        }
+        for (size_t k = 1; k < queues_.size(); k++)
+        {
+            if (tryPop((own_queue_idx + k) % queues_.size(), false, task))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static void runTask(const Task& task)
+    {
+        (*task.job->f)(task.begin, task.end);
+
+        // Decremented under the lock, so that the job isn't destroyed by the waiting thread
+        // before it's notified
+        std::lock_guard<std::mutex> lock(task.job->mutex);
+        task.job->num_remaining--;
+        if (task.job->num_remaining == 0)
+        {
+            task.job->done.notify_all();
+        }
+    }
+
+    void workerLoop(const size_t queue_idx)
+    {
+        while (true)
+        {
+            Task task;
+            if (tryPopOrSteal(queue_idx, task))
+            {
+                runTask(task);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [this] { return stop_ || (num_queued_ > 0); });
+            if (stop_)
+            {
+                return;
+            }
+        }
+    }
+
+    void start()
+    {
+        const size_t num_workers = max_num_threads_ - 1;
+        stop_ = false;
+        for (size_t k = 0; k < num_workers; k++)
+        {
+            queues_.emplace_back(new TaskQueue());
+        }
+        for (size_t k = 0; k < num_workers; k++)
+        {
+            workers_.emplace_back(&ThreadPool::workerLoop, this, k);
+        }
+    }
+
+    void stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+
+        for (std::thread& worker : workers_)
+        {
+            worker.join();
+        }
+        workers_.clear();
+        queues_.clear();
+    }
+
+public:
+    ThreadPool()
+        : max_num_threads_(std::max(1U, std::thread::hardware_concurrency())),
+          next_queue_(0),
+          num_queued_(0),
+          stop_(false)
+    {
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool()
+    {
+        stop();
+    }
+
+    // Number of threads taking part in parallel work, including the calling thread
+    size_t numThreads() const
+    {
+        return max_num_threads_;
+    }
+
+    // Restarts the pool with max_num_threads - 1 workers when it's next used. Must not be
+    // called while the pool is in use.
+    void setMaxNumThreads(const size_t max_num_threads)
+    {
+        stop();
+        max_num_threads_ = std::max<size_t>(1, max_num_threads);
+    }
+
+    // Splits [0, num_items) into num_ranges consecutive ranges with boundaries on multiples of
+    // granularity and calls f(begin, end) for each, on the workers and the calling thread.
+    // Returns when all calls have returned. Can be called from inside f.
+    template <typename F>
+    void run(const size_t num_items, const size_t granularity, const size_t num_ranges, const F& f)
+    {
+        const size_t num_chunks = (num_items + granularity - 1) / granularity;
+        const size_t max_num_ranges = std::max<size_t>(1, num_ranges);
+        const size_t chunks_per_range = (num_chunks + max_num_ranges - 1) / max_num_ranges;
+        const size_t items_per_range = std::max<size_t>(1, chunks_per_range * granularity);
+
+        if ((max_num_threads_ == 1) || (items_per_range >= num_items))
+        {
+            f(0, num_items);
+            return;
+        }
+
+        const std::function<void(size_t, size_t)> range_function(f);
+        Job job;
+        job.f = &range_function;
+        job.num_remaining = (num_items + items_per_range - 1) / items_per_range;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (workers_.empty())
+            {
+                start();
+            }
+
+            // The first range is left to the calling thread
+            for (size_t begin = items_per_range; begin < num_items; begin += items_per_range)
+            {
+                TaskQueue& queue = *queues_[next_queue_];
+                next_queue_ = (next_queue_ + 1) % queues_.size();
+
+                const size_t end = std::min(begin + items_per_range, num_items);
+                std::lock_guard<std::mutex> queue_lock(queue.mutex);
+                queue.tasks.push_back(Task{&job, begin, end});
+                num_queued_++;
+            }
+        }
+        wake_.notify_all();
+
+        runTask(Task{&job, 0, items_per_range});
+
+        // Helps with queued tasks, of this or other jobs, until none are left, and then waits
+        // for the tasks of this job that are still running
+        Task task;
+        while (tryPopOrSteal(0, task))
+        {
+            runTask(task);
+        }
+
+        std::unique_lock<std::mutex> lock(job.mutex);
+        job.done.wait(lock, [&job] { return job.num_remaining == 0; });
+    }
+};
+
+inline ThreadPool& threadPool()
+{
+    static ThreadPool pool;
+    return pool;
+}
+
+inline size_t& parallelExecutionMinNumElements()
+{
+    static size_t min_num_elements = 1 << 16;
+    return min_num_elements;
+}
+
+// Calls f(begin, end) on consecutive ranges covering [0, num_items), with boundaries on
+// multiples of granularity, in parallel if the work touches at least
+// parallelExecutionMinNumElements() elements in total. There are up to four ranges per
+// thread, so that threads that finish early can steal the remaining ones.
+template <typename F>
+void parallelFor(const size_t num_items,
+                 const size_t granularity,
+                 const size_t num_elements,
+                 const F& f)
+{
+    ThreadPool& pool = threadPool();
+    if ((num_elements < parallelExecutionMinNumElements()) || (pool.numThreads() == 1))
+    {
+        f(0, num_items);
+        return;
+    }
+
+    pool.run(num_items, granularity, 4 * pool.numThreads(), f);
+}
+
+// Number of elements per partial result of parallelReduce
+constexpr size_t reduction_chunk_size = 4096;
+
+// Reduces [0, num_items) by reducing chunks of reduction_chunk_size items with
+// reduce_range(begin, end), in parallel for large inputs, and combining the partial results in
+// order with combine(a, b). The chunks don't depend on the number of threads, so neither does
+// the result.
+template <typename T, typename R, typename C>
+T parallelReduce(const size_t num_items, const R& reduce_range, const C& combine)
+{
+    const size_t num_chunks = (num_items + reduction_chunk_size - 1) / reduction_chunk_size;
+    if (num_chunks <= 1)
+    {
+        return reduce_range(0, num_items);
+    }
+
+    std::vector<T> partial_results(num_chunks);
+    parallelFor(num_chunks, 1, num_items, [&](const size_t begin, const size_t end) {
+        for (size_t k = begin; k < end; k++)
+        {
+            const size_t chunk_begin = k * reduction_chunk_size;
+            partial_results[k] =
+                reduce_range(chunk_begin, std::min(chunk_begin + reduction_chunk_size, num_items));
+        }
+    });
+
+    T result = partial_results[0];
+    for (size_t k = 1; k < num_chunks; k++)
+    {
+        result = combine(result, partial_results[k]);
+    }
+    return result;
+}
+}  // namespace internal
+
+// Maximum number of threads used by the math library, including the calling thread, 1 turns
+// multithreading off. Defaults to the number of hardware threads. Must not be called while
+// other threads use the library.
+inline void setMaxNumThreads(const size_t max_num_threads)
+{
+    internal::threadPool().setMaxNumThreads(max_num_threads);
+}
+
+// Smallest number of elements, e.g. of an elementwise expression or a reduction, for which
+// the work is split across threads. Defaults to 65536.
+inline void setParallelExecutionMinNumElements(const size_t min_num_elements)
+{
+    internal::parallelExecutionMinNumElements() = min_num_elements;
+}
+}  // namespace plot_tool
+
+#endif
@@ -2,6 +2,7 @@
 #define PLOT_TOOL_TRANSFORMATIONS_H_
 
 #include "math/transformations/axis_angle.h"
+#include "math/transformations/batch_transformations.h"
 #include "math/transformations/pose.h"
 #include "math/transformations/quaternion.h"
 #include "math/transformations/roll_pitch_yaw.h"
@@ -0,0 +1,309 @@
+#ifndef PLOT_TOOL_BATCH_TRANSFORMATIONS_H_
+#define PLOT_TOOL_BATCH_TRANSFORMATIONS_H_
+
+#include <cstddef>
+#include <tuple>
+#include <utility>
+
+#include "logging.h"
+#include "math/lin_alg.h"
+#include "math/math_core.h"
+#include "math/misc/simd.h"
+#include "math/misc/thread_pool.h"
+#include "math/transformations/pose.h"
+#include "math/transformations/quaternion.h"
+#include "math/transformations/roll_pitch_yaw.h"
+
+// Rotation and translation of point clouds given as structure of arrays, i.e. one Vector each
+// for the x, y and z coordinates, as scatter3 and plot3 take them. The rotation matrix is
+// computed once per call, and the points are transformed a SIMD packet at a time, in parallel
+// for large clouds. Each point only depends on its own coordinates, so the output Vectors can
+// be the input Vectors.
+
+namespace plot_tool
+{
+namespace internal
+{
+// Points per range given to a thread, a whole number of packets for both float and double
+constexpr size_t batch_transformation_granularity = 64;
+
+template <typename T> MatrixFixed<3, 3, T> toRotationMatrixFixed(const Matrix<T>& m)
+{
+    PT_ASSERT((m.rows() == 3) && (m.cols() == 3)) << "Rotation matrix must be 3 x 3!";
+    MatrixFixed<3, 3, T> mres;
+
+    for (size_t r = 0; r < 3; r++)
+    {
+        for (size_t c = 0; c < 3; c++)
+        {
+            mres(r, c) = m(r, c);
+        }
+    }
+
+    return mres;
+}
+
+// (x_out, y_out, z_out) = m * (x, y, z) + t for the points [begin, end)
+template <typename T>
+void transformPointRange(const MatrixFixed<3, 3, T>& m,
+                         const VectorFixed<3, T>& t,
+                         const T* const x,
+                         const T* const y,
+                         const T* const z,
+                         T* const x_out,
+                         T* const y_out,
+                         T* const z_out,
+                         const size_t begin,
+                         const size_t end)
+{
+    const T m00 = m(0, 0), m01 = m(0, 1), m02 = m(0, 2);
+    const T m10 = m(1, 0), m11 = m(1, 1), m12 = m(1, 2);
+    const T m20 = m(2, 0), m21 = m(2, 1), m22 = m(2, 2);
+    const T t0 = t(0), t1 = t(1), t2 = t(2);
+
+    for (size_t k = begin; k < end; k++)
+    {
+        const T xk = x[k];
+        const T yk = y[k];
+        const T zk = z[k];
+
+        x_out[k] = m00 * xk + m01 * yk + m02 * zk + t0;
+        y_out[k] = m10 * xk + m11 * yk + m12 * zk + t1;
+        z_out[k] = m20 * xk + m21 * yk + m22 * zk + t2;
+    }
+}
+
+#ifdef PLOT_TOOL_SIMD_AVX2
+
+// Transforms whole packets of points from begin and returns the index of the first point that
+// is left, fewer than a packet from end
+template <typename P>
+size_t transformPointPackets(const MatrixFixed<3, 3, typename P::Scalar>& m,
+                             const VectorFixed<3, typename P::Scalar>& t,
+                             const typename P::Scalar* const x,
+                             const typename P::Scalar* const y,
+                             const typename P::Scalar* const z,
+                             typename P::Scalar* const x_out,
+                             typename P::Scalar* const y_out,
+                             typename P::Scalar* const z_out,
+                             const size_t begin,
+                             const size_t end)
+{
+    const P m00(m(0, 0)), m01(m(0, 1)), m02(m(0, 2));
+    const P m10(m(1, 0)), m11(m(1, 1)), m12(m(1, 2));
+    const P m20(m(2, 0)), m21(m(2, 1)), m22(m(2, 2));
+    const P t0(t(0)), t1(t(1)), t2(t(2));
+
+    size_t k = begin;
+    for (; k + P::width <= end; k += P::width)
+    {
+        const P xk = P::load(x + k);
+        const P yk = P::load(y + k);
+        const P zk = P::load(z + k);
+
+        fma(m00, xk, fma(m01, yk, fma(m02, zk, t0))).store(x_out + k);
+        fma(m10, xk, fma(m11, yk, fma(m12, zk, t1))).store(y_out + k);
+        fma(m20, xk, fma(m21, yk, fma(m22, zk, t2))).store(z_out + k);
+    }
+
+    return k;
+}
+
+inline void transformPointRange(const MatrixFixed<3, 3, double>& m,
+                                const VectorFixed<3, double>& t,
+                                const double* const x,
+                                const double* const y,
+                                const double* const z,
+                                double* const x_out,
+                                double* const y_out,
+                                double* const z_out,
+                                const size_t begin,
+                                const size_t end)
+{
+    const size_t k =
+        transformPointPackets<SimdDouble>(m, t, x, y, z, x_out, y_out, z_out, begin, end);
+    transformPointRange<double>(m, t, x, y, z, x_out, y_out, z_out, k, end);
+}
+
+inline void transformPointRange(const MatrixFixed<3, 3, float>& m,
+                                const VectorFixed<3, float>& t,
+                                const float* const x,
+                                const float* const y,
+                                const float* const z,
+                                float* const x_out,
+                                float* const y_out,
+                                float* const z_out,
+                                const size_t begin,
+                                const size_t end)
+{
+    const size_t k =
+        transformPointPackets<SimdFloat>(m, t, x, y, z, x_out, y_out, z_out, begin, end);
+    transformPointRange<float>(m, t, x, y, z, x_out, y_out, z_out, k, end);
+}
+
+#endif
+
+template <typename T>
+void transformPoints(const MatrixFixed<3, 3, T>& m,
+                     const VectorFixed<3, T>& t,
+                     const Vector<T>& x,
+                     const Vector<T>& y,
+                     const Vector<T>& z,
+                     Vector<T>& x_out,
+                     Vector<T>& y_out,
+                     Vector<T>& z_out)
+{
+    PT_ASSERT((x.size() == y.size()) && (x.size() == z.size()))
+        << "x, y and z must have the same size!";
+    const size_t num_points = x.size();
+
+    if (x_out.size() != num_points)
+    {
+        x_out.resize(num_points);
+    }
+    if (y_out.size() != num_points)
+    {
+        y_out.resize(num_points);
+    }
+    if (z_out.size() != num_points)
+    {
+        z_out.resize(num_points);
+    }
+
+    const T* const xp = x.getDataPointer();
+    const T* const yp = y.getDataPointer();
+    const T* const zp = z.getDataPointer();
+    T* const x_out_p = x_out.getDataPointer();
+    T* const y_out_p = y_out.getDataPointer();
+    T* const z_out_p = z_out.getDataPointer();
+
+    parallelFor(num_points,
+                batch_transformation_granularity,
+                3 * num_points,
+                [&](const size_t begin, const size_t end) {
+                    transformPointRange(
+                        m, t, xp, yp, zp, x_out_p, y_out_p, z_out_p, begin, end);
+                });
+}
+
+template <typename T> VectorFixed<3, T> zeroTranslation()
+{
+    VectorFixed<3, T> t;
+    t.fill(static_cast<T>(0));
+    return t;
+}
+}  // namespace internal
+
+// Rotates the points (x[k], y[k], z[k]) with rotation_matrix and then translates them with
+// translation_vector, writing the results to x_out, y_out and z_out, which are resized if
+// needed. The outputs can be the inputs, for transformations in place.
+template <typename T>
+void transformPoints(const Matrix<T>& rotation_matrix,
+                     const Vec3D<T>& translation_vector,
+                     const Vector<T>& x,
+                     const Vector<T>& y,
+                     const Vector<T>& z,
+                     Vector<T>& x_out,
+                     Vector<T>& y_out,
+                     Vector<T>& z_out)
+{
+    const VectorFixed<3, T> t = {translation_vector.x, translation_vector.y, translation_vector.z};
+    internal::transformPoints(
+        internal::toRotationMatrixFixed(rotation_matrix), t, x, y, z, x_out, y_out, z_out);
+}
+
+template <typename T>
+void transformPoints(const PoseSE3<T>& pose,
+                     const Vector<T>& x,
+                     const Vector<T>& y,
+                     const Vector<T>& z,
+                     Vector<T>& x_out,
+                     Vector<T>& y_out,
+                     Vector<T>& z_out)
+{
+    transformPoints(
+        pose.getRotationMatrix(), pose.getTranslationVector(), x, y, z, x_out, y_out, z_out);
+}
+
+template <typename T>
+void rotatePoints(const Matrix<T>& rotation_matrix,
+                  const Vector<T>& x,
+                  const Vector<T>& y,
+                  const Vector<T>& z,
+                  Vector<T>& x_out,
+                  Vector<T>& y_out,
+                  Vector<T>& z_out)
+{
+    internal::transformPoints(internal::toRotationMatrixFixed(rotation_matrix),
+                              internal::zeroTranslation<T>(),
+                              x,
+                              y,
+                              z,
+                              x_out,
+                              y_out,
+                              z_out);
+}
+
+template <typename T>
+void rotatePoints(const Quaternion<T>& q,
+                  const Vector<T>& x,
+                  const Vector<T>& y,
+                  const Vector<T>& z,
+                  Vector<T>& x_out,
+                  Vector<T>& y_out,
+                  Vector<T>& z_out)
+{
+    rotatePoints(q.toRotationMatrix(), x, y, z, x_out, y_out, z_out);
+}
+
+template <typename T>
+void rotatePoints(const RollPitchYaw<T>& rpy,
+                  const Vector<T>& x,
+                  const Vector<T>& y,
+                  const Vector<T>& z,
+                  Vector<T>& x_out,
+                  Vector<T>& y_out,
+                  Vector<T>& z_out)
+{
+    rotatePoints(rpy.toRotationMatrix(), x, y, z, x_out, y_out, z_out);
+}
+
+// The same, returning new Vectors, e.g. for std::tie(xt, yt, zt) = transformPoints(pose, x, y, z)
+template <typename T>
+std::tuple<Vector<T>, Vector<T>, Vector<T>> transformPoints(const PoseSE3<T>& pose,
+                                                            const Vector<T>& x,
+                                                            const Vector<T>& y,
+                                                            const Vector<T>& z)
+{
+    Vector<T> x_out(x.size()), y_out(x.size()), z_out(x.size());
+    transformPoints(pose, x, y, z, x_out, y_out, z_out);
+    return std::tuple<Vector<T>, Vector<T>, Vector<T>>(
+        std::move(x_out), std::move(y_out), std::move(z_out));
+}
+
+template <typename T>
+std::tuple<Vector<T>, Vector<T>, Vector<T>> rotatePoints(const Quaternion<T>& q,
+                                                         const Vector<T>& x,
+                                                         const Vector<T>& y,
+                                                         const Vector<T>& z)
+{
+    Vector<T> x_out(x.size()), y_out(x.size()), z_out(x.size());
+    rotatePoints(q, x, y, z, x_out, y_out, z_out);
+    return std::tuple<Vector<T>, Vector<T>, Vector<T>>(
+        std::move(x_out), std::move(y_out), std::move(z_out));
+}
+
+template <typename T>
+std::tuple<Vector<T>, Vector<T>, Vector<T>> rotatePoints(const RollPitchYaw<T>& rpy,
+                                                         const Vector<T>& x,
+                                                         const Vector<T>& y,
+                                                         const Vector<T>& z)
+{
+    Vector<T> x_out(x.size()), y_out(x.size()), z_out(x.size());
+    rotatePoints(rpy, x, y, z, x_out, y_out, z_out);
+    return std::tuple<Vector<T>, Vector<T>, Vector<T>>(
+        std::move(x_out), std::move(y_out), std::move(z_out));
+}
+}  // namespace plot_tool
+
+#endif
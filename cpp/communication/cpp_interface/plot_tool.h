@@ -72,6 +72,31 @@ inline void softClearFigure()
     sendTxList(tx_list);
 }
 
+// Limits the memory used by plot objects in all figures to max_num_bytes, 0 means no limit.
+// When exceeded, non-persistent objects are removed in the order given by eviction_policy.
+inline void setMemoryBudget(
+    const size_t max_num_bytes,
+    const EvictionPolicy eviction_policy = EvictionPolicy::LEAST_RECENTLY_USED)
+{
+    TxList tx_list;
+    tx_list.append(Command::FUNCTION, Function::MEMORY_BUDGET);
+    tx_list.append(Command::HAS_PAYLOAD, false);
+    tx_list.append(Command::MEMORY_BUDGET, max_num_bytes);
+    tx_list.append(Command::EVICTION_POLICY, eviction_policy);
+
+    sendTxList(tx_list);
+}
+
+// Makes the plot tool print the memory used by each figure
+inline void printMemoryStats()
+{
+    TxList tx_list;
+    tx_list.append(Command::FUNCTION, Function::MEMORY_STATS);
+    tx_list.append(Command::HAS_PAYLOAD, false);
+
+    sendTxList(tx_list);
+}
+
 inline void view(const float azimuth, const float elevation)
 {
     TxList tx_list;
@@ -152,6 +177,88 @@ void surf(const Matrix<T>& x, const Matrix<T>& y, const Matrix<T>& z, const Us&.
     }
 }
 
+// Takes unevaluated elementwise expressions, e.g. surf(x, y, sin(x) ^ y), and evaluates each of
+// them in a single pass before sending. The same goes for the other plot functions below.
+template <typename E0, typename E1, typename E2, typename T, typename... Us>
+void surf(const ElementwiseExpression<E0, Matrix<T>>& x,
+          const ElementwiseExpression<E1, Matrix<T>>& y,
+          const ElementwiseExpression<E2, Matrix<T>>& z,
+          const Us&... settings)
+{
+    surf(evaluate(x.derived()), evaluate(y.derived()), evaluate(z.derived()), settings...);
+}
+
+// Plots data that is not in Matrix objects, e.g. column major arrays, without copying it to
+// Matrix first
+template <typename T, typename... Us>
+void surf(const MatrixView<T>& x,
+          const MatrixView<T>& y,
+          const MatrixView<T>& z,
+          const Us&... settings)
+{
+    assert((x.rows() > 0) && (x.cols() > 0));
+    assert((x.rows() == y.rows()) && (x.cols() == y.cols()));
+    assert((x.rows() == z.rows()) && (x.cols() == z.cols()));
+
+    TxList tx_list;
+    tx_list.append(Command::FUNCTION, Function::SURF);
+    tx_list.append(Command::DATA_STRUCTURE, DataStructure::MATRIX);
+    tx_list.append(Command::DATA_TYPE, typeToDataTypeEnum<double>());
+    tx_list.append(Command::NUM_BUFFERS_REQUIRED, static_cast<char>(3));
+    tx_list.append(Command::BYTES_PER_ELEMENT, static_cast<char>(sizeof(double)));
+    tx_list.append(Command::DIMENSION_2D, Dimension2D(x.rows(), x.cols()));
+    tx_list.append(Command::NUM_ELEMENTS, x.numElements());
+    tx_list.append(Command::NUM_BYTES, x.numElements() * sizeof(double));
+    tx_list.append(Command::HAS_PAYLOAD, true);
+    tx_list.extend(settings...);
+
+    sendTxList(tx_list);
+
+    sendData(x);
+    sendData(y);
+    sendData(z);
+}
+
+// Sets the color map used by surfs with ColorMap(ColorMap::CUSTOM) in the current figure.
+// The colors, with components in [0, 1], are spread out evenly from the lowest to the
+// highest value and interpolated in between.
+template <typename T>
+void setCustomColorMap(const Vector<T>& red, const Vector<T>& green, const Vector<T>& blue)
+{
+    assert(red.isAllocated() && "red is not allocated!");
+    assert(green.isAllocated() && "green is not allocated!");
+    assert(blue.isAllocated() && "blue is not allocated!");
+    assert((red.size() > 1) && (red.size() == green.size()) && (red.size() == blue.size()));
+
+    TxList tx_list;
+    tx_list.append(Command::FUNCTION, Function::COLOR_MAP_LUT);
+    tx_list.append(Command::DATA_STRUCTURE, DataStructure::VECTOR);
+    tx_list.append(Command::DATA_TYPE, typeToDataTypeEnum<double>());
+    tx_list.append(Command::NUM_BUFFERS_REQUIRED, static_cast<char>(3));
+    tx_list.append(Command::BYTES_PER_ELEMENT, static_cast<char>(sizeof(double)));
+    tx_list.append(Command::NUM_ELEMENTS, red.numElements());
+    tx_list.append(Command::NUM_BYTES, red.numElements() * sizeof(double));
+    tx_list.append(Command::HAS_PAYLOAD, true);
+
+    sendTxList(tx_list);
+
+    if (std::is_same<T, double>::value)
+    {
+        sendData(red);
+        sendData(green);
+        sendData(blue);
+    }
+    else
+    {
+        const Vector<double> red_d(red);
+        const Vector<double> green_d(green);
+        const Vector<double> blue_d(blue);
+        sendData(red_d);
+        sendData(green_d);
+        sendData(blue_d);
+    }
+}
+
 template <typename T, typename... Us>
 void drawPolygonFrom4Points(const Point3D<T>& p0,
                             const Point3D<T>& p1,
@@ -225,6 +332,96 @@ void plot(const Vector<T>& x, const Vector<T>& y, const Us&... settings)
     }
 }
 
+template <typename E0, typename E1, typename T, typename... Us>
+void plot(const ElementwiseExpression<E0, Vector<T>>& x,
+          const ElementwiseExpression<E1, Vector<T>>& y,
+          const Us&... settings)
+{
+    plot(evaluate(x.derived()), evaluate(y.derived()), settings...);
+}
+
+// Plots data that is not in Vector objects, e.g. a std::vector, a raw buffer or one channel of
+// interleaved samples, without copying it to Vector first. The same goes for the other
+// VectorView overloads below.
+template <typename T, typename... Us>
+void plot(const VectorView<T>& x, const VectorView<T>& y, const Us&... settings)
+{
+    assert((x.size() > 0) && (x.size() == y.size()));
+
+    TxList tx_list;
+    tx_list.append(Command::FUNCTION, Function::PLOT2);
+    tx_list.append(Command::DATA_STRUCTURE, DataStructure::VECTOR);
+    tx_list.append(Command::DATA_TYPE, typeToDataTypeEnum<double>());
+    tx_list.append(Command::NUM_BUFFERS_REQUIRED, static_cast<char>(2));
+    tx_list.append(Command::BYTES_PER_ELEMENT, static_cast<char>(sizeof(double)));
+    tx_list.append(Command::NUM_ELEMENTS, x.numElements());
+    tx_list.append(Command::NUM_BYTES, x.numElements() * sizeof(double));
+    tx_list.append(Command::HAS_PAYLOAD, true);
+    tx_list.extend(settings...);
+
+    sendTxList(tx_list);
+
+    sendData(x);
+    sendData(y);
+}
+
+// Creates a rolling plot of the last capacity samples pushed to it with push(handle, samples).
+// Samples are plotted against their running index, and the x axis scrolls along with them.
+template <typename... Us>
+void scope(const size_t handle, const size_t capacity, const Us&... settings)
+{
+    assert(capacity > 0);
+
+    TxList tx_list;
+    tx_list.append(Command::FUNCTION, Function::SCOPE);
+    tx_list.append(Command::DATA_STRUCTURE, DataStructure::VECTOR);
+    tx_list.append(Command::DATA_TYPE, typeToDataTypeEnum<double>());
+    tx_list.append(Command::NUM_BUFFERS_REQUIRED, static_cast<char>(0));
+    tx_list.append(Command::BYTES_PER_ELEMENT, static_cast<char>(sizeof(double)));
+    tx_list.append(Command::NUM_ELEMENTS, capacity);
+    tx_list.append(Command::NUM_BYTES, static_cast<size_t>(0));
+    tx_list.append(Command::HAS_PAYLOAD, false);
+    tx_list.append(Command::SCOPE_HANDLE, handle);
+    tx_list.extend(settings...);
+
+    sendTxList(tx_list);
+}
+
+template <typename T> void push(const size_t handle, const Vector<T>& samples)
+{
+    assert(samples.isAllocated() && "samples is not allocated!");
+    assert(samples.size() > 0);
+
+    TxList tx_list;
+    tx_list.append(Command::FUNCTION, Function::SCOPE_PUSH);
+    tx_list.append(Command::DATA_STRUCTURE, DataStructure::VECTOR);
+    tx_list.append(Command::DATA_TYPE, typeToDataTypeEnum<double>());
+    tx_list.append(Command::NUM_BUFFERS_REQUIRED, static_cast<char>(1));
+    tx_list.append(Command::BYTES_PER_ELEMENT, static_cast<char>(sizeof(double)));
+    tx_list.append(Command::NUM_ELEMENTS, samples.numElements());
+    tx_list.append(Command::NUM_BYTES, samples.numElements() * sizeof(double));
+    tx_list.append(Command::HAS_PAYLOAD, true);
+    tx_list.append(Command::SCOPE_HANDLE, handle);
+
+    sendTxList(tx_list);
+
+    if (std::is_same<T, double>::value)
+    {
+        sendData(samples);
+    }
+    else
+    {
+        const Vector<double> samples_d(samples);
+        sendData(samples_d);
+    }
+}
+
+template <typename E, typename T>
+void push(const size_t handle, const ElementwiseExpression<E, Vector<T>>& samples)
+{
+    push(handle, evaluate(samples.derived()));
+}
+
 template <typename T, typename... Us>
 void plot3(const Vector<T>& x, const Vector<T>& y, const Vector<T>& z, const Us&... settings)
 {
@@ -263,6 +460,41 @@ void plot3(const Vector<T>& x, const Vector<T>& y, const Vector<T>& z, const Us&
     }
 }
 
+template <typename E0, typename E1, typename E2, typename T, typename... Us>
+void plot3(const ElementwiseExpression<E0, Vector<T>>& x,
+           const ElementwiseExpression<E1, Vector<T>>& y,
+           const ElementwiseExpression<E2, Vector<T>>& z,
+           const Us&... settings)
+{
+    plot3(evaluate(x.derived()), evaluate(y.derived()), evaluate(z.derived()), settings...);
+}
+
+template <typename T, typename... Us>
+void plot3(const VectorView<T>& x,
+           const VectorView<T>& y,
+           const VectorView<T>& z,
+           const Us&... settings)
+{
+    assert((x.size() > 0) && (x.size() == y.size()) && (x.size() == z.size()));
+
+    TxList tx_list;
+    tx_list.append(Command::FUNCTION, Function::PLOT3);
+    tx_list.append(Command::DATA_STRUCTURE, DataStructure::VECTOR);
+    tx_list.append(Command::DATA_TYPE, typeToDataTypeEnum<double>());
+    tx_list.append(Command::NUM_BUFFERS_REQUIRED, static_cast<char>(3));
+    tx_list.append(Command::BYTES_PER_ELEMENT, static_cast<char>(sizeof(double)));
+    tx_list.append(Command::NUM_ELEMENTS, x.numElements());
+    tx_list.append(Command::NUM_BYTES, x.numElements() * sizeof(double));
+    tx_list.append(Command::HAS_PAYLOAD, true);
+    tx_list.extend(settings...);
+
+    sendTxList(tx_list);
+
+    sendData(x);
+    sendData(y);
+    sendData(z);
+}
+
 template <typename T, typename... Us>
 void scatter(const Vector<T>& x, const Vector<T>& y, const Us&... settings)
 {
@@ -297,6 +529,36 @@ void scatter(const Vector<T>& x, const Vector<T>& y, const Us&... settings)
     }
 }
 
+template <typename E0, typename E1, typename T, typename... Us>
+void scatter(const ElementwiseExpression<E0, Vector<T>>& x,
+             const ElementwiseExpression<E1, Vector<T>>& y,
+             const Us&... settings)
+{
+    scatter(evaluate(x.derived()), evaluate(y.derived()), settings...);
+}
+
+template <typename T, typename... Us>
+void scatter(const VectorView<T>& x, const VectorView<T>& y, const Us&... settings)
+{
+    assert((x.size() > 0) && (x.size() == y.size()));
+
+    TxList tx_list;
+    tx_list.append(Command::FUNCTION, Function::SCATTER2);
+    tx_list.append(Command::DATA_STRUCTURE, DataStructure::VECTOR);
+    tx_list.append(Command::DATA_TYPE, typeToDataTypeEnum<double>());
+    tx_list.append(Command::NUM_BUFFERS_REQUIRED, static_cast<char>(2));
+    tx_list.append(Command::BYTES_PER_ELEMENT, static_cast<char>(sizeof(double)));
+    tx_list.append(Command::NUM_ELEMENTS, x.numElements());
+    tx_list.append(Command::NUM_BYTES, x.numElements() * sizeof(double));
+    tx_list.append(Command::HAS_PAYLOAD, true);
+    tx_list.extend(settings...);
+
+    sendTxList(tx_list);
+
+    sendData(x);
+    sendData(y);
+}
+
 template <typename T, typename... Us>
 void scatter3(const Vector<T>& x, const Vector<T>& y, const Vector<T>& z, const Us&... settings)
 {
@@ -335,6 +597,41 @@ void scatter3(const Vector<T>& x, const Vector<T>& y, const Vector<T>& z, const
     }
 }
 
+template <typename E0, typename E1, typename E2, typename T, typename... Us>
+void scatter3(const ElementwiseExpression<E0, Vector<T>>& x,
+              const ElementwiseExpression<E1, Vector<T>>& y,
+              const ElementwiseExpression<E2, Vector<T>>& z,
+              const Us&... settings)
+{
+    scatter3(evaluate(x.derived()), evaluate(y.derived()), evaluate(z.derived()), settings...);
+}
+
+template <typename T, typename... Us>
+void scatter3(const VectorView<T>& x,
+              const VectorView<T>& y,
+              const VectorView<T>& z,
+              const Us&... settings)
+{
+    assert((x.size() > 0) && (x.size() == y.size()) && (x.size() == z.size()));
+
+    TxList tx_list;
+    tx_list.append(Command::FUNCTION, Function::SCATTER3);
+    tx_list.append(Command::DATA_STRUCTURE, DataStructure::VECTOR);
+    tx_list.append(Command::DATA_TYPE, typeToDataTypeEnum<double>());
+    tx_list.append(Command::NUM_BUFFERS_REQUIRED, static_cast<char>(3));
+    tx_list.append(Command::BYTES_PER_ELEMENT, static_cast<char>(sizeof(double)));
+    tx_list.append(Command::NUM_ELEMENTS, x.numElements());
+    tx_list.append(Command::NUM_BYTES, x.numElements() * sizeof(double));
+    tx_list.append(Command::HAS_PAYLOAD, true);
+    tx_list.extend(settings...);
+
+    sendTxList(tx_list);
+
+    sendData(x);
+    sendData(y);
+    sendData(z);
+}
+
 template <typename T, typename... Us>
 void drawLine(const Line3D<T>& line, const T t0, const T t1, const Us&... settings)
 {
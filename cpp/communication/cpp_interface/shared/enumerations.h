@@ -27,7 +27,12 @@ enum class Function : uint8_t
     AXES,
     VIEW,
     UNKNOWN,
-    SOFT_CLEAR
+    SOFT_CLEAR,
+    COLOR_MAP_LUT,
+    MEMORY_BUDGET,
+    MEMORY_STATS,
+    SCOPE,
+    SCOPE_PUSH
 };
 
 enum class Command : uint16_t
@@ -57,7 +62,12 @@ enum class Command : uint16_t
     NAME,
     COLOR_MAP,
     UNKNOWN,
-    PERSISTENT
+    PERSISTENT,
+    MARKER_TYPE,
+    MEMORY_BUDGET,
+    EVICTION_POLICY,
+    SCOPE_HANDLE,
+    SINGLE_PRECISION
 };
 
 enum class DataType : uint8_t
@@ -77,6 +87,13 @@ enum class DataStructure : uint8_t
     VECTOR,
     IMAGE
 };
+
+// Which non-persistent plot objects are removed first when the memory budget is exceeded
+enum class EvictionPolicy : uint8_t
+{
+    LEAST_RECENTLY_USED,
+    OLDEST_FIRST
+};
 }  // namespace plot_tool
 
 #endif
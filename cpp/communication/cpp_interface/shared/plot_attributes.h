@@ -250,12 +250,46 @@ public:
     static constexpr int RAINBOW = 2;
     static constexpr int MAGMA = 3;
     static constexpr int VIRIDIS = 4;
+    // Color map set with setCustomColorMap() for the current figure
+    static constexpr int CUSTOM = 5;
 
     ColorMap() : plot_setting_(Command::COLOR_MAP), data(JET) {}
 
     ColorMap(const int i) : plot_setting_(Command::COLOR_MAP), data(i)
     {
-        assert(((i >= 1) && (i <= 4)) && "Incorrect color map input!");
+        assert(((i >= 1) && (i <= 5)) && "Incorrect color map input!");
+    }
+
+    Command getCommandType() const
+    {
+        return plot_setting_;
+    }
+};
+
+struct MarkerType
+{
+private:
+    Command plot_setting_;
+
+public:
+    int data;
+
+    // POINT draws single pixel points, the other markers are outlines of the
+    // size given by PointSize, in pixels
+    static constexpr int POINT = 1;
+    static constexpr int CIRCLE = 2;
+    static constexpr int SQUARE = 3;
+    static constexpr int DIAMOND = 4;
+    static constexpr int CROSS = 5;
+    static constexpr int PLUS = 6;
+    static constexpr int TRIANGLE_UP = 7;
+    static constexpr int TRIANGLE_DOWN = 8;
+
+    MarkerType() : plot_setting_(Command::MARKER_TYPE), data(POINT) {}
+
+    MarkerType(const int i) : plot_setting_(Command::MARKER_TYPE), data(i)
+    {
+        assert(((i >= 1) && (i <= 8)) && "Incorrect marker type input!");
     }
 
     Command getCommandType() const
@@ -282,6 +316,24 @@ public:
     }
 };
 
+// Lets the server store the plot data as float, relative to the center of the data, which
+// halves the memory of large double plots at the cost of precision
+struct SinglePrecision
+{
+private:
+    Command plot_setting_;
+
+public:
+    int data;
+
+    SinglePrecision() : plot_setting_(Command::SINGLE_PRECISION), data(1) {}
+
+    Command getCommandType() const
+    {
+        return plot_setting_;
+    }
+};
+
 struct PointSize
 {
 private:
@@ -147,6 +147,26 @@ template <typename U> bool checkTypeValid(const Command& command)
     {
         return std::is_same<U, Pos2D>::value;
     }
+    else if (command == Command::MARKER_TYPE)
+    {
+        return std::is_same<U, MarkerType>::value;
+    }
+    else if (command == Command::MEMORY_BUDGET)
+    {
+        return std::is_same<U, size_t>::value;
+    }
+    else if (command == Command::EVICTION_POLICY)
+    {
+        return std::is_same<U, EvictionPolicy>::value;
+    }
+    else if (command == Command::SCOPE_HANDLE)
+    {
+        return std::is_same<U, size_t>::value;
+    }
+    else if (command == Command::SINGLE_PRECISION)
+    {
+        return std::is_same<U, SinglePrecision>::value;
+    }
     else
     {
         return false;
@@ -159,7 +179,8 @@ template <typename U> constexpr bool isCorrectType()
            std::is_same<U, Name>::value || std::is_same<U, LineStyle>::value ||
            std::is_same<U, Color>::value || std::is_same<U, EdgeColor>::value ||
            std::is_same<U, FaceColor>::value || std::is_same<U, ColorMap>::value ||
-           std::is_same<U, Persistent>::value || std::is_same<U, PointSize>::value;
+           std::is_same<U, Persistent>::value || std::is_same<U, PointSize>::value ||
+           std::is_same<U, MarkerType>::value || std::is_same<U, SinglePrecision>::value;
 }
 
 class TxList
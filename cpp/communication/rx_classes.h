@@ -592,6 +592,33 @@ public:
     }
 };
 
+class SinglePrecisionRx : public RxReceiveBase
+{
+private:
+    SinglePrecision data_;
+
+public:
+    typedef SinglePrecision data_type;
+    SinglePrecision getData() const
+    {
+        return data_;
+    }
+    SinglePrecisionRx() : RxReceiveBase(Command::SINGLE_PRECISION) {}
+    SinglePrecisionRx(const SinglePrecision data)
+        : RxReceiveBase(Command::SINGLE_PRECISION), data_(data)
+    {
+    }
+    SinglePrecisionRx(const char* const buffer) : RxReceiveBase(Command::SINGLE_PRECISION)
+    {
+        plot_tool::fillObjectsFromBuffer(buffer, data_);
+    }
+
+    size_t sizeOfData() const override
+    {
+        return sizeof(SinglePrecision);
+    }
+};
+
 class PointSizeRx : public RxReceiveBase
 {
 private:
@@ -616,6 +643,30 @@ public:
     }
 };
 
+class MarkerTypeRx : public RxReceiveBase
+{
+private:
+    MarkerType data_;
+
+public:
+    typedef MarkerType data_type;
+    MarkerType getData() const
+    {
+        return data_;
+    }
+    MarkerTypeRx() : RxReceiveBase(Command::MARKER_TYPE) {}
+    MarkerTypeRx(const MarkerType data) : RxReceiveBase(Command::MARKER_TYPE), data_(data) {}
+    MarkerTypeRx(const char* const buffer) : RxReceiveBase(Command::MARKER_TYPE)
+    {
+        plot_tool::fillObjectsFromBuffer(buffer, data_);
+    }
+
+    size_t sizeOfData() const override
+    {
+        return sizeof(MarkerType);
+    }
+};
+
 class PositionRx : public RxReceiveBase
 {
 private:
@@ -640,6 +691,81 @@ public:
     }
 };
 
+class MemoryBudgetRx : public RxReceiveBase
+{
+private:
+    size_t data_;
+
+public:
+    typedef size_t data_type;
+    size_t getData() const
+    {
+        return data_;
+    }
+    MemoryBudgetRx() : RxReceiveBase(Command::MEMORY_BUDGET) {}
+    MemoryBudgetRx(const size_t data) : RxReceiveBase(Command::MEMORY_BUDGET), data_(data) {}
+    MemoryBudgetRx(const char* const buffer) : RxReceiveBase(Command::MEMORY_BUDGET)
+    {
+        plot_tool::fillObjectsFromBuffer(buffer, data_);
+    }
+
+    size_t sizeOfData() const override
+    {
+        return sizeof(size_t);
+    }
+};
+
+class EvictionPolicyRx : public RxReceiveBase
+{
+private:
+    EvictionPolicy data_;
+
+public:
+    typedef EvictionPolicy data_type;
+    EvictionPolicy getData() const
+    {
+        return data_;
+    }
+    EvictionPolicyRx() : RxReceiveBase(Command::EVICTION_POLICY) {}
+    EvictionPolicyRx(const EvictionPolicy data)
+        : RxReceiveBase(Command::EVICTION_POLICY), data_(data)
+    {
+    }
+    EvictionPolicyRx(const char* const buffer) : RxReceiveBase(Command::EVICTION_POLICY)
+    {
+        plot_tool::fillObjectsFromBuffer(buffer, data_);
+    }
+
+    size_t sizeOfData() const override
+    {
+        return sizeof(EvictionPolicy);
+    }
+};
+
+class ScopeHandleRx : public RxReceiveBase
+{
+private:
+    size_t data_;
+
+public:
+    typedef size_t data_type;
+    size_t getData() const
+    {
+        return data_;
+    }
+    ScopeHandleRx() : RxReceiveBase(Command::SCOPE_HANDLE) {}
+    ScopeHandleRx(const size_t data) : RxReceiveBase(Command::SCOPE_HANDLE), data_(data) {}
+    ScopeHandleRx(const char* const buffer) : RxReceiveBase(Command::SCOPE_HANDLE)
+    {
+        plot_tool::fillObjectsFromBuffer(buffer, data_);
+    }
+
+    size_t sizeOfData() const override
+    {
+        return sizeof(size_t);
+    }
+};
+
 }  // namespace plot_tool
 
 #endif
@@ -134,6 +134,31 @@ inline RxReceiveBase* getPointerFromCommandType(const Command cmd, RxReceiveBase
         PositionRx* other_ptr = dynamic_cast<PositionRx*>(base_ptr);
         ptr = new PositionRx(other_ptr->getData());
     }
+    else if (Command::MARKER_TYPE == cmd)
+    {
+        MarkerTypeRx* other_ptr = dynamic_cast<MarkerTypeRx*>(base_ptr);
+        ptr = new MarkerTypeRx(other_ptr->getData());
+    }
+    else if (Command::MEMORY_BUDGET == cmd)
+    {
+        MemoryBudgetRx* other_ptr = dynamic_cast<MemoryBudgetRx*>(base_ptr);
+        ptr = new MemoryBudgetRx(other_ptr->getData());
+    }
+    else if (Command::EVICTION_POLICY == cmd)
+    {
+        EvictionPolicyRx* other_ptr = dynamic_cast<EvictionPolicyRx*>(base_ptr);
+        ptr = new EvictionPolicyRx(other_ptr->getData());
+    }
+    else if (Command::SCOPE_HANDLE == cmd)
+    {
+        ScopeHandleRx* other_ptr = dynamic_cast<ScopeHandleRx*>(base_ptr);
+        ptr = new ScopeHandleRx(other_ptr->getData());
+    }
+    else if (Command::SINGLE_PRECISION == cmd)
+    {
+        SinglePrecisionRx* other_ptr = dynamic_cast<SinglePrecisionRx*>(base_ptr);
+        ptr = new SinglePrecisionRx(other_ptr->getData());
+    }
     else
     {
         EXIT() << "Pointer type not found!";
@@ -247,6 +272,26 @@ inline std::pair<RxReceiveBase*, size_t> getPointerFromCommandType(const Command
     {
         ptr = new PositionRx(buffer);
     }
+    else if (Command::MARKER_TYPE == cmd)
+    {
+        ptr = new MarkerTypeRx(buffer);
+    }
+    else if (Command::MEMORY_BUDGET == cmd)
+    {
+        ptr = new MemoryBudgetRx(buffer);
+    }
+    else if (Command::EVICTION_POLICY == cmd)
+    {
+        ptr = new EvictionPolicyRx(buffer);
+    }
+    else if (Command::SCOPE_HANDLE == cmd)
+    {
+        ptr = new ScopeHandleRx(buffer);
+    }
+    else if (Command::SINGLE_PRECISION == cmd)
+    {
+        ptr = new SinglePrecisionRx(buffer);
+    }
     else
     {
         EXIT() << "Pointer type not found!";
@@ -358,6 +403,26 @@ template <typename T> Command getCommandTypeFromClass()
     {
         cmd = Command::POS2D;
     }
+    else if (std::is_same<T, MarkerTypeRx>::value)
+    {
+        cmd = Command::MARKER_TYPE;
+    }
+    else if (std::is_same<T, MemoryBudgetRx>::value)
+    {
+        cmd = Command::MEMORY_BUDGET;
+    }
+    else if (std::is_same<T, EvictionPolicyRx>::value)
+    {
+        cmd = Command::EVICTION_POLICY;
+    }
+    else if (std::is_same<T, ScopeHandleRx>::value)
+    {
+        cmd = Command::SCOPE_HANDLE;
+    }
+    else if (std::is_same<T, SinglePrecisionRx>::value)
+    {
+        cmd = Command::SINGLE_PRECISION;
+    }
     else
     {
         EXIT() << "Command type not found!";
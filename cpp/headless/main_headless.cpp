@@ -0,0 +1,218 @@
+#include <arl/utilities/logging.h>
+#include <sys/stat.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "communication/rx_list.h"
+#include "communication/server.h"
+#include "headless/offscreen_figure.h"
+#include "opengl_low_level/opengl_text.h"
+
+/*
+Headless plot tool, renders figures without a display and writes them as PNG files.
+
+Usage: plot-tool-headless [output_dir] [width] [height]
+
+A frame of a figure is written to "<output_dir>/figure_<num>_<frame>.png" when it holds
+content that hasn't been written yet, and either
+ - another figure is selected with "figure(n)"
+ - the figure is about to be cleared (clearFigure(), softClearFigure(), or a new plot
+   command without holdOn())
+ - the client disconnects
+*/
+
+using namespace plot_tool;
+
+class HeadlessApplication
+{
+private:
+    const std::string output_dir_;
+    const int width_;
+    const int height_;
+
+    std::vector<std::unique_ptr<OffscreenFigure>> figures_;
+    std::vector<size_t> frame_counters_;
+    std::vector<bool> has_unsaved_content_;
+    size_t current_figure_idx_;
+
+    size_t figureIdxFromFigNum(const size_t figure_number);
+    void writeFrame(const size_t figure_idx);
+
+public:
+    HeadlessApplication(const std::string& output_dir, const int width, const int height);
+
+    void handleSentCommands(const RxList& rx_list, const std::vector<char*>& data_vec);
+    void writeUnsavedFrames();
+};
+
+HeadlessApplication::HeadlessApplication(const std::string& output_dir,
+                                         const int width,
+                                         const int height)
+    : output_dir_(output_dir), width_(width), height_(height), current_figure_idx_(0)
+{
+}
+
+size_t HeadlessApplication::figureIdxFromFigNum(const size_t figure_number)
+{
+    for (size_t k = 0; k < figures_.size(); k++)
+    {
+        if (figures_[k]->getFigureNum() == figure_number)
+        {
+            return k;
+        }
+    }
+
+    figures_.emplace_back(new OffscreenFigure(figure_number, width_, height_));
+    frame_counters_.push_back(0);
+    has_unsaved_content_.push_back(false);
+
+    return figures_.size() - 1;
+}
+
+void HeadlessApplication::writeFrame(const size_t figure_idx)
+{
+    OffscreenFigure* const figure = figures_[figure_idx].get();
+
+    char file_name[64];
+    snprintf(file_name,
+             sizeof(file_name),
+             "/figure_%zu_%06zu.png",
+             figure->getFigureNum(),
+             frame_counters_[figure_idx]);
+
+    figure->render();
+    if (!figure->saveAsPng(output_dir_ + file_name))
+    {
+        LOG_WARNING() << "Failed to write frame " << output_dir_ + file_name;
+    }
+
+    frame_counters_[figure_idx]++;
+    has_unsaved_content_[figure_idx] = false;
+}
+
+void HeadlessApplication::writeUnsavedFrames()
+{
+    for (size_t k = 0; k < figures_.size(); k++)
+    {
+        if (has_unsaved_content_[k])
+        {
+            writeFrame(k);
+        }
+    }
+}
+
+void HeadlessApplication::handleSentCommands(const RxList& rx_list,
+                                             const std::vector<char*>& data_vec)
+{
+    const Function function_type = rx_list.getObjectData<FunctionRx>();
+
+    if (function_type == Function::FIGURE)
+    {
+        size_t figure_number = 1;
+        if (rx_list.hasKey(Command::FIGURE_NUM))
+        {
+            figure_number = rx_list.getObjectData<FigureNumRx>();
+        }
+        else
+        {
+            for (size_t k = 0; k < figures_.size(); k++)
+            {
+                figure_number = std::max(figure_number, figures_[k]->getFigureNum() + 1);
+            }
+        }
+
+        const size_t new_figure_idx = figureIdxFromFigNum(figure_number);
+        if ((new_figure_idx != current_figure_idx_) && has_unsaved_content_[current_figure_idx_])
+        {
+            writeFrame(current_figure_idx_);
+        }
+        current_figure_idx_ = new_figure_idx;
+        return;
+    }
+
+    if (figures_.size() == 0)
+    {
+        current_figure_idx_ = figureIdxFromFigNum(1);
+    }
+
+    OffscreenFigure* const figure = figures_[current_figure_idx_].get();
+
+    const bool is_clear_command =
+        (function_type == Function::CLEAR) || (function_type == Function::SOFT_CLEAR);
+    const bool is_setting_command =
+        is_clear_command || (function_type == Function::HOLD_ON) ||
+        (function_type == Function::AXES) || (function_type == Function::VIEW) ||
+        (function_type == Function::POSITION) || (function_type == Function::COLOR_MAP_LUT);
+
+    if (has_unsaved_content_[current_figure_idx_] &&
+        (is_clear_command || (!is_setting_command && !figure->isHoldOn())))
+    {
+        writeFrame(current_figure_idx_);
+    }
+
+    figure->addData(rx_list, data_vec);
+
+    if (!is_clear_command && (function_type != Function::POSITION) &&
+        (function_type != Function::COLOR_MAP_LUT))
+    {
+        has_unsaved_content_[current_figure_idx_] = true;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const std::string output_dir = argc > 1 ? argv[1] : ".";
+    const int width = argc > 2 ? std::atoi(argv[2]) : 600;
+    const int height = argc > 3 ? std::atoi(argv[3]) : 600;
+
+    if ((width <= 0) || (height <= 0))
+    {
+        LOG_ERROR() << "Usage: plot-tool-headless [output_dir] [width] [height]";
+        return -1;
+    }
+
+    mkdir(output_dir.c_str(), 0755);
+
+    system("rm -rf /tmp/socket_file");
+
+    // Bitmap fonts are provided by glut, which can't be initialized without a display
+    setTextRenderingEnabled(false);
+
+    std::mutex mtx;
+    std::vector<std::string> plot_command_vector;
+    RxList rx_list;
+
+    const size_t max_buffer_size = 1000000;
+    Server server("socket_file", max_buffer_size, &mtx, &plot_command_vector, rx_list);
+
+    std::vector<char*> receiver_buffer_pointers;
+    for (size_t k = 0; k < server.getNumBufferPointers(); k++)
+    {
+        receiver_buffer_pointers.push_back(server.getBufferPointer(k));
+    }
+
+    HeadlessApplication application(output_dir, width, height);
+
+    server.start();
+
+    while (1)
+    {
+        server.receive();
+
+        if (server.clientConnected())
+        {
+            application.handleSentCommands(rx_list, receiver_buffer_pointers);
+        }
+        else
+        {
+            application.writeUnsavedFrames();
+        }
+    }
+
+    return 0;
+}
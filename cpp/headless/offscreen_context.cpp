@@ -0,0 +1,181 @@
+#include "headless/offscreen_context.h"
+
+#include <EGL/eglext.h>
+#include <arl/utilities/logging.h>
+
+#include <cstring>
+
+#include "opengl_low_level/opengl_header.h"
+
+namespace
+{
+EGLConfig chooseConfig(EGLDisplay display)
+{
+    // Prefer a multisampled config to match the on screen windows, but accept any
+    // pbuffer capable config since software rasterizers often don't expose one
+    const EGLint sample_counts[] = {4, 0};
+
+    for (const EGLint num_samples : sample_counts)
+    {
+        const EGLint config_attributes[] = {EGL_SURFACE_TYPE,
+                                            EGL_PBUFFER_BIT,
+                                            EGL_RENDERABLE_TYPE,
+                                            EGL_OPENGL_BIT,
+                                            EGL_RED_SIZE,
+                                            8,
+                                            EGL_GREEN_SIZE,
+                                            8,
+                                            EGL_BLUE_SIZE,
+                                            8,
+                                            EGL_ALPHA_SIZE,
+                                            8,
+                                            EGL_DEPTH_SIZE,
+                                            16,
+                                            EGL_SAMPLE_BUFFERS,
+                                            num_samples > 0 ? 1 : 0,
+                                            EGL_SAMPLES,
+                                            num_samples,
+                                            EGL_NONE};
+        EGLConfig config;
+        EGLint num_configs = 0;
+        if (eglChooseConfig(display, config_attributes, &config, 1, &num_configs) &&
+            (num_configs > 0))
+        {
+            return config;
+        }
+    }
+
+    EXIT() << "No EGL pbuffer config with OpenGL support available!";
+    return nullptr;
+}
+}  // namespace
+
+OffscreenContext::OffscreenContext(const int width, const int height)
+    : surface_(EGL_NO_SURFACE), width_(width), height_(height)
+{
+    ASSERT((width > 0) && (height > 0)) << "Invalid offscreen size: " << width << "x" << height;
+
+    display_ = getDisplay();
+
+    EGLint major_version, minor_version;
+    ASSERT(eglInitialize(display_, &major_version, &minor_version))
+        << "Failed to initialize EGL display!";
+
+    // The plot functions use immediate mode, which requires desktop OpenGL
+    ASSERT(eglBindAPI(EGL_OPENGL_API)) << "EGL implementation lacks desktop OpenGL support!";
+
+    config_ = chooseConfig(display_);
+    context_ = eglCreateContext(display_, config_, EGL_NO_CONTEXT, nullptr);
+    ASSERT(context_ != EGL_NO_CONTEXT) << "Failed to create EGL context!";
+
+    createSurface();
+    makeCurrent();
+}
+
+OffscreenContext::~OffscreenContext()
+{
+    eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    destroySurface();
+    eglDestroyContext(display_, context_);
+    eglTerminate(display_);
+}
+
+EGLDisplay OffscreenContext::getDisplay() const
+{
+    const char* client_extensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    const bool has_surfaceless = (client_extensions != nullptr) &&
+                                 (std::strstr(client_extensions, "EGL_MESA_platform_surfaceless"));
+
+    if (has_surfaceless)
+    {
+        const PFNEGLGETPLATFORMDISPLAYEXTPROC get_platform_display =
+            reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+                eglGetProcAddress("eglGetPlatformDisplayEXT"));
+        if (get_platform_display != nullptr)
+        {
+            const EGLDisplay display =
+                get_platform_display(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+            if (display != EGL_NO_DISPLAY)
+            {
+                return display;
+            }
+        }
+    }
+
+    const EGLDisplay display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    ASSERT(display != EGL_NO_DISPLAY) << "No EGL display available!";
+    return display;
+}
+
+void OffscreenContext::createSurface()
+{
+    const EGLint surface_attributes[] = {EGL_WIDTH, width_, EGL_HEIGHT, height_, EGL_NONE};
+    surface_ = eglCreatePbufferSurface(display_, config_, surface_attributes);
+    ASSERT(surface_ != EGL_NO_SURFACE) << "Failed to create pbuffer of size " << width_ << "x"
+                                       << height_;
+}
+
+void OffscreenContext::destroySurface()
+{
+    if (surface_ != EGL_NO_SURFACE)
+    {
+        eglDestroySurface(display_, surface_);
+        surface_ = EGL_NO_SURFACE;
+    }
+}
+
+void OffscreenContext::makeCurrent()
+{
+    ASSERT(eglMakeCurrent(display_, surface_, surface_, context_))
+        << "Failed to make offscreen context current!";
+}
+
+void OffscreenContext::resize(const int width, const int height)
+{
+    if ((width == width_) && (height == height_))
+    {
+        return;
+    }
+    ASSERT((width > 0) && (height > 0)) << "Invalid offscreen size: " << width << "x" << height;
+
+    eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    destroySurface();
+
+    width_ = width;
+    height_ = height;
+
+    createSurface();
+    makeCurrent();
+}
+
+void OffscreenContext::readPixels(std::vector<uint8_t>& rgba_data) const
+{
+    const size_t row_size = 4 * static_cast<size_t>(width_);
+    rgba_data.resize(row_size * static_cast<size_t>(height_));
+
+    glFinish();
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadBuffer(GL_BACK);
+    glReadPixels(0, 0, width_, height_, GL_RGBA, GL_UNSIGNED_BYTE, rgba_data.data());
+
+    // OpenGL returns the bottom row first
+    std::vector<uint8_t> row_buffer(row_size);
+    for (size_t r = 0; r < static_cast<size_t>(height_) / 2; r++)
+    {
+        uint8_t* const top_row = rgba_data.data() + r * row_size;
+        uint8_t* const bottom_row = rgba_data.data() + (height_ - 1 - r) * row_size;
+        std::memcpy(row_buffer.data(), top_row, row_size);
+        std::memcpy(top_row, bottom_row, row_size);
+        std::memcpy(bottom_row, row_buffer.data(), row_size);
+    }
+}
+
+int OffscreenContext::getWidth() const
+{
+    return width_;
+}
+
+int OffscreenContext::getHeight() const
+{
+    return height_;
+}
@@ -0,0 +1,44 @@
+#ifndef OFFSCREEN_CONTEXT_H_
+#define OFFSCREEN_CONTEXT_H_
+
+#include <EGL/egl.h>
+#include <stdint.h>
+
+#include <vector>
+
+// Legacy (compatibility profile) OpenGL context rendering into an EGL pbuffer,
+// without any windowing system. On Mesa the surfaceless platform is used, which
+// falls back to the llvmpipe/swrast software rasterizer on machines without a GPU.
+class OffscreenContext
+{
+private:
+    EGLDisplay display_;
+    EGLConfig config_;
+    EGLContext context_;
+    EGLSurface surface_;
+
+    int width_;
+    int height_;
+
+    EGLDisplay getDisplay() const;
+    void createSurface();
+    void destroySurface();
+
+public:
+    OffscreenContext() = delete;
+    OffscreenContext(const OffscreenContext&) = delete;
+    OffscreenContext& operator=(const OffscreenContext&) = delete;
+    OffscreenContext(const int width, const int height);
+    ~OffscreenContext();
+
+    void makeCurrent();
+    void resize(const int width, const int height);
+
+    // Reads back the color buffer as tightly packed RGBA rows, top row first
+    void readPixels(std::vector<uint8_t>& rgba_data) const;
+
+    int getWidth() const;
+    int getHeight() const;
+};
+
+#endif
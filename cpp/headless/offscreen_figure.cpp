@@ -0,0 +1,166 @@
+#include "headless/offscreen_figure.h"
+
+#include <arl/math/math.h>
+#include <arl/utilities/logging.h>
+
+#include "axes/axes.h"
+#include "headless/png_writer.h"
+#include "main_application/plot_data.h"
+#include "opengl_low_level/opengl_low_level.h"
+
+using namespace plot_tool;
+
+OffscreenFigure::OffscreenFigure(const size_t figure_number, const int width, const int height)
+    : context_(width, height), figure_number_(figure_number)
+{
+    const AxesSettings axes_settings({-1.0, -1.0, -1.0}, {1.0, 1.0, 1.0});
+
+    axes_interactor_ = new AxesInteractor(axes_settings);
+    axes_painter_ = new AxesPainter(axes_settings);
+
+    hold_on_ = false;
+    axes_set_ = false;
+}
+
+OffscreenFigure::~OffscreenFigure()
+{
+    plot_data_handler_.clear();
+
+    delete axes_interactor_;
+    delete axes_painter_;
+}
+
+void OffscreenFigure::addData(const plot_tool::RxList& rx_list, const std::vector<char*> data_vec)
+{
+    const Function function_type = rx_list.getObjectData<FunctionRx>();
+
+    if (function_type == Function::HOLD_ON)
+    {
+        hold_on_ = true;
+    }
+    else if (function_type == Function::AXES)
+    {
+        axes_set_ = true;
+        const int num_dimensions = rx_list.getObjectData<AxesDimensionsRx>();
+
+        ASSERT((num_dimensions == 2) || (num_dimensions == 3))
+            << "Error in dimension: " << num_dimensions;
+        const auto new_ax_lim = rx_list.getObjectData<AxesMinMaxVecRx>();
+
+        if (num_dimensions == 2)
+        {
+            axes_interactor_->setAxesLimits(arl::Vec2Dd(new_ax_lim.first.x, new_ax_lim.first.y),
+                                            arl::Vec2Dd(new_ax_lim.second.x, new_ax_lim.second.y));
+        }
+        else
+        {
+            axes_interactor_->setAxesLimits(new_ax_lim.first, new_ax_lim.second);
+        }
+    }
+    else if (function_type == Function::VIEW)
+    {
+        const float azimuth = rx_list.getObjectData<AzimuthRx>();
+        const float elevation = rx_list.getObjectData<ElevationRx>();
+
+        axes_interactor_->setViewAngles(azimuth, elevation);
+    }
+    else if (function_type == Function::CLEAR)
+    {
+        axes_set_ = false;
+        hold_on_ = false;
+        plot_data_handler_.clear();
+    }
+    else if (function_type == Function::SOFT_CLEAR)
+    {
+        plot_data_handler_.softClear();
+    }
+    else if (function_type == Function::COLOR_MAP_LUT)
+    {
+        plot_data_handler_.setCustomColorLut(rx_list, data_vec);
+    }
+    else if (function_type == Function::POSITION)
+    {
+        // Window position has no meaning without a window
+    }
+    else
+    {
+        if (!hold_on_)
+        {
+            plot_data_handler_.clear();
+        }
+        plot_data_handler_.addData(rx_list, data_vec);
+
+        if (!axes_set_)
+        {
+            const std::pair<arl::Vec3Dd, arl::Vec3Dd> min_max =
+                plot_data_handler_.getMinMaxVectors();
+            axes_interactor_->setAxesLimits(min_max.first, min_max.second);
+        }
+    }
+}
+
+void OffscreenFigure::setSize(const int width, const int height)
+{
+    context_.resize(width, height);
+}
+
+void OffscreenFigure::render()
+{
+    context_.makeCurrent();
+    glViewport(0, 0, getWidth(), getHeight());
+
+    glEnable(GL_MULTISAMPLE);
+
+    const float bg_color = 190.0f;
+
+    // The pixels are read back and written as RGBA, so the background must be opaque, and
+    // nothing drawn on top of it may lower the alpha
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+    glClearColor(bg_color / 255.0f, bg_color / 255.0f, bg_color / 255.0f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_FALSE);
+
+    axes_interactor_->update(InteractionType::UNCHANGED, getWidth(), getHeight());
+
+    axes_painter_->paint(axes_interactor_->getAxesLimits(),
+                         axes_interactor_->getViewAngles(),
+                         axes_interactor_->generateGridVectors(),
+                         axes_interactor_->getCoordConverter());
+
+    glEnable(GL_DEPTH_TEST);
+    axes_painter_->plotBegin();
+
+    plot_data_handler_.visualize();
+
+    axes_painter_->plotEnd();
+    glDisable(GL_DEPTH_TEST);
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+}
+
+bool OffscreenFigure::saveAsPng(const std::string& file_path)
+{
+    context_.makeCurrent();
+    context_.readPixels(pixel_buffer_);
+
+    return writePng(file_path, getWidth(), getHeight(), pixel_buffer_);
+}
+
+bool OffscreenFigure::isHoldOn() const
+{
+    return hold_on_;
+}
+
+size_t OffscreenFigure::getFigureNum() const
+{
+    return figure_number_;
+}
+
+int OffscreenFigure::getWidth() const
+{
+    return context_.getWidth();
+}
+
+int OffscreenFigure::getHeight() const
+{
+    return context_.getHeight();
+}
@@ -0,0 +1,52 @@
+#ifndef OFFSCREEN_FIGURE_H_
+#define OFFSCREEN_FIGURE_H_
+
+#include <arl/math/math.h>
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "axes/axes.h"
+#include "communication/rx_list.h"
+#include "headless/offscreen_context.h"
+#include "main_application/plot_data.h"
+
+// Headless counterpart of PlotWindowGLPane. Holds the same axes and plot data
+// state, but renders into an offscreen buffer that can be saved as a PNG file.
+class OffscreenFigure
+{
+private:
+    OffscreenContext context_;
+
+    AxesInteractor* axes_interactor_;
+    AxesPainter* axes_painter_;
+
+    bool hold_on_;
+    bool axes_set_;
+
+    PlotDataHandler plot_data_handler_;
+
+    const size_t figure_number_;
+    std::vector<uint8_t> pixel_buffer_;
+
+public:
+    OffscreenFigure() = delete;
+    OffscreenFigure(const OffscreenFigure&) = delete;
+    OffscreenFigure& operator=(const OffscreenFigure&) = delete;
+    OffscreenFigure(const size_t figure_number, const int width, const int height);
+    ~OffscreenFigure();
+
+    void addData(const plot_tool::RxList& rx_list, const std::vector<char*> data_vec);
+    void setSize(const int width, const int height);
+
+    void render();
+    bool saveAsPng(const std::string& file_path);
+
+    bool isHoldOn() const;
+    size_t getFigureNum() const;
+    int getWidth() const;
+    int getHeight() const;
+};
+
+#endif
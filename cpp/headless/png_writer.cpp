@@ -0,0 +1,100 @@
+#include "headless/png_writer.h"
+
+#include <arl/utilities/logging.h>
+#include <zlib.h>
+
+#include <fstream>
+
+// PNG specification: https://www.w3.org/TR/PNG/
+
+namespace
+{
+void appendUint32BigEndian(std::vector<uint8_t>& buffer, const uint32_t value)
+{
+    buffer.push_back(static_cast<uint8_t>(value >> 24));
+    buffer.push_back(static_cast<uint8_t>(value >> 16));
+    buffer.push_back(static_cast<uint8_t>(value >> 8));
+    buffer.push_back(static_cast<uint8_t>(value));
+}
+
+void writeChunk(std::ofstream& file, const char* chunk_type, const std::vector<uint8_t>& data)
+{
+    std::vector<uint8_t> header;
+    appendUint32BigEndian(header, static_cast<uint32_t>(data.size()));
+    header.insert(header.end(), chunk_type, chunk_type + 4);
+
+    // The CRC covers the chunk type and the chunk data, but not the length
+    uLong crc = crc32(0L, Z_NULL, 0);
+    crc = crc32(crc, header.data() + 4, 4);
+    if (data.size() > 0)
+    {
+        crc = crc32(crc, data.data(), static_cast<uInt>(data.size()));
+    }
+
+    std::vector<uint8_t> footer;
+    appendUint32BigEndian(footer, static_cast<uint32_t>(crc));
+
+    file.write(reinterpret_cast<const char*>(header.data()), header.size());
+    file.write(reinterpret_cast<const char*>(data.data()), data.size());
+    file.write(reinterpret_cast<const char*>(footer.data()), footer.size());
+}
+}  // namespace
+
+bool writePng(const std::string& file_path,
+              const int width,
+              const int height,
+              const std::vector<uint8_t>& rgba_data,
+              const int compression_level)
+{
+    const size_t row_size = 4 * static_cast<size_t>(width);
+    ASSERT(rgba_data.size() == row_size * static_cast<size_t>(height))
+        << "Pixel data doesn't match image size " << width << "x" << height;
+
+    // Each row is prefixed with a filter type byte, 0 meaning no filtering
+    std::vector<uint8_t> raw_data((row_size + 1) * height);
+    for (size_t r = 0; r < static_cast<size_t>(height); r++)
+    {
+        raw_data[r * (row_size + 1)] = 0;
+        std::copy(rgba_data.begin() + r * row_size,
+                  rgba_data.begin() + (r + 1) * row_size,
+                  raw_data.begin() + r * (row_size + 1) + 1);
+    }
+
+    uLongf compressed_size = compressBound(raw_data.size());
+    std::vector<uint8_t> compressed_data(compressed_size);
+    if (compress2(compressed_data.data(),
+                  &compressed_size,
+                  raw_data.data(),
+                  raw_data.size(),
+                  compression_level) != Z_OK)
+    {
+        LOG_WARNING() << "Failed to compress image data for " << file_path;
+        return false;
+    }
+    compressed_data.resize(compressed_size);
+
+    std::ofstream file(file_path, std::ios::binary);
+    if (!file.is_open())
+    {
+        LOG_WARNING() << "Failed to open " << file_path << " for writing!";
+        return false;
+    }
+
+    const uint8_t png_signature[] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    file.write(reinterpret_cast<const char*>(png_signature), sizeof(png_signature));
+
+    std::vector<uint8_t> header_data;
+    appendUint32BigEndian(header_data, static_cast<uint32_t>(width));
+    appendUint32BigEndian(header_data, static_cast<uint32_t>(height));
+    header_data.push_back(8);  // Bit depth
+    header_data.push_back(6);  // Color type RGBA
+    header_data.push_back(0);  // Compression method
+    header_data.push_back(0);  // Filter method
+    header_data.push_back(0);  // Interlace method
+
+    writeChunk(file, "IHDR", header_data);
+    writeChunk(file, "IDAT", compressed_data);
+    writeChunk(file, "IEND", std::vector<uint8_t>());
+
+    return file.good();
+}
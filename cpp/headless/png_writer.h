@@ -0,0 +1,17 @@
+#ifndef PNG_WRITER_H_
+#define PNG_WRITER_H_
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+// Writes 8 bit RGBA pixels, top row first, to an (non interlaced) PNG file.
+// compression_level is passed on to zlib, where 1 is the fastest and 9 the smallest.
+bool writePng(const std::string& file_path,
+              const int width,
+              const int height,
+              const std::vector<uint8_t>& rgba_data,
+              const int compression_level = 1);
+
+#endif
@@ -37,6 +37,8 @@ MainWindow::MainWindow(const wxString& title)
     current_plot_window_.first = nullptr;
     current_plot_window_.second = 0;
 
+    memory_budget_ = new MemoryBudget();
+
     receive_thread_ = new std::thread(&MainWindow::receiverThreadFunction, this);
     figure_counter_ = 0;
 
@@ -112,7 +114,7 @@ void MainWindow::createNewPlotWindow(const size_t fig_num)
     }
     else
     {
-        PlotWindow* plot_window = new PlotWindow(this, fig_num);
+        PlotWindow* plot_window = new PlotWindow(this, fig_num, memory_budget_);
 
         plot_window->Show();
         const int window_id = plot_window->GetId();
@@ -139,7 +141,7 @@ void MainWindow::createNewPlotWindow()
         }
         new_figure_number++;
 
-        PlotWindow* plot_window = new PlotWindow(this, new_figure_number);
+        PlotWindow* plot_window = new PlotWindow(this, new_figure_number, memory_budget_);
 
         plot_window->Show();
         const int window_id = plot_window->GetId();
@@ -15,6 +15,7 @@
 
 #include "communication/rx_list.h"
 #include "communication/server.h"
+#include "main_application/memory_budget.h"
 #include "plot_window.h"
 
 /*
@@ -48,6 +49,9 @@ private:
     std::vector<std::pair<PlotWindow*, int>> plot_windows_;
     std::pair<PlotWindow*, int> current_plot_window_;
 
+    // Shared by the plot windows, which unregister from it when they are destroyed
+    MemoryBudget* memory_budget_;
+
     void onButtonPressed(wxCommandEvent& event);
     void onClearCommandButtonPressed(wxCommandEvent& event);
     void onNewWindowButtonPressed(wxCommandEvent& event);
@@ -61,6 +65,7 @@ private:
     int figure_counter_;
 
     void handleSentCommands();
+    void enforceMemoryBudget();
     bool figureWindowExists(const size_t fig_num) const;
     void createNewPlotWindow(const size_t fig_num);
     void createNewPlotWindow();
@@ -34,6 +34,16 @@ void MainWindow::handleSentCommands()
             createNewPlotWindow();
         }
     }
+    else if (function_type == Function::MEMORY_BUDGET)
+    {
+        memory_budget_->setBudget(rx_list_.getObjectData<MemoryBudgetRx>(),
+                                  rx_list_.getObjectData<EvictionPolicyRx>());
+        enforceMemoryBudget();
+    }
+    else if (function_type == Function::MEMORY_STATS)
+    {
+        memory_budget_->printStats();
+    }
     else
     {
         if (plot_windows_.size() == 0)
@@ -41,6 +51,19 @@ void MainWindow::handleSentCommands()
             createNewPlotWindow();
         }
         current_plot_window_.first->addData(rx_list_, receiver_buffer_pointers_);
+        enforceMemoryBudget();
+    }
+}
+
+void MainWindow::enforceMemoryBudget()
+{
+    // Objects may be removed from any figure, not only the current one
+    if (memory_budget_->enforce() > 0)
+    {
+        for (auto plot_window : plot_windows_)
+        {
+            plot_window.first->Refresh();
+        }
     }
 }
 
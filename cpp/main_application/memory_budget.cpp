@@ -0,0 +1,122 @@
+#include "main_application/memory_budget.h"
+
+#include <arl/utilities/logging.h>
+
+#include <algorithm>
+#include <limits>
+#include <string>
+
+#include "main_application/plot_data.h"
+
+using namespace plot_tool;
+
+MemoryBudget::MemoryBudget()
+    : max_num_bytes_(0), eviction_policy_(EvictionPolicy::LEAST_RECENTLY_USED), stamp_counter_(0)
+{
+}
+
+void MemoryBudget::setBudget(const size_t max_num_bytes, const EvictionPolicy eviction_policy)
+{
+    max_num_bytes_ = max_num_bytes;
+    eviction_policy_ = eviction_policy;
+}
+
+void MemoryBudget::registerHandler(PlotDataHandler* const handler, const size_t figure_number)
+{
+    handlers_.push_back(std::pair<PlotDataHandler*, size_t>(handler, figure_number));
+}
+
+void MemoryBudget::unregisterHandler(const PlotDataHandler* const handler)
+{
+    for (size_t k = 0; k < handlers_.size(); k++)
+    {
+        if (handlers_[k].first == handler)
+        {
+            handlers_.erase(handlers_.begin() + k);
+            break;
+        }
+    }
+}
+
+size_t MemoryBudget::nextStamp()
+{
+    stamp_counter_++;
+    return stamp_counter_;
+}
+
+size_t MemoryBudget::getNumBytes() const
+{
+    size_t num_bytes = 0;
+    for (size_t k = 0; k < handlers_.size(); k++)
+    {
+        num_bytes += handlers_[k].first->getNumBytes();
+    }
+    return num_bytes;
+}
+
+size_t MemoryBudget::enforce()
+{
+    if (max_num_bytes_ == 0)
+    {
+        return 0;
+    }
+
+    size_t newest_sequence_number = 0;
+    for (size_t k = 0; k < handlers_.size(); k++)
+    {
+        newest_sequence_number =
+            std::max(newest_sequence_number, handlers_[k].first->getNewestSequenceNumber());
+    }
+
+    size_t num_bytes = getNumBytes();
+    size_t num_removed = 0;
+
+    while (num_bytes > max_num_bytes_)
+    {
+        PlotDataHandler* evicted_handler = nullptr;
+        size_t evicted_idx = 0;
+        size_t smallest_stamp = std::numeric_limits<size_t>::max();
+
+        for (size_t k = 0; k < handlers_.size(); k++)
+        {
+            size_t idx;
+            size_t stamp;
+            if (handlers_[k].first->findEvictionCandidate(
+                    eviction_policy_, newest_sequence_number, idx, stamp) &&
+                (stamp < smallest_stamp))
+            {
+                smallest_stamp = stamp;
+                evicted_handler = handlers_[k].first;
+                evicted_idx = idx;
+            }
+        }
+
+        if (evicted_handler == nullptr)
+        {
+            LOG_WARNING() << "Memory budget of " << max_num_bytes_ << " bytes exceeded, "
+                          << num_bytes << " bytes are used by objects that can't be removed";
+            break;
+        }
+
+        num_bytes -= evicted_handler->removePlotObject(evicted_idx);
+        num_removed++;
+    }
+
+    return num_removed;
+}
+
+void MemoryBudget::printStats() const
+{
+    PRINT() << "Memory used by plot objects: " << getNumBytes() << " bytes, budget: "
+            << (max_num_bytes_ == 0 ? std::string("unlimited")
+                                    : std::to_string(max_num_bytes_) + " bytes");
+
+    for (size_t k = 0; k < handlers_.size(); k++)
+    {
+        const PlotDataHandler* const handler = handlers_[k].first;
+        PRINT() << "Figure " << handlers_[k].second << ": " << handler->getNumBytes()
+                << " bytes in " << handler->plot_datas_.size() << " objects ("
+                << handler->getNumPersistentObjects() << " persistent), "
+                << handler->getNumArenaBytes() << " bytes reserved by the arena";
+    }
+}
@@ -0,0 +1,42 @@
+#ifndef MEMORY_BUDGET_H_
+#define MEMORY_BUDGET_H_
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "communication/rx_list.h"
+
+class PlotDataHandler;
+
+// Limits the memory used by the plot objects of all figures. The plot data handler of each
+// figure registers itself, and enforce() removes non-persistent objects in the order given by
+// the eviction policy, until the total is within the budget.
+class MemoryBudget
+{
+private:
+    size_t max_num_bytes_;  // 0 means no limit
+    plot_tool::EvictionPolicy eviction_policy_;
+    size_t stamp_counter_;
+    std::vector<std::pair<PlotDataHandler*, size_t>> handlers_;  // Handler and figure number
+
+public:
+    MemoryBudget();
+
+    void setBudget(const size_t max_num_bytes, const plot_tool::EvictionPolicy eviction_policy);
+    void registerHandler(PlotDataHandler* const handler, const size_t figure_number);
+    void unregisterHandler(const PlotDataHandler* const handler);
+
+    // Increasing stamps, for the creation and the last use of plot objects
+    size_t nextStamp();
+
+    size_t getNumBytes() const;
+
+    // Returns the number of removed objects. The most recently added object is never removed,
+    // so that the latest plot command always shows something.
+    size_t enforce();
+
+    void printStats() const;
+};
+
+#endif
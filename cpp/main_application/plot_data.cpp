@@ -13,7 +13,29 @@
 using namespace plot_tool;
 using namespace arl;
 
-PlotDataHandler::PlotDataHandler() {}
+// Large enough for the data of most plot objects, small enough to not hold on to much memory
+// when a figure is cleared
+static constexpr size_t arena_block_size = 16 * 1024 * 1024;
+
+PlotDataHandler::PlotDataHandler() : memory_budget_(nullptr), arena_(arena_block_size) {}
+
+PlotDataHandler::~PlotDataHandler()
+{
+    // Objects have to be deleted before the arena they are allocated from
+    clear();
+
+    if (memory_budget_)
+    {
+        memory_budget_->unregisterHandler(this);
+    }
+}
+
+void PlotDataHandler::setMemoryBudget(MemoryBudget* const memory_budget,
+                                      const size_t figure_number)
+{
+    memory_budget_ = memory_budget;
+    memory_budget_->registerHandler(this, figure_number);
+}
 
 void PlotDataHandler::clear()
 {
@@ -22,6 +44,25 @@ void PlotDataHandler::clear()
         delete plot_datas_[k];
     }
     plot_datas_.clear();
+
+    scene_bounds_.clear();
+    bounds_slots_.clear();
+}
+
+void PlotDataHandler::addToSceneBounds(const PlotObjectBase* const plot_object)
+{
+    const std::pair<Vec3Dd, Vec3Dd> min_max = plot_object->getMinMaxVectors();
+    bounds_slots_.push_back(scene_bounds_.add(
+        min_max.first, min_max.second, plot_object->getNumDimensions() == 3));
+}
+
+void PlotDataHandler::updateSceneBounds(const size_t idx)
+{
+    const std::pair<Vec3Dd, Vec3Dd> min_max = plot_datas_[idx]->getMinMaxVectors();
+    scene_bounds_.update(bounds_slots_[idx],
+                         min_max.first,
+                         min_max.second,
+                         plot_datas_[idx]->getNumDimensions() == 3);
 }
 
 void PlotDataHandler::addData(const plot_tool::RxList& rx_list, const std::vector<char*> data_vec)
@@ -30,109 +71,165 @@ void PlotDataHandler::addData(const plot_tool::RxList& rx_list, const std::vecto
     switch (fcn_type)
     {
         case plot_tool::Function::PLOT2:
-            plot_datas_.push_back(dynamic_cast<PlotObjectBase*>(new Plot2D(rx_list, data_vec)));
+            plot_datas_.push_back(
+                dynamic_cast<PlotObjectBase*>(new Plot2D(rx_list, data_vec, &arena_)));
 
             break;
         case plot_tool::Function::PLOT3:
-            plot_datas_.push_back(dynamic_cast<PlotObjectBase*>(new Plot3D(rx_list, data_vec)));
+            plot_datas_.push_back(
+                dynamic_cast<PlotObjectBase*>(new Plot3D(rx_list, data_vec, &arena_)));
 
             break;
         case plot_tool::Function::SURF:
-            plot_datas_.push_back(dynamic_cast<PlotObjectBase*>(new Surf(rx_list, data_vec)));
+            plot_datas_.push_back(dynamic_cast<PlotObjectBase*>(
+                new Surf(rx_list, data_vec, custom_color_lut_, &arena_)));
 
             break;
         case plot_tool::Function::LINE3D:
-            plot_datas_.push_back(dynamic_cast<PlotObjectBase*>(new DrawLine3D(rx_list, data_vec)));
+            plot_datas_.push_back(
+                dynamic_cast<PlotObjectBase*>(new DrawLine3D(rx_list, data_vec, &arena_)));
 
             break;
         case plot_tool::Function::LINE_BETWEEN_POINTS_3D:
-            plot_datas_.push_back(
-                dynamic_cast<PlotObjectBase*>(new DrawLineBetweenPoints3D(rx_list, data_vec)));
+            plot_datas_.push_back(dynamic_cast<PlotObjectBase*>(
+                new DrawLineBetweenPoints3D(rx_list, data_vec, &arena_)));
 
             break;
         case plot_tool::Function::PLANE_XY:
             plot_datas_.push_back(
-                dynamic_cast<PlotObjectBase*>(new DrawPlaneXY(rx_list, data_vec)));
+                dynamic_cast<PlotObjectBase*>(new DrawPlaneXY(rx_list, data_vec, &arena_)));
 
             break;
         case plot_tool::Function::PLANE_XZ:
             plot_datas_.push_back(
-                dynamic_cast<PlotObjectBase*>(new DrawPlaneXZ(rx_list, data_vec)));
+                dynamic_cast<PlotObjectBase*>(new DrawPlaneXZ(rx_list, data_vec, &arena_)));
 
             break;
         case plot_tool::Function::PLANE_YZ:
             plot_datas_.push_back(
-                dynamic_cast<PlotObjectBase*>(new DrawPlaneYZ(rx_list, data_vec)));
+                dynamic_cast<PlotObjectBase*>(new DrawPlaneYZ(rx_list, data_vec, &arena_)));
 
             break;
         case plot_tool::Function::POLYGON_FROM_4_POINTS:
             plot_datas_.push_back(
-                dynamic_cast<PlotObjectBase*>(new DrawPolygon4Points(rx_list, data_vec)));
+                dynamic_cast<PlotObjectBase*>(new DrawPolygon4Points(rx_list, data_vec, &arena_)));
 
             break;
         case plot_tool::Function::SCATTER3:
-            plot_datas_.push_back(dynamic_cast<PlotObjectBase*>(new Scatter3D(rx_list, data_vec)));
+            plot_datas_.push_back(
+                dynamic_cast<PlotObjectBase*>(new Scatter3D(rx_list, data_vec, &arena_)));
 
             break;
         case plot_tool::Function::SCATTER2:
-            plot_datas_.push_back(dynamic_cast<PlotObjectBase*>(new Scatter2D(rx_list, data_vec)));
+            plot_datas_.push_back(
+                dynamic_cast<PlotObjectBase*>(new Scatter2D(rx_list, data_vec, &arena_)));
+
+            break;
+        case plot_tool::Function::SCOPE:
+            plot_datas_.push_back(
+                dynamic_cast<PlotObjectBase*>(new Scope(rx_list, data_vec, &arena_)));
 
             break;
         default:
             EXIT() << "Unsupported function!";
             break;
     }
+
+    addToSceneBounds(plot_datas_.back());
+
+    if (memory_budget_)
+    {
+        const size_t stamp = memory_budget_->nextStamp();
+        plot_datas_.back()->setSequenceNumber(stamp);
+        plot_datas_.back()->setLastUsed(stamp);
+    }
 }
 
-void PlotDataHandler::visualize() const
+void PlotDataHandler::pushToScope(const plot_tool::RxList& rx_list,
+                                  const std::vector<char*> data_vec)
 {
+    ASSERT(rx_list.getObjectData<FunctionRx>() == Function::SCOPE_PUSH);
+    ASSERT(rx_list.getObjectData<NumBuffersRequiredRx>() == 1);
+    ASSERT(rx_list.getObjectData<DataTypeRx>() == DataType::DOUBLE);
+
+    const size_t handle = rx_list.getObjectData<ScopeHandleRx>();
+
     for (size_t k = 0; k < plot_datas_.size(); k++)
     {
-        plot_datas_[k]->visualize();
+        Scope* const scope = dynamic_cast<Scope*>(plot_datas_[k]);
+        if (scope && (scope->getHandle() == handle))
+        {
+            scope->push(reinterpret_cast<const double*>(data_vec[0]),
+                        rx_list.getObjectData<NumElementsRx>());
+            updateSceneBounds(k);
+            return;
+        }
     }
+
+    LOG_WARNING() << "No scope with handle " << handle << " in the current figure!";
 }
 
-std::pair<Vec3Dd, Vec3Dd> PlotDataHandler::getMinMaxVectors() const
+void PlotDataHandler::setCustomColorLut(const plot_tool::RxList& rx_list,
+                                        const std::vector<char*> data_vec)
+{
+    ASSERT(rx_list.getObjectData<FunctionRx>() == Function::COLOR_MAP_LUT);
+    ASSERT(rx_list.getObjectData<NumBuffersRequiredRx>() == 3);
+    ASSERT(rx_list.getObjectData<DataTypeRx>() == DataType::DOUBLE);
+
+    const size_t num_colors = rx_list.getObjectData<NumElementsRx>();
+
+    custom_color_lut_ = ColorLut(reinterpret_cast<const double*>(data_vec[0]),
+                                 reinterpret_cast<const double*>(data_vec[1]),
+                                 reinterpret_cast<const double*>(data_vec[2]),
+                                 num_colors);
+}
+
+void PlotDataHandler::setIsInteracting(const bool is_interacting)
 {
-    if (plot_datas_.size() == 0)
+    for (size_t k = 0; k < plot_datas_.size(); k++)
     {
-        return std::pair<Vec3Dd, Vec3Dd>(Vec3Dd(-1, -1, -1), Vec3Dd(1, 1, 1));
+        plot_datas_[k]->setIsInteracting(is_interacting);
     }
-    else
-    {
-        const std::pair<Vec3Dd, Vec3Dd> min_max = plot_datas_[0]->getMinMaxVectors();
-        size_t num_dimensions = plot_datas_[0]->getNumDimensions();
-        Vec3Dd min_vec = min_max.first;
-        Vec3Dd max_vec = min_max.second;
+}
 
-        bool z_is_set = num_dimensions == 3 ? true : false;
+void PlotDataHandler::visualize() const
+{
+    const ProjectionState projection_state = getProjectionState();
 
-        for (size_t k = 1; k < plot_datas_.size(); k++)
-        {
-            const std::pair<Vec3Dd, Vec3Dd> current_min_max = plot_datas_[0]->getMinMaxVectors();
+    for (size_t k = 0; k < plot_datas_.size(); k++)
+    {
+        // Skip objects that are entirely outside of the axes box
+        const std::pair<Vec3Dd, Vec3Dd> min_max = plot_datas_[k]->getMinMaxVectors();
+        const bool is_2d = plot_datas_[k]->getNumDimensions() == 2;
+        const double box_min[3] = {min_max.first.x, min_max.first.y, is_2d ? 0.0 : min_max.first.z};
+        const double box_max[3] = {
+            min_max.second.x, min_max.second.y, is_2d ? 0.0 : min_max.second.z};
 
-            size_t current_num_dimensions = plot_datas_[k]->getNumDimensions();
-            num_dimensions = std::max(num_dimensions, current_num_dimensions);
+        if (getBoxVisibility(box_min, box_max, projection_state) != BoxVisibility::OUTSIDE)
+        {
+            plot_datas_[k]->visualize();
 
-            if (current_num_dimensions == 3)
+            if (memory_budget_)
             {
-                if (!z_is_set)
-                {
-                    min_vec.z = current_min_max.first.z;
-                    max_vec.z = current_min_max.second.z;
-                    z_is_set = true;
-                }
-                else
-                {
-                    min_vec.z = std::min(min_vec.z, current_min_max.first.z);
-                }
+                plot_datas_[k]->setLastUsed(memory_budget_->nextStamp());
             }
-
-            min_vec.x = std::min(min_vec.x, current_min_max.first.x);
-            min_vec.y = std::min(min_vec.y, current_min_max.first.y);
         }
+    }
+}
+
+std::pair<Vec3Dd, Vec3Dd> PlotDataHandler::getMinMaxVectors() const
+{
+    if (scene_bounds_.isEmpty())
+    {
+        return std::pair<Vec3Dd, Vec3Dd>(Vec3Dd(-1, -1, -1), Vec3Dd(1, 1, 1));
+    }
+    else
+    {
+        const std::pair<Vec3Dd, Vec3Dd> min_max = scene_bounds_.getMinMaxVectors();
+        Vec3Dd min_vec = min_max.first;
+        Vec3Dd max_vec = min_max.second;
 
-        if (num_dimensions == 2)
+        if (!scene_bounds_.hasZ())
         {
             min_vec.z = -1.0;
             max_vec.z = 1.0;
@@ -145,21 +242,24 @@ std::pair<Vec3Dd, Vec3Dd> PlotDataHandler::getMinMaxVectors() const
         const double largest_diff = arl::max(v);
 
         // If some of the axes turns out to have a very small difference
-        // between min and max, we have to modify this
+        // between min and max, we have to modify this. The axis is kept centered on the data.
+        const Vec3Dd center_vec(0.5 * (min_vec.x + max_vec.x),
+                                0.5 * (min_vec.y + max_vec.y),
+                                0.5 * (min_vec.z + max_vec.z));
         if (diff_vec.x < largest_diff * 0.01)
         {
-            min_vec.x = -largest_diff * 0.01;
-            max_vec.x = largest_diff * 0.01;
+            min_vec.x = center_vec.x - largest_diff * 0.01;
+            max_vec.x = center_vec.x + largest_diff * 0.01;
         }
         if (diff_vec.y < largest_diff * 0.01)
         {
-            min_vec.y = -largest_diff * 0.01;
-            max_vec.y = largest_diff * 0.01;
+            min_vec.y = center_vec.y - largest_diff * 0.01;
+            max_vec.y = center_vec.y + largest_diff * 0.01;
         }
         if (diff_vec.z < largest_diff * 0.01)
         {
-            min_vec.z = -largest_diff * 0.01;
-            max_vec.z = largest_diff * 0.01;
+            min_vec.z = center_vec.z - largest_diff * 0.01;
+            max_vec.z = center_vec.z + largest_diff * 0.01;
         }
 
         return std::pair<Vec3Dd, Vec3Dd>(min_vec, max_vec);
@@ -169,16 +269,93 @@ std::pair<Vec3Dd, Vec3Dd> PlotDataHandler::getMinMaxVectors() const
 void PlotDataHandler::softClear()
 {
     std::vector<PlotObjectBase*> new_plot_datas;
+    std::vector<size_t> new_bounds_slots;
     for (size_t k = 0; k < plot_datas_.size(); k++)
     {
         if (plot_datas_[k]->isPersistent())
         {
             new_plot_datas.push_back(plot_datas_[k]);
+            new_bounds_slots.push_back(bounds_slots_[k]);
         }
         else
         {
             delete plot_datas_[k];
+            scene_bounds_.remove(bounds_slots_[k]);
         }
     }
     plot_datas_ = new_plot_datas;
+    bounds_slots_ = new_bounds_slots;
+}
+
+size_t PlotDataHandler::getNumBytes() const
+{
+    size_t num_bytes = 0;
+    for (size_t k = 0; k < plot_datas_.size(); k++)
+    {
+        num_bytes += plot_datas_[k]->getNumBytes();
+    }
+    return num_bytes;
+}
+
+size_t PlotDataHandler::getNumArenaBytes() const
+{
+    return arena_.getNumReservedBytes();
+}
+
+size_t PlotDataHandler::getNumPersistentObjects() const
+{
+    size_t num_persistent = 0;
+    for (size_t k = 0; k < plot_datas_.size(); k++)
+    {
+        num_persistent += plot_datas_[k]->isPersistent() ? 1 : 0;
+    }
+    return num_persistent;
+}
+
+size_t PlotDataHandler::getNewestSequenceNumber() const
+{
+    size_t newest_sequence_number = 0;
+    for (size_t k = 0; k < plot_datas_.size(); k++)
+    {
+        newest_sequence_number =
+            std::max(newest_sequence_number, plot_datas_[k]->getSequenceNumber());
+    }
+    return newest_sequence_number;
+}
+
+bool PlotDataHandler::findEvictionCandidate(const EvictionPolicy eviction_policy,
+                                            const size_t newest_sequence_number,
+                                            size_t& idx,
+                                            size_t& stamp) const
+{
+    bool is_found = false;
+    for (size_t k = 0; k < plot_datas_.size(); k++)
+    {
+        if (plot_datas_[k]->isPersistent() ||
+            (plot_datas_[k]->getSequenceNumber() == newest_sequence_number))
+        {
+            continue;
+        }
+
+        const size_t current_stamp = eviction_policy == EvictionPolicy::LEAST_RECENTLY_USED
+                                         ? plot_datas_[k]->getLastUsed()
+                                         : plot_datas_[k]->getSequenceNumber();
+        if (!is_found || (current_stamp < stamp))
+        {
+            idx = k;
+            stamp = current_stamp;
+            is_found = true;
+        }
+    }
+    return is_found;
+}
+
+size_t PlotDataHandler::removePlotObject(const size_t idx)
+{
+    const size_t num_bytes = plot_datas_[idx]->getNumBytes();
+    delete plot_datas_[idx];
+    plot_datas_.erase(plot_datas_.begin() + idx);
+    scene_bounds_.remove(bounds_slots_[idx]);
+    bounds_slots_.erase(bounds_slots_.begin() + idx);
+    return num_bytes;
 }
@@ -7,21 +7,55 @@
 #include <vector>
 
 #include "communication/rx_list.h"
+#include "main_application/memory_budget.h"
+#include "main_application/scene_bounds.h"
+#include "misc/block_arena.h"
 #include "opengl_low_level/data_structures.h"
+#include "plot_functions/color_lut.h"
 
 class PlotObjectBase;
 
 class PlotDataHandler
 {
 private:
+    ColorLut custom_color_lut_;
+    MemoryBudget* memory_budget_;
+    BlockArena arena_;  // Data of the plot objects, except for persistent ones
+
+    // Bounds of all objects, kept up to date as objects are added and removed. bounds_slots_
+    // has the slot in scene_bounds_ of each object in plot_datas_.
+    SceneBounds scene_bounds_;
+    std::vector<size_t> bounds_slots_;
+
+    void addToSceneBounds(const PlotObjectBase* const plot_object);
+    void updateSceneBounds(const size_t idx);
+
 public:
     std::pair<arl::Vec3Dd, arl::Vec3Dd> getMinMaxVectors() const;
     std::vector<PlotObjectBase*> plot_datas_;
     PlotDataHandler();
+    ~PlotDataHandler();
     void clear();
     void softClear();
     void addData(const plot_tool::RxList& rx_list, const std::vector<char*> data_vec);
+    void pushToScope(const plot_tool::RxList& rx_list, const std::vector<char*> data_vec);
+    void setCustomColorLut(const plot_tool::RxList& rx_list, const std::vector<char*> data_vec);
+    void setIsInteracting(const bool is_interacting);
     void visualize() const;
+
+    void setMemoryBudget(MemoryBudget* const memory_budget, const size_t figure_number);
+    size_t getNumBytes() const;
+    size_t getNumArenaBytes() const;
+    size_t getNumPersistentObjects() const;
+    size_t getNewestSequenceNumber() const;
+    // Finds the non-persistent object that should be evicted first, other than the one with
+    // sequence number newest_sequence_number. Returns false if there is none.
+    bool findEvictionCandidate(const plot_tool::EvictionPolicy eviction_policy,
+                               const size_t newest_sequence_number,
+                               size_t& idx,
+                               size_t& stamp) const;
+    // Returns the number of bytes freed
+    size_t removePlotObject(const size_t idx);
 };
 
 #endif
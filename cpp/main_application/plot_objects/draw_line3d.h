@@ -26,13 +26,17 @@ private:
 
 public:
     DrawLine3D();
-    DrawLine3D(const plot_tool::RxList& rx_list, const std::vector<char*> data_vec);
+    DrawLine3D(const plot_tool::RxList& rx_list,
+               const std::vector<char*> data_vec,
+               BlockArena* const arena);
 
     void visualize() const override;
 };
 
-DrawLine3D::DrawLine3D(const plot_tool::RxList& rx_list, const std::vector<char*> data_vec)
-    : PlotObjectBase(rx_list, data_vec)
+DrawLine3D::DrawLine3D(const plot_tool::RxList& rx_list,
+                       const std::vector<char*> data_vec,
+                       BlockArena* const arena)
+    : PlotObjectBase(rx_list, data_vec, arena)
 {
     // num_elements is actual number of elements, not number of bytes
     ASSERT(rx_list.getObjectData<FunctionRx>() == Function::LINE3D);
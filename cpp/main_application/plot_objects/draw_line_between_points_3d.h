@@ -27,14 +27,17 @@ private:
 
 public:
     DrawLineBetweenPoints3D();
-    DrawLineBetweenPoints3D(const plot_tool::RxList& rx_list, const std::vector<char*> data_vec);
+    DrawLineBetweenPoints3D(const plot_tool::RxList& rx_list,
+                            const std::vector<char*> data_vec,
+                            BlockArena* const arena);
 
     void visualize() const override;
 };
 
 DrawLineBetweenPoints3D::DrawLineBetweenPoints3D(const plot_tool::RxList& rx_list,
-                                                 const std::vector<char*> data_vec)
-    : PlotObjectBase(rx_list, data_vec)
+                                                 const std::vector<char*> data_vec,
+                                                 BlockArena* const arena)
+    : PlotObjectBase(rx_list, data_vec, arena)
 {
     // num_elements is actual number of elements, not number of bytes
     ASSERT(rx_list.getObjectData<FunctionRx>() == Function::LINE_BETWEEN_POINTS_3D);
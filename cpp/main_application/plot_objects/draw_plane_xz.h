@@ -27,13 +27,17 @@ private:
 
 public:
     DrawPlaneXZ();
-    DrawPlaneXZ(const plot_tool::RxList& rx_list, const std::vector<char*> data_vec);
+    DrawPlaneXZ(const plot_tool::RxList& rx_list,
+                const std::vector<char*> data_vec,
+                BlockArena* const arena);
 
     void visualize() const override;
 };
 
-DrawPlaneXZ::DrawPlaneXZ(const plot_tool::RxList& rx_list, const std::vector<char*> data_vec)
-    : PlotObjectBase(rx_list, data_vec)
+DrawPlaneXZ::DrawPlaneXZ(const plot_tool::RxList& rx_list,
+                         const std::vector<char*> data_vec,
+                         BlockArena* const arena)
+    : PlotObjectBase(rx_list, data_vec, arena)
 {
     ASSERT(rx_list.getObjectData<FunctionRx>() == Function::PLANE_XZ);
     ASSERT(rx_list.getObjectData<NumBuffersRequiredRx>() == 1);
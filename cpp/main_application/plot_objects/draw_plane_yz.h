@@ -27,13 +27,17 @@ private:
 
 public:
     DrawPlaneYZ();
-    DrawPlaneYZ(const plot_tool::RxList& rx_list, const std::vector<char*> data_vec);
+    DrawPlaneYZ(const plot_tool::RxList& rx_list,
+                const std::vector<char*> data_vec,
+                BlockArena* const arena);
 
     void visualize() const override;
 };
 
-DrawPlaneYZ::DrawPlaneYZ(const plot_tool::RxList& rx_list, const std::vector<char*> data_vec)
-    : PlotObjectBase(rx_list, data_vec)
+DrawPlaneYZ::DrawPlaneYZ(const plot_tool::RxList& rx_list,
+                         const std::vector<char*> data_vec,
+                         BlockArena* const arena)
+    : PlotObjectBase(rx_list, data_vec, arena)
 {
     ASSERT(rx_list.getObjectData<FunctionRx>() == Function::PLANE_YZ);
     ASSERT(rx_list.getObjectData<NumBuffersRequiredRx>() == 1);
@@ -30,14 +30,17 @@ private:
 
 public:
     DrawPolygon4Points();
-    DrawPolygon4Points(const plot_tool::RxList& rx_list, const std::vector<char*> data_vec);
+    DrawPolygon4Points(const plot_tool::RxList& rx_list,
+                       const std::vector<char*> data_vec,
+                       BlockArena* const arena);
 
     void visualize() const override;
 };
 
 DrawPolygon4Points::DrawPolygon4Points(const plot_tool::RxList& rx_list,
-                                       const std::vector<char*> data_vec)
-    : PlotObjectBase(rx_list, data_vec)
+                                       const std::vector<char*> data_vec,
+                                       BlockArena* const arena)
+    : PlotObjectBase(rx_list, data_vec, arena)
 {
     // num_elements is actual number of elements, not number of bytes
     ASSERT(rx_list.getObjectData<FunctionRx>() == Function::POLYGON_FROM_4_POINTS);
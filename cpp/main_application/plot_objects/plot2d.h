@@ -3,14 +3,20 @@
 
 #include <arl/math/math.h>
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
 #include "communication/rx_list.h"
 #include "main_application/plot_objects/plot_object_base.h"
+#include "misc/thread_pool.h"
 #include "opengl_low_level/data_structures.h"
 #include "opengl_low_level/opengl_low_level.h"
+#include "plot_functions/chunk_bounds.h"
+#include "plot_functions/line_batch.h"
+#include "plot_functions/line_decimation.h"
 #include "plot_functions/plot_functions.h"
+#include "plot_functions/sorted_line_window.h"
 
 using namespace plot_tool;
 
@@ -20,20 +26,37 @@ private:
     size_t num_elements_;
     float line_width_;
 
-    arl::Vectord x_vec, y_vec;
+    // Wide or dashed lines, updated in visualize whenever the view changes
+    mutable LineBatch line_batch_;
 
-    void findMinMax();
+    // With monotonic x, only the visible part is drawn, decimated to min/max per pixel column
+    bool is_x_monotonic_;
+    bool is_x_ascending_;
+    mutable SortedLineWindow sorted_line_window_;
+    mutable LineDecimation line_decimation_;
+    // Otherwise chunks outside of the axes box are skipped
+    mutable ChunkBounds chunk_bounds_;
+
+    template <typename T> void findMinMax();
+    template <typename T> void visualizeData() const;
+    template <typename T>
+    void drawLines(const T* const x_values,
+                   const T* const y_values,
+                   const size_t num_values) const;
 
 public:
     Plot2D();
-    Plot2D(const plot_tool::RxList& rx_list, const std::vector<char*> data_vec);
-    ~Plot2D();
+    Plot2D(const plot_tool::RxList& rx_list,
+           const std::vector<char*> data_vec,
+           BlockArena* const arena);
 
     void visualize() const override;
 };
 
-Plot2D::Plot2D(const plot_tool::RxList& rx_list, const std::vector<char*> data_vec)
-    : PlotObjectBase(rx_list, data_vec)
+Plot2D::Plot2D(const plot_tool::RxList& rx_list,
+               const std::vector<char*> data_vec,
+               BlockArena* const arena)
+    : PlotObjectBase(rx_list, data_vec, arena, true)
 {
     // num_elements is actual number of elements, not number of bytes
     ASSERT(rx_list.getObjectData<FunctionRx>() == Function::PLOT2);
@@ -42,38 +65,143 @@ Plot2D::Plot2D(const plot_tool::RxList& rx_list, const std::vector<char*> data_v
 
     num_elements_ = rx_list.getObjectData<NumElementsRx>();
 
-    x_vec.setInternalData(reinterpret_cast<double*>(data_[0]), num_elements_);
-    y_vec.setInternalData(reinterpret_cast<double*>(data_[1]), num_elements_);
-
     line_width_ =
         rx_list.hasKey(Command::LINEWIDTH) ? rx_list.getObjectData<LinewidthRx>().data : 1.0f;
-
-    findMinMax();
+    line_batch_ = LineBatch(rx_list.hasKey(Command::LINE_STYLE)
+                                ? rx_list.getObjectData<LineStyleRx>()
+                                : LineStyle("-"),
+                            line_width_);
+
+    if (is_single_precision_)
+    {
+        findMinMax<float>();
+    }
+    else
+    {
+        findMinMax<double>();
+    }
 }
 
-void Plot2D::findMinMax()
+// Finds min and max, and if x is monotonic, in a single pass over the data
+template <typename T> void Plot2D::findMinMax()
 {
-    ASSERT(x_vec.isAllocated()) << "Vector not allocated when checking min/max!";
-    ASSERT(y_vec.isAllocated()) << "Vector not allocated when checking min/max!";
-
-    min_vec.x = arl::min(x_vec);
-    min_vec.y = arl::min(y_vec);
-
-    max_vec.x = arl::max(x_vec);
-    max_vec.y = arl::max(y_vec);
+    const T* const x_values = reinterpret_cast<T*>(data_[0]);
+    const T* const y_values = reinterpret_cast<T*>(data_[1]);
+
+    is_x_monotonic_ = false;
+    is_x_ascending_ = false;
+    if (num_elements_ == 0)
+    {
+        return;
+    }
+
+    T x_min = x_values[0], x_max = x_values[0];
+    T y_min = y_values[0], y_max = y_values[0];
+    bool is_ascending = true, is_descending = true;
+    for (size_t k = 1; k < num_elements_; k++)
+    {
+        is_ascending = is_ascending && (x_values[k - 1] <= x_values[k]);
+        is_descending = is_descending && (x_values[k - 1] >= x_values[k]);
+        x_min = std::min(x_min, x_values[k]);
+        x_max = std::max(x_max, x_values[k]);
+        y_min = std::min(y_min, y_values[k]);
+        y_max = std::max(y_max, y_values[k]);
+    }
+
+    is_x_monotonic_ = is_ascending || is_descending;
+    is_x_ascending_ = is_ascending;
+
+    if (!is_x_monotonic_)
+    {
+        chunk_bounds_ =
+            ChunkBounds(x_values, y_values, static_cast<T*>(nullptr), num_elements_, true);
+    }
+
+    // Single precision min and max are found in absolute coordinates while converting
+    if (!is_single_precision_)
+    {
+        min_vec.x = x_min;
+        min_vec.y = y_min;
+        max_vec.x = x_max;
+        max_vec.y = y_max;
+    }
 }
 
 void Plot2D::visualize() const
 {
     setColor(color_);
-    setLinewidth(line_width_);
-    plot(x_vec, y_vec);
+    if (is_single_precision_)
+    {
+        pushDataOffset();
+        visualizeData<float>();
+        popDataOffset();
+    }
+    else
+    {
+        visualizeData<double>();
+    }
+}
+
+template <typename T> void Plot2D::visualizeData() const
+{
+    const T* const x_values = reinterpret_cast<T*>(data_[0]);
+    const T* const y_values = reinterpret_cast<T*>(data_[1]);
+
+    if (is_x_monotonic_)
+    {
+        // The y range is in the coordinates of the data, which are relative with single precision
+        sorted_line_window_.update(x_values,
+                                   num_elements_,
+                                   is_x_ascending_,
+                                   min_vec.y - data_offset_.y,
+                                   max_vec.y - data_offset_.y);
+        const size_t idx_begin = sorted_line_window_.getBegin();
+        const size_t num_visible = sorted_line_window_.getEnd() - idx_begin;
+
+        line_decimation_.update(
+            x_values + idx_begin, y_values + idx_begin, num_visible, getDefaultThreadPool());
+        if (line_decimation_.isDecimated())
+        {
+            drawLines(line_decimation_.getXValues().data(),
+                      line_decimation_.getYValues().data(),
+                      line_decimation_.getXValues().size());
+        }
+        else
+        {
+            drawLines(x_values + idx_begin, y_values + idx_begin, num_visible);
+        }
+    }
+    else
+    {
+        drawLines(x_values, y_values, num_elements_);
+    }
 }
 
-Plot2D::~Plot2D()
+template <typename T>
+void Plot2D::drawLines(const T* const x_values,
+                       const T* const y_values,
+                       const size_t num_values) const
 {
-    x_vec.setInternalData(nullptr, 0);  // Hack
-    y_vec.setInternalData(nullptr, 0);
+    if (line_batch_.isNeeded())
+    {
+        line_batch_.update<T>(x_values, y_values, nullptr, num_values, getDefaultThreadPool());
+        setLinewidth(1.0f);
+        line_batch_.draw();
+    }
+    else if (is_x_monotonic_)
+    {
+        setLinewidth(line_width_);
+        drawLineStrip2D(x_values, y_values, num_values);
+    }
+    else
+    {
+        setLinewidth(line_width_);
+        for (const std::pair<size_t, size_t>& range : chunk_bounds_.getVisibleRanges())
+        {
+            drawLineStrip2D(
+                x_values + range.first, y_values + range.first, range.second - range.first);
+        }
+    }
 }
 
 #endif
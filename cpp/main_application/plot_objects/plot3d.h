@@ -8,9 +8,12 @@
 
 #include "communication/rx_list.h"
 #include "main_application/plot_objects/plot_object_base.h"
+#include "misc/thread_pool.h"
 #include "opengl_low_level/data_structures.h"
 #include "opengl_low_level/opengl_low_level.h"
+#include "plot_functions/line_batch.h"
 #include "plot_functions/plot_functions.h"
+#include "plot_functions/point_octree.h"
 
 using namespace plot_tool;
 
@@ -20,20 +23,32 @@ private:
     size_t num_elements_;
     float line_width_;
 
+    // Wide or dashed lines, updated in visualize whenever the view changes
+    mutable LineBatch line_batch_;
+
+    // Thin lines are drawn from the octree, with culling, once it has been built
+    mutable AsyncPointOctree octree_;
+
     arl::Vectord x_vec, y_vec, z_vec;
 
     void findMinMax();
+    template <typename T> void visualizeData() const;
 
 public:
     Plot3D();
-    Plot3D(const plot_tool::RxList& rx_list, const std::vector<char*> data_vec);
+    Plot3D(const plot_tool::RxList& rx_list,
+           const std::vector<char*> data_vec,
+           BlockArena* const arena);
     ~Plot3D();
 
     void visualize() const override;
+    size_t getNumBytes() const override;
 };
 
-Plot3D::Plot3D(const plot_tool::RxList& rx_list, const std::vector<char*> data_vec)
-    : PlotObjectBase(rx_list, data_vec)
+Plot3D::Plot3D(const plot_tool::RxList& rx_list,
+               const std::vector<char*> data_vec,
+               BlockArena* const arena)
+    : PlotObjectBase(rx_list, data_vec, arena, true)
 {
     // num_elements is actual number of elements, not number of bytes
     ASSERT(rx_list.getObjectData<FunctionRx>() == Function::PLOT3);
@@ -44,12 +59,34 @@ Plot3D::Plot3D(const plot_tool::RxList& rx_list, const std::vector<char*> data_v
 
     line_width_ =
         rx_list.hasKey(Command::LINEWIDTH) ? rx_list.getObjectData<LinewidthRx>().data : 1.0f;
-
-    x_vec.setInternalData(reinterpret_cast<double*>(data_[0]), num_elements_);
-    y_vec.setInternalData(reinterpret_cast<double*>(data_[1]), num_elements_);
-    z_vec.setInternalData(reinterpret_cast<double*>(data_[2]), num_elements_);
-
-    findMinMax();
+    line_batch_ = LineBatch(rx_list.hasKey(Command::LINE_STYLE)
+                                ? rx_list.getObjectData<LineStyleRx>()
+                                : LineStyle("-"),
+                            line_width_);
+
+    if (is_single_precision_)
+    {
+        octree_ = AsyncPointOctree(reinterpret_cast<float*>(data_[0]),
+                                   reinterpret_cast<float*>(data_[1]),
+                                   reinterpret_cast<float*>(data_[2]),
+                                   num_elements_,
+                                   PointOctree::PrimitiveType::LINE_STRIP);
+    }
+    else
+    {
+        x_vec.setInternalData(reinterpret_cast<double*>(data_[0]), num_elements_);
+        y_vec.setInternalData(reinterpret_cast<double*>(data_[1]), num_elements_);
+        z_vec.setInternalData(reinterpret_cast<double*>(data_[2]), num_elements_);
+
+        octree_ = AsyncPointOctree(reinterpret_cast<double*>(data_[0]),
+                                   reinterpret_cast<double*>(data_[1]),
+                                   reinterpret_cast<double*>(data_[2]),
+                                   num_elements_,
+                                   PointOctree::PrimitiveType::LINE_STRIP);
+
+        // Single precision min and max are found while converting
+        findMinMax();
+    }
 }
 
 void Plot3D::findMinMax()
@@ -67,11 +104,50 @@ void Plot3D::findMinMax()
     max_vec.z = arl::max(z_vec);
 }
 
+size_t Plot3D::getNumBytes() const
+{
+    return PlotObjectBase::getNumBytes() + octree_.getNumBytes();
+}
+
 void Plot3D::visualize() const
 {
     setColor(color_);
-    setLinewidth(line_width_);
-    plot3(x_vec, y_vec, z_vec);
+    if (is_single_precision_)
+    {
+        pushDataOffset();
+        visualizeData<float>();
+        popDataOffset();
+    }
+    else
+    {
+        visualizeData<double>();
+    }
+}
+
+template <typename T> void Plot3D::visualizeData() const
+{
+    const T* const x_values = reinterpret_cast<T*>(data_[0]);
+    const T* const y_values = reinterpret_cast<T*>(data_[1]);
+    const T* const z_values = reinterpret_cast<T*>(data_[2]);
+
+    if (line_batch_.isNeeded())
+    {
+        line_batch_.update(x_values, y_values, z_values, num_elements_, getDefaultThreadPool());
+        setLinewidth(1.0f);
+        line_batch_.draw();
+    }
+    else
+    {
+        setLinewidth(line_width_);
+        if (PointOctree* const octree = octree_.get())
+        {
+            octree->draw(is_interacting_);
+        }
+        else
+        {
+            drawLineStrip3D(x_values, y_values, z_values, num_elements_);
+        }
+    }
 }
 
 Plot3D::~Plot3D()
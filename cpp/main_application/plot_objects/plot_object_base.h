@@ -3,10 +3,12 @@
 
 #include <arl/math/math.h>
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
 #include "communication/rx_list.h"
+#include "misc/block_arena.h"
 #include "opengl_low_level/data_structures.h"
 #include "opengl_low_level/opengl_low_level.h"
 #include "plot_functions/plot_functions.h"
@@ -18,6 +20,7 @@ class PlotObjectBase
 private:
 protected:
     std::vector<char*> data_;
+    BlockArena* arena_;  // Where data_ is allocated from, nullptr if from the heap
     size_t num_bytes_;
     size_t num_buffers_required_;
     size_t num_bytes_per_element_;
@@ -27,6 +30,16 @@ protected:
     DataStructure data_structure_;  // vector, matrix, image etc.
     Function function_;
     bool is_persistent_;
+    bool is_interacting_;  // If the view is being changed, objects may be drawn simplified
+
+    // Double data received with SinglePrecision is stored as float, relative to data_offset_,
+    // which is the center of the data and is added back by the modelview when drawing
+    bool is_single_precision_;
+    arl::Vec3Dd data_offset_;
+
+    // Stamps from the memory budget, for choosing which objects to evict
+    size_t sequence_number_;
+    size_t last_used_;
 
     arl::Vec3Dd min_vec;
     arl::Vec3Dd max_vec;
@@ -35,15 +48,29 @@ protected:
 
     RGBTripletf color_;
 
+    void pushDataOffset() const;
+    void popDataOffset() const;
+
 public:
     size_t getNumDimensions() const;
     virtual ~PlotObjectBase();
     PlotObjectBase();
-    PlotObjectBase(const plot_tool::RxList& rx_list, const std::vector<char*> data_vec);
+    PlotObjectBase(const plot_tool::RxList& rx_list,
+                   const std::vector<char*> data_vec,
+                   BlockArena* const arena,
+                   const bool allow_single_precision = false);
     virtual void visualize() const = 0;
     std::pair<arl::Vec3Dd, arl::Vec3Dd> getMinMaxVectors() const;
     bool isPersistent() const;
+    void setIsInteracting(const bool is_interacting);
     Name getName() const;
+
+    // Memory of the data buffers, objects with derived data structures add those
+    virtual size_t getNumBytes() const;
+    size_t getSequenceNumber() const;
+    void setSequenceNumber(const size_t sequence_number);
+    size_t getLastUsed() const;
+    void setLastUsed(const size_t last_used);
 };
 
 bool PlotObjectBase::isPersistent() const
@@ -51,24 +78,77 @@ bool PlotObjectBase::isPersistent() const
     return is_persistent_;
 }
 
+void PlotObjectBase::setIsInteracting(const bool is_interacting)
+{
+    is_interacting_ = is_interacting;
+}
+
 Name PlotObjectBase::getName() const
 {
     return name_;
 }
 
+size_t PlotObjectBase::getNumBytes() const
+{
+    return num_bytes_ * data_.size();
+}
+
+size_t PlotObjectBase::getSequenceNumber() const
+{
+    return sequence_number_;
+}
+
+void PlotObjectBase::setSequenceNumber(const size_t sequence_number)
+{
+    sequence_number_ = sequence_number;
+}
+
+size_t PlotObjectBase::getLastUsed() const
+{
+    return last_used_;
+}
+
+void PlotObjectBase::setLastUsed(const size_t last_used)
+{
+    last_used_ = last_used;
+}
+
 std::pair<arl::Vec3Dd, arl::Vec3Dd> PlotObjectBase::getMinMaxVectors() const
 {
     return std::pair<arl::Vec3Dd, arl::Vec3Dd>(min_vec, max_vec);
 }
 
+void PlotObjectBase::pushDataOffset() const
+{
+    glPushMatrix();
+    glTranslated(data_offset_.x, data_offset_.y, data_offset_.z);
+}
+
+void PlotObjectBase::popDataOffset() const
+{
+    glPopMatrix();
+}
+
 size_t PlotObjectBase::getNumDimensions() const
 {
     return num_buffers_required_;
 }
 
-PlotObjectBase::PlotObjectBase() {}
+PlotObjectBase::PlotObjectBase()
+    : arena_(nullptr),
+      num_bytes_(0),
+      is_interacting_(false),
+      is_single_precision_(false),
+      data_offset_(0.0, 0.0, 0.0),
+      sequence_number_(0),
+      last_used_(0)
+{
+}
 
-PlotObjectBase::PlotObjectBase(const plot_tool::RxList& rx_list, const std::vector<char*> data_vec)
+PlotObjectBase::PlotObjectBase(const plot_tool::RxList& rx_list,
+                               const std::vector<char*> data_vec,
+                               BlockArena* const arena,
+                               const bool allow_single_precision)
 {
     type_ = rx_list.getObjectData<FunctionRx>();
     num_bytes_ = rx_list.getObjectData<NumBytesRx>();
@@ -76,19 +156,76 @@ PlotObjectBase::PlotObjectBase(const plot_tool::RxList& rx_list, const std::vect
     num_bytes_per_element_ = rx_list.getObjectData<BytesPerElementRx>();
     data_type_ = rx_list.getObjectData<DataTypeRx>();
 
+    is_persistent_ = rx_list.hasKey(Command::PERSISTENT) ? true : false;
+
+    // Persistent objects outlive soft clears, so they would keep arena blocks from being reused
+    arena_ = is_persistent_ ? nullptr : arena;
+
+    is_single_precision_ = allow_single_precision &&
+                           rx_list.hasKey(Command::SINGLE_PRECISION) &&
+                           (data_type_ == DataType::DOUBLE);
+    data_offset_ = arl::Vec3Dd(0.0, 0.0, 0.0);
+
+    // Buffers 0, 1 and 2 are x, y and z. Their min and max are found here, since the
+    // offset has to be known before converting.
+    double* const min_values[3] = {&min_vec.x, &min_vec.y, &min_vec.z};
+    double* const max_values[3] = {&max_vec.x, &max_vec.y, &max_vec.z};
+    double* const offsets[3] = {&data_offset_.x, &data_offset_.y, &data_offset_.z};
+    const size_t num_elements = num_bytes_ / sizeof(double);
+    if (is_single_precision_)
+    {
+        for (size_t k = 0; k < std::min(num_buffers_required_, size_t(3)); k++)
+        {
+            const double* const values = reinterpret_cast<const double*>(data_vec[k]);
+            const auto min_max = std::minmax_element(values, values + num_elements);
+            if (num_elements > 0)
+            {
+                *min_values[k] = *min_max.first;
+                *max_values[k] = *min_max.second;
+                *offsets[k] = 0.5 * (*min_max.first + *min_max.second);
+            }
+        }
+
+        num_bytes_ = num_elements * sizeof(float);
+        num_bytes_per_element_ = sizeof(float);
+        data_type_ = DataType::FLOAT;
+    }
+
+    // All buffers are allocated at once from the arena
+    const size_t buffer_stride =
+        ((num_bytes_ + BlockArena::alignment - 1) / BlockArena::alignment) * BlockArena::alignment;
+    char* const arena_data = (arena_ && (num_buffers_required_ > 0))
+                                 ? arena_->allocate(buffer_stride * num_buffers_required_)
+                                 : nullptr;
+
     for (size_t k = 0; k < num_buffers_required_; k++)
     {
-        char* new_data = new char[num_bytes_];
+        char* new_data = arena_ ? arena_data + k * buffer_stride : new char[num_bytes_];
         char* incoming_data = data_vec[k];
 
-        for (size_t i = 0; i < num_bytes_; i++)
+        if (is_single_precision_)
         {
-            new_data[i] = incoming_data[i];
+            const double* const src = reinterpret_cast<const double*>(incoming_data);
+            float* const dst = reinterpret_cast<float*>(new_data);
+            const double offset = k < 3 ? *offsets[k] : 0.0;
+            for (size_t i = 0; i < num_elements; i++)
+            {
+                dst[i] = static_cast<float>(src[i] - offset);
+            }
+        }
+        else
+        {
+            for (size_t i = 0; i < num_bytes_; i++)
+            {
+                new_data[i] = incoming_data[i];
+            }
         }
         data_.push_back(new_data);
     }
 
-    is_persistent_ = rx_list.hasKey(Command::PERSISTENT) ? true : false;
+    is_interacting_ = false;
+    sequence_number_ = 0;
+    last_used_ = 0;
 
     name_ = rx_list.hasKey(Command::NAME) ? rx_list.getObjectData<NameRx>() : Name("");
 
@@ -105,9 +242,19 @@ PlotObjectBase::PlotObjectBase(const plot_tool::RxList& rx_list, const std::vect
 
 PlotObjectBase::~PlotObjectBase()
 {
-    for (size_t k = 0; k < data_.size(); k++)
+    if (arena_)
     {
-        delete[] data_[k];
+        if (!data_.empty())
+        {
+            arena_->release(data_[0]);
+        }
+    }
+    else
+    {
+        for (size_t k = 0; k < data_.size(); k++)
+        {
+            delete[] data_[k];
+        }
     }
 }
 
@@ -14,6 +14,7 @@
 #include "main_application/plot_objects/draw_plane_xy.h"
 #include "main_application/plot_objects/draw_plane_xz.h"
 #include "main_application/plot_objects/draw_plane_yz.h"
+#include "main_application/plot_objects/scope.h"
 
 // clang-format on
 
@@ -8,9 +8,12 @@
 
 #include "communication/rx_list.h"
 #include "main_application/plot_objects/plot_object_base.h"
+#include "misc/thread_pool.h"
 #include "opengl_low_level/data_structures.h"
 #include "opengl_low_level/opengl_low_level.h"
+#include "plot_functions/chunk_bounds.h"
 #include "plot_functions/plot_functions.h"
+#include "plot_functions/scatter_markers.h"
 
 using namespace plot_tool;
 
@@ -19,21 +22,33 @@ class Scatter2D : public PlotObjectBase
 private:
     size_t num_elements_;
     float point_size_;
+    int marker_type_;
+
+    // Updated in visualize, whenever the view changes
+    mutable MarkerBatch marker_batch_;
+
+    // For skipping chunks outside of the axes box
+    mutable ChunkBounds chunk_bounds_;
 
     arl::Vectord x_vec, y_vec;
 
     void findMinMax();
+    template <typename T> void visualizeData() const;
 
 public:
     Scatter2D();
-    Scatter2D(const plot_tool::RxList& rx_list, const std::vector<char*> data_vec);
+    Scatter2D(const plot_tool::RxList& rx_list,
+              const std::vector<char*> data_vec,
+              BlockArena* const arena);
     ~Scatter2D();
 
     void visualize() const override;
 };
 
-Scatter2D::Scatter2D(const plot_tool::RxList& rx_list, const std::vector<char*> data_vec)
-    : PlotObjectBase(rx_list, data_vec)
+Scatter2D::Scatter2D(const plot_tool::RxList& rx_list,
+                     const std::vector<char*> data_vec,
+                     BlockArena* const arena)
+    : PlotObjectBase(rx_list, data_vec, arena, true)
 {
     // num_elements is actual number of elements, not number of bytes
     ASSERT(rx_list.getObjectData<FunctionRx>() == Function::SCATTER2);
@@ -43,32 +58,94 @@ Scatter2D::Scatter2D(const plot_tool::RxList& rx_list, const std::vector<char*>
     num_elements_ = rx_list.getObjectData<NumElementsRx>();
     point_size_ =
         rx_list.hasKey(Command::POINT_SIZE) ? rx_list.getObjectData<PointSizeRx>().data : 1.0f;
-
-    x_vec.setInternalData(reinterpret_cast<double*>(data_[0]), num_elements_);
-    y_vec.setInternalData(reinterpret_cast<double*>(data_[1]), num_elements_);
+    marker_type_ = rx_list.hasKey(Command::MARKER_TYPE)
+                       ? rx_list.getObjectData<MarkerTypeRx>().data
+                       : MarkerType::POINT;
+
+    if (marker_type_ != MarkerType::POINT)
+    {
+        const float marker_size = rx_list.hasKey(Command::POINT_SIZE) ? point_size_ : 6.0f;
+        marker_batch_ = MarkerBatch(marker_type_, marker_size);
+    }
+
+    if (is_single_precision_)
+    {
+        chunk_bounds_ = ChunkBounds(reinterpret_cast<float*>(data_[0]),
+                                    reinterpret_cast<float*>(data_[1]),
+                                    static_cast<float*>(nullptr),
+                                    num_elements_,
+                                    false);
+    }
+    else
+    {
+        x_vec.setInternalData(reinterpret_cast<double*>(data_[0]), num_elements_);
+        y_vec.setInternalData(reinterpret_cast<double*>(data_[1]), num_elements_);
+
+        chunk_bounds_ = ChunkBounds(reinterpret_cast<double*>(data_[0]),
+                                    reinterpret_cast<double*>(data_[1]),
+                                    static_cast<double*>(nullptr),
+                                    num_elements_,
+                                    false);
+    }
 
     findMinMax();
 }
 
 void Scatter2D::findMinMax()
 {
-    ASSERT(x_vec.isAllocated()) << "Vector x not allocated when checking min/max!";
-    ASSERT(y_vec.isAllocated()) << "Vector y not allocated when checking min/max!";
+    // Single precision x and y min and max are found while converting
+    if (!is_single_precision_)
+    {
+        ASSERT(x_vec.isAllocated()) << "Vector x not allocated when checking min/max!";
+        ASSERT(y_vec.isAllocated()) << "Vector y not allocated when checking min/max!";
 
-    min_vec.x = arl::min(x_vec);
-    min_vec.y = arl::min(y_vec);
-    min_vec.z = -1.0;
+        min_vec.x = arl::min(x_vec);
+        min_vec.y = arl::min(y_vec);
+
+        max_vec.x = arl::max(x_vec);
+        max_vec.y = arl::max(y_vec);
+    }
 
-    max_vec.x = arl::max(x_vec);
-    max_vec.y = arl::max(y_vec);
+    min_vec.z = -1.0;
     max_vec.z = 1.0;
 }
 
 void Scatter2D::visualize() const
 {
     setColor(color_);
-    setPointSize(point_size_);
-    scatter(x_vec, y_vec);
+    if (is_single_precision_)
+    {
+        pushDataOffset();
+        visualizeData<float>();
+        popDataOffset();
+    }
+    else
+    {
+        visualizeData<double>();
+    }
+}
+
+template <typename T> void Scatter2D::visualizeData() const
+{
+    const T* const x_values = reinterpret_cast<T*>(data_[0]);
+    const T* const y_values = reinterpret_cast<T*>(data_[1]);
+
+    if (marker_type_ == MarkerType::POINT)
+    {
+        setPointSize(point_size_);
+        for (const std::pair<size_t, size_t>& range : chunk_bounds_.getVisibleRanges())
+        {
+            drawPoints2D(
+                x_values + range.first, y_values + range.first, range.second - range.first);
+        }
+    }
+    else
+    {
+        marker_batch_.update<T>(
+            x_values, y_values, nullptr, num_elements_, getDefaultThreadPool());
+        setLinewidth(1.0f);
+        marker_batch_.draw();
+    }
 }
 
 Scatter2D::~Scatter2D()
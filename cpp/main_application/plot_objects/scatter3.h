@@ -8,9 +8,12 @@
 
 #include "communication/rx_list.h"
 #include "main_application/plot_objects/plot_object_base.h"
+#include "misc/thread_pool.h"
 #include "opengl_low_level/data_structures.h"
 #include "opengl_low_level/opengl_low_level.h"
 #include "plot_functions/plot_functions.h"
+#include "plot_functions/point_octree.h"
+#include "plot_functions/scatter_markers.h"
 
 using namespace plot_tool;
 
@@ -19,21 +22,34 @@ class Scatter3D : public PlotObjectBase
 private:
     size_t num_elements_;
     float point_size_;
+    int marker_type_;
+
+    // Updated in visualize, whenever the view changes
+    mutable MarkerBatch marker_batch_;
+
+    // Points are drawn from the octree, with culling, once it has been built
+    mutable AsyncPointOctree octree_;
 
     arl::Vectord x_vec, y_vec, z_vec;
 
     void findMinMax();
+    template <typename T> void visualizeData() const;
 
 public:
     Scatter3D();
-    Scatter3D(const plot_tool::RxList& rx_list, const std::vector<char*> data_vec);
+    Scatter3D(const plot_tool::RxList& rx_list,
+              const std::vector<char*> data_vec,
+              BlockArena* const arena);
     ~Scatter3D();
 
     void visualize() const override;
+    size_t getNumBytes() const override;
 };
 
-Scatter3D::Scatter3D(const plot_tool::RxList& rx_list, const std::vector<char*> data_vec)
-    : PlotObjectBase(rx_list, data_vec)
+Scatter3D::Scatter3D(const plot_tool::RxList& rx_list,
+                     const std::vector<char*> data_vec,
+                     BlockArena* const arena)
+    : PlotObjectBase(rx_list, data_vec, arena, true)
 {
     // num_elements is actual number of elements, not number of bytes
     ASSERT(rx_list.getObjectData<FunctionRx>() == Function::SCATTER3);
@@ -43,12 +59,39 @@ Scatter3D::Scatter3D(const plot_tool::RxList& rx_list, const std::vector<char*>
     num_elements_ = rx_list.getObjectData<NumElementsRx>();
     point_size_ =
         rx_list.hasKey(Command::POINT_SIZE) ? rx_list.getObjectData<PointSizeRx>().data : 1.0f;
-
-    x_vec.setInternalData(reinterpret_cast<double*>(data_[0]), num_elements_);
-    y_vec.setInternalData(reinterpret_cast<double*>(data_[1]), num_elements_);
-    z_vec.setInternalData(reinterpret_cast<double*>(data_[2]), num_elements_);
-
-    findMinMax();
+    marker_type_ = rx_list.hasKey(Command::MARKER_TYPE)
+                       ? rx_list.getObjectData<MarkerTypeRx>().data
+                       : MarkerType::POINT;
+
+    if (marker_type_ != MarkerType::POINT)
+    {
+        const float marker_size = rx_list.hasKey(Command::POINT_SIZE) ? point_size_ : 6.0f;
+        marker_batch_ = MarkerBatch(marker_type_, marker_size);
+    }
+
+    if (is_single_precision_)
+    {
+        octree_ = AsyncPointOctree(reinterpret_cast<float*>(data_[0]),
+                                   reinterpret_cast<float*>(data_[1]),
+                                   reinterpret_cast<float*>(data_[2]),
+                                   num_elements_,
+                                   PointOctree::PrimitiveType::POINTS);
+    }
+    else
+    {
+        x_vec.setInternalData(reinterpret_cast<double*>(data_[0]), num_elements_);
+        y_vec.setInternalData(reinterpret_cast<double*>(data_[1]), num_elements_);
+        z_vec.setInternalData(reinterpret_cast<double*>(data_[2]), num_elements_);
+
+        octree_ = AsyncPointOctree(reinterpret_cast<double*>(data_[0]),
+                                   reinterpret_cast<double*>(data_[1]),
+                                   reinterpret_cast<double*>(data_[2]),
+                                   num_elements_,
+                                   PointOctree::PrimitiveType::POINTS);
+
+        // Single precision min and max are found while converting
+        findMinMax();
+    }
 }
 
 void Scatter3D::findMinMax()
@@ -66,11 +109,50 @@ void Scatter3D::findMinMax()
     max_vec.z = arl::max(z_vec);
 }
 
+size_t Scatter3D::getNumBytes() const
+{
+    return PlotObjectBase::getNumBytes() + octree_.getNumBytes();
+}
+
 void Scatter3D::visualize() const
 {
     setColor(color_);
-    setPointSize(point_size_);
-    scatter3(x_vec, y_vec, z_vec);
+    if (is_single_precision_)
+    {
+        pushDataOffset();
+        visualizeData<float>();
+        popDataOffset();
+    }
+    else
+    {
+        visualizeData<double>();
+    }
+}
+
+template <typename T> void Scatter3D::visualizeData() const
+{
+    const T* const x_values = reinterpret_cast<T*>(data_[0]);
+    const T* const y_values = reinterpret_cast<T*>(data_[1]);
+    const T* const z_values = reinterpret_cast<T*>(data_[2]);
+
+    if (marker_type_ == MarkerType::POINT)
+    {
+        setPointSize(point_size_);
+        if (PointOctree* const octree = octree_.get())
+        {
+            octree->draw(is_interacting_);
+        }
+        else
+        {
+            drawPoints3D(x_values, y_values, z_values, num_elements_);
+        }
+    }
+    else
+    {
+        marker_batch_.update(x_values, y_values, z_values, num_elements_, getDefaultThreadPool());
+        setLinewidth(1.0f);
+        marker_batch_.draw();
+    }
 }
 
 Scatter3D::~Scatter3D()
@@ -0,0 +1,192 @@
+#ifndef SCOPE_H_
+#define SCOPE_H_
+
+#include <arl/math/math.h>
+
+#include <algorithm>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "communication/rx_list.h"
+#include "main_application/plot_objects/plot_object_base.h"
+#include "opengl_low_level/data_structures.h"
+#include "opengl_low_level/opengl_low_level.h"
+#include "plot_functions/plot_functions.h"
+
+using namespace plot_tool;
+
+// Rolling plot of the last capacity samples pushed to it, plotted against the running sample
+// index. Samples are written into a preallocated ring of vertices, so pushing costs the same
+// per sample regardless of the capacity, and drawing is at most two vertex array calls.
+class Scope : public PlotObjectBase
+{
+private:
+    size_t handle_;
+    size_t capacity_;
+    float line_width_;
+
+    // x and y of sample k at slot k % capacity_. Slot 0 is repeated in slot capacity_, so that
+    // the part before the wrap around can be drawn including the connection to the part after.
+    std::vector<double> vertices_;
+    size_t num_samples_;  // Pushed in total
+
+    // Indices of the samples that can still become the min/max of the window, for amortized
+    // constant time axes limits
+    std::deque<size_t> min_candidates_;
+    std::deque<size_t> max_candidates_;
+
+    double getSample(const size_t sample_idx) const;
+    void findMinMax();
+
+public:
+    Scope();
+    Scope(const plot_tool::RxList& rx_list,
+          const std::vector<char*> data_vec,
+          BlockArena* const arena);
+
+    size_t getHandle() const;
+    void push(const double* const samples, const size_t num_samples);
+
+    void visualize() const override;
+    size_t getNumBytes() const override;
+};
+
+Scope::Scope(const plot_tool::RxList& rx_list,
+             const std::vector<char*> data_vec,
+             BlockArena* const arena)
+    : PlotObjectBase(rx_list, data_vec, arena)
+{
+    ASSERT(rx_list.getObjectData<FunctionRx>() == Function::SCOPE);
+    ASSERT(rx_list.getObjectData<NumBuffersRequiredRx>() == 0);
+
+    // The samples are pushed later, but they are plotted in 2D
+    num_buffers_required_ = 2;
+
+    handle_ = rx_list.getObjectData<ScopeHandleRx>();
+    capacity_ = rx_list.getObjectData<NumElementsRx>();
+    ASSERT(capacity_ > 0) << "Scope capacity must be larger than zero!";
+
+    line_width_ =
+        rx_list.hasKey(Command::LINEWIDTH) ? rx_list.getObjectData<LinewidthRx>().data : 1.0f;
+
+    vertices_.resize(2 * (capacity_ + 1));
+    num_samples_ = 0;
+
+    findMinMax();
+}
+
+size_t Scope::getHandle() const
+{
+    return handle_;
+}
+
+double Scope::getSample(const size_t sample_idx) const
+{
+    return vertices_[2 * (sample_idx % capacity_) + 1];
+}
+
+void Scope::push(const double* const samples, const size_t num_samples)
+{
+    // Samples that would be overwritten within the same push are skipped
+    const size_t num_skipped = num_samples > capacity_ ? num_samples - capacity_ : 0;
+    num_samples_ += num_skipped;
+
+    for (size_t k = num_skipped; k < num_samples; k++)
+    {
+        const size_t sample_idx = num_samples_;
+        const size_t slot = sample_idx % capacity_;
+        const double sample = samples[k];
+
+        // Drop candidates that leave the window, before their slot is overwritten
+        if (sample_idx >= capacity_)
+        {
+            const size_t first_sample_idx = sample_idx - capacity_ + 1;
+            while (!min_candidates_.empty() && (min_candidates_.front() < first_sample_idx))
+            {
+                min_candidates_.pop_front();
+            }
+            while (!max_candidates_.empty() && (max_candidates_.front() < first_sample_idx))
+            {
+                max_candidates_.pop_front();
+            }
+        }
+
+        vertices_[2 * slot] = static_cast<double>(sample_idx);
+        vertices_[2 * slot + 1] = sample;
+        if (slot == 0)
+        {
+            vertices_[2 * capacity_] = vertices_[0];
+            vertices_[2 * capacity_ + 1] = vertices_[1];
+        }
+
+        while (!min_candidates_.empty() && (getSample(min_candidates_.back()) >= sample))
+        {
+            min_candidates_.pop_back();
+        }
+        min_candidates_.push_back(sample_idx);
+
+        while (!max_candidates_.empty() && (getSample(max_candidates_.back()) <= sample))
+        {
+            max_candidates_.pop_back();
+        }
+        max_candidates_.push_back(sample_idx);
+
+        num_samples_++;
+    }
+
+    findMinMax();
+}
+
+void Scope::findMinMax()
+{
+    const size_t first_sample_idx = num_samples_ > capacity_ ? num_samples_ - capacity_ : 0;
+
+    // The x range is always the full capacity, so that the plot scrolls at a constant scale
+    min_vec.x = static_cast<double>(first_sample_idx);
+    max_vec.x = static_cast<double>(first_sample_idx + capacity_ - 1);
+
+    if (min_candidates_.empty())
+    {
+        min_vec.y = -1.0;
+        max_vec.y = 1.0;
+    }
+    else
+    {
+        min_vec.y = getSample(min_candidates_.front());
+        max_vec.y = getSample(max_candidates_.front());
+    }
+
+    min_vec.z = -1.0;
+    max_vec.z = 1.0;
+}
+
+void Scope::visualize() const
+{
+    const size_t num_visible = std::min(num_samples_, capacity_);
+    if (num_visible == 0)
+    {
+        return;
+    }
+
+    const size_t first_slot = (num_samples_ - num_visible) % capacity_;
+    const size_t num_before_wrap = std::min(num_visible, capacity_ - first_slot);
+    const size_t num_after_wrap = num_visible - num_before_wrap;
+
+    setColor(color_);
+    setLinewidth(line_width_);
+
+    drawLineStripArray2D(vertices_.data() + 2 * first_slot,
+                         num_before_wrap + (num_after_wrap > 0 ? 1 : 0));
+    if (num_after_wrap > 1)
+    {
+        drawLineStripArray2D(vertices_.data(), num_after_wrap);
+    }
+}
+
+size_t Scope::getNumBytes() const
+{
+    return PlotObjectBase::getNumBytes() + sizeof(double) * vertices_.capacity();
+}
+
+#endif
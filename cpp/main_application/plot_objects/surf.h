@@ -9,9 +9,12 @@
 
 #include "communication/rx_list.h"
 #include "main_application/plot_objects/plot_object_base.h"
+#include "misc/thread_pool.h"
 #include "opengl_low_level/data_structures.h"
 #include "opengl_low_level/opengl_low_level.h"
+#include "plot_functions/color_lut.h"
 #include "plot_functions/plot_functions.h"
+#include "plot_functions/surf_mesh.h"
 
 using namespace plot_tool;
 
@@ -21,7 +24,7 @@ private:
     RGBTripletf edge_color_;
     RGBTripletf face_color_;
 
-    arl::RGBColorMap<float> color_map_;
+    const ColorLut* color_lut_;
 
     float line_width_;
 
@@ -29,6 +32,10 @@ private:
     Dimension2D dim_;
 
     arl::Matrixd x_mat, y_mat, z_mat;
+    arl::Matrix<float> x_mat_f, y_mat_f, z_mat_f;  // Used instead with single precision
+
+    // Level of detail pyramid, level 0 is the full grid
+    std::vector<SurfMesh> mesh_levels_;
 
     bool face_color_set_;
 
@@ -36,14 +43,21 @@ private:
 
 public:
     Surf();
-    Surf(const plot_tool::RxList& rx_list, const std::vector<char*> data_vec);
+    Surf(const plot_tool::RxList& rx_list,
+         const std::vector<char*> data_vec,
+         const ColorLut& custom_color_lut,
+         BlockArena* const arena);
     ~Surf();
 
     void visualize() const override;
+    size_t getNumBytes() const override;
 };
 
-Surf::Surf(const plot_tool::RxList& rx_list, const std::vector<char*> data_vec)
-    : PlotObjectBase(rx_list, data_vec)
+Surf::Surf(const plot_tool::RxList& rx_list,
+           const std::vector<char*> data_vec,
+           const ColorLut& custom_color_lut,
+           BlockArena* const arena)
+    : PlotObjectBase(rx_list, data_vec, arena, true)
 {
     // num_elements is actual number of elements, not number of bytes
     ASSERT(rx_list.getObjectData<FunctionRx>() == Function::SURF);
@@ -52,7 +66,7 @@ Surf::Surf(const plot_tool::RxList& rx_list, const std::vector<char*> data_vec)
 
     num_elements_ = rx_list.getObjectData<NumElementsRx>();
     face_color_set_ = false;
-    color_map_ = arl::color_maps::jetf;
+    color_lut_ = &getBuiltInColorLut(ColorMap::JET);
 
     face_color_ = RGBTripletf(0.1, 0.2, 0.1);
     edge_color_ = RGBTripletf(0.0, 0.0, 0.0);
@@ -80,34 +94,58 @@ Surf::Surf(const plot_tool::RxList& rx_list, const std::vector<char*> data_vec)
     {
         face_color_set_ = false;
         ColorMap cm = rx_list.getObjectData<ColorMapRx>();
-        switch (cm.data)
+        if (cm.data == ColorMap::CUSTOM)
+        {
+            if (custom_color_lut.isEmpty())
+            {
+                LOG_WARNING() << "No custom color map set, using default color map!";
+            }
+            else
+            {
+                color_lut_ = &custom_color_lut;
+            }
+        }
+        else
         {
-            case ColorMap::RAINBOW:
-                color_map_ = arl::color_maps::rainbowf;
-                break;
-            case ColorMap::MAGMA:
-                color_map_ = arl::color_maps::magmaf;
-                break;
-            case ColorMap::VIRIDIS:
-                color_map_ = arl::color_maps::viridisf;
-                break;
-            case ColorMap::JET:
-                color_map_ = arl::color_maps::jetf;
-                break;
-            default:
-                color_map_ = arl::color_maps::jetf;
-                break;
+            color_lut_ = &getBuiltInColorLut(cm.data);
         }
     }
 
     line_width_ =
         rx_list.hasKey(Command::LINEWIDTH) ? rx_list.getObjectData<LinewidthRx>().data : 1.0f;
 
-    x_mat.setInternalData(reinterpret_cast<double*>(data_[0]), dim_.rows, dim_.cols);
-    y_mat.setInternalData(reinterpret_cast<double*>(data_[1]), dim_.rows, dim_.cols);
-    z_mat.setInternalData(reinterpret_cast<double*>(data_[2]), dim_.rows, dim_.cols);
-
-    findMinMax();
+    if (is_single_precision_)
+    {
+        x_mat_f.setInternalData(reinterpret_cast<float*>(data_[0]), dim_.rows, dim_.cols);
+        y_mat_f.setInternalData(reinterpret_cast<float*>(data_[1]), dim_.rows, dim_.cols);
+        z_mat_f.setInternalData(reinterpret_cast<float*>(data_[2]), dim_.rows, dim_.cols);
+
+        // Colors are mapped from y relative to the offset, as y is stored
+        buildSurfMeshLevels(mesh_levels_,
+                            x_mat_f,
+                            y_mat_f,
+                            z_mat_f,
+                            {min_vec.y - data_offset_.y, max_vec.y - data_offset_.y},
+                            face_color_set_ ? nullptr : color_lut_,
+                            getDefaultThreadPool());
+    }
+    else
+    {
+        x_mat.setInternalData(reinterpret_cast<double*>(data_[0]), dim_.rows, dim_.cols);
+        y_mat.setInternalData(reinterpret_cast<double*>(data_[1]), dim_.rows, dim_.cols);
+        z_mat.setInternalData(reinterpret_cast<double*>(data_[2]), dim_.rows, dim_.cols);
+
+        // Single precision min and max are found while converting
+        findMinMax();
+
+        buildSurfMeshLevels(mesh_levels_,
+                            x_mat,
+                            y_mat,
+                            z_mat,
+                            {min_vec.y, max_vec.y},
+                            face_color_set_ ? nullptr : color_lut_,
+                            getDefaultThreadPool());
+    }
 }
 
 void Surf::findMinMax()
@@ -125,21 +163,39 @@ void Surf::findMinMax()
     max_vec.z = arl::max(z_mat);
 }
 
+size_t Surf::getNumBytes() const
+{
+    size_t num_bytes = PlotObjectBase::getNumBytes();
+    for (const SurfMesh& mesh : mesh_levels_)
+    {
+        num_bytes += mesh.getNumBytes();
+    }
+    return num_bytes;
+}
+
 void Surf::visualize() const
 {
-    if (face_color_set_)
+    if (is_single_precision_)
     {
-        setColor(face_color_);
-        surf(x_mat, y_mat, z_mat);
+        pushDataOffset();
     }
-    else
+
+    const SurfMesh& mesh = mesh_levels_[selectSurfMeshLevel(mesh_levels_, is_interacting_)];
+
+    if (face_color_set_)
     {
-        surf(x_mat, y_mat, z_mat, {min_vec.y, max_vec.y}, color_map_);
+        setColor(face_color_);
     }
+    drawSurfMeshFaces(mesh);
 
     setColor(edge_color_);
     setLinewidth(line_width_);
-    drawGrid3D(x_mat, y_mat, z_mat);
+    drawSurfMeshEdges(mesh);
+
+    if (is_single_precision_)
+    {
+        popDataOffset();
+    }
 }
 
 Surf::~Surf()
@@ -147,6 +203,9 @@ Surf::~Surf()
     x_mat.setInternalData(nullptr, 0, 0);  // Hack
     y_mat.setInternalData(nullptr, 0, 0);
     z_mat.setInternalData(nullptr, 0, 0);
+    x_mat_f.setInternalData(nullptr, 0, 0);
+    y_mat_f.setInternalData(nullptr, 0, 0);
+    z_mat_f.setInternalData(nullptr, 0, 0);
 }
 
 #endif
@@ -4,7 +4,9 @@
 #include "communication/rx_list.h"
 #include "main_application/plot_window_gl_pane.h"
 
-PlotWindow::PlotWindow(wxWindow* parent, const int figure_number)
+PlotWindow::PlotWindow(wxWindow* parent,
+                       const int figure_number,
+                       MemoryBudget* const memory_budget)
     : wxFrame(parent,
               wxID_ANY,
               "Figure " + std::to_string(figure_number),
@@ -26,6 +28,7 @@ PlotWindow::PlotWindow(wxWindow* parent, const int figure_number)
                   0};
 
     gl_pane_ = new PlotWindowGLPane(this, args, wxPoint(0, 0));
+    gl_pane_->setMemoryBudget(memory_budget, figure_number_);
 
     sizer_ = new wxBoxSizer(wxVERTICAL);
     sizer_->Add(gl_pane_, 1, wxEXPAND, 0);
@@ -14,6 +14,7 @@
 #include <string>
 
 #include "communication/rx_list.h"
+#include "main_application/memory_budget.h"
 #include "main_application/plot_window_gl_pane.h"
 
 // https://forums.wxwidgets.org/viewtopic.php?t=43767
@@ -41,7 +42,7 @@ private:
 public:
     ~PlotWindow();
     PlotWindow();
-    PlotWindow(wxWindow* parent, const int window_id);
+    PlotWindow(wxWindow* parent, const int window_id, MemoryBudget* const memory_budget);
     virtual void OnClose(wxCloseEvent& event);
 
     std::string getWindowName();
@@ -57,6 +57,12 @@ PlotWindowGLPane::~PlotWindowGLPane()
     delete m_context;
 }
 
+void PlotWindowGLPane::setMemoryBudget(MemoryBudget* const memory_budget,
+                                       const size_t figure_number)
+{
+    plot_data_handler_.setMemoryBudget(memory_budget, figure_number);
+}
+
 void PlotWindowGLPane::addData(const plot_tool::RxList& rx_list, const std::vector<char*> data_vec)
 {
     const Function function_type = rx_list.getObjectData<FunctionRx>();
@@ -101,6 +107,22 @@ void PlotWindowGLPane::addData(const plot_tool::RxList& rx_list, const std::vect
     {
         plot_data_handler_.softClear();
     }
+    else if (function_type == Function::COLOR_MAP_LUT)
+    {
+        plot_data_handler_.setCustomColorLut(rx_list, data_vec);
+    }
+    else if (function_type == Function::SCOPE_PUSH)
+    {
+        plot_data_handler_.pushToScope(rx_list, data_vec);
+
+        // Scroll along with the samples
+        if (!axes_set_)
+        {
+            const std::pair<arl::Vec3Dd, arl::Vec3Dd> min_max =
+                plot_data_handler_.getMinMaxVectors();
+            axes_interactor_->setAxesLimits(min_max.first, min_max.second);
+        }
+    }
     else
     {
         if (!hold_on_)
@@ -135,6 +157,7 @@ void PlotWindowGLPane::mouseLeftReleased(wxMouseEvent& event)
     (void)event;
 
     left_mouse_button_.setIsReleased();
+    plot_data_handler_.setIsInteracting(false);
     Refresh();
 }
 
@@ -146,6 +169,7 @@ void PlotWindowGLPane::mouseMoved(wxMouseEvent& event)
         left_mouse_button_.updateOnMotion(current_point.x, current_point.y);
         axes_interactor_->registerMouseDragInput(left_mouse_button_.getDeltaPos().x,
                                                  left_mouse_button_.getDeltaPos().y);
+        plot_data_handler_.setIsInteracting(true);
 
         Refresh();
     }
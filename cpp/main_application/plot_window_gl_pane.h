@@ -38,6 +38,7 @@ public:
     void render(wxPaintEvent& evt);
 
     void addData(const plot_tool::RxList& rx_list, const std::vector<char*> data_vec);
+    void setMemoryBudget(MemoryBudget* const memory_budget, const size_t figure_number);
 
     // Event callback function
     void mouseMoved(wxMouseEvent& event);
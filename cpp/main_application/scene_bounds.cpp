@@ -0,0 +1,153 @@
+#include "main_application/scene_bounds.h"
+
+#include <arl/utilities/logging.h>
+
+#include <algorithm>
+
+SceneBounds::SceneBounds() : capacity_(0), num_slots_(0) {}
+
+SceneBounds::Node SceneBounds::emptyNode()
+{
+    Node node;
+    std::fill(node.min, node.min + 3, 0.0);
+    std::fill(node.max, node.max + 3, 0.0);
+    node.is_empty = true;
+    node.has_z = false;
+    return node;
+}
+
+SceneBounds::Node SceneBounds::combine(const Node& left, const Node& right)
+{
+    if (left.is_empty)
+    {
+        return right;
+    }
+    else if (right.is_empty)
+    {
+        return left;
+    }
+
+    Node node;
+    for (size_t d = 0; d < 2; d++)
+    {
+        node.min[d] = std::min(left.min[d], right.min[d]);
+        node.max[d] = std::max(left.max[d], right.max[d]);
+    }
+
+    if (left.has_z && right.has_z)
+    {
+        node.min[2] = std::min(left.min[2], right.min[2]);
+        node.max[2] = std::max(left.max[2], right.max[2]);
+    }
+    else
+    {
+        const Node& z_node = left.has_z ? left : right;
+        node.min[2] = z_node.min[2];
+        node.max[2] = z_node.max[2];
+    }
+
+    node.is_empty = false;
+    node.has_z = left.has_z || right.has_z;
+    return node;
+}
+
+void SceneBounds::grow()
+{
+    const size_t new_capacity = std::max(2 * capacity_, size_t(16));
+    std::vector<Node> new_nodes(2 * new_capacity, emptyNode());
+    for (size_t k = 0; k < capacity_; k++)
+    {
+        new_nodes[new_capacity + k] = nodes_[capacity_ + k];
+    }
+    for (size_t k = new_capacity - 1; k > 0; k--)
+    {
+        new_nodes[k] = combine(new_nodes[2 * k], new_nodes[2 * k + 1]);
+    }
+
+    nodes_.swap(new_nodes);
+    capacity_ = new_capacity;
+}
+
+void SceneBounds::setLeaf(const size_t slot, const Node& node)
+{
+    ASSERT(slot < num_slots_) << "Invalid scene bounds slot!";
+
+    size_t k = capacity_ + slot;
+    nodes_[k] = node;
+    for (k /= 2; k > 0; k /= 2)
+    {
+        nodes_[k] = combine(nodes_[2 * k], nodes_[2 * k + 1]);
+    }
+}
+
+size_t SceneBounds::add(const arl::Vec3Dd& min_vec, const arl::Vec3Dd& max_vec, const bool is_3d)
+{
+    size_t slot;
+    if (free_slots_.empty())
+    {
+        if (num_slots_ == capacity_)
+        {
+            grow();
+        }
+        slot = num_slots_;
+        num_slots_++;
+    }
+    else
+    {
+        slot = free_slots_.back();
+        free_slots_.pop_back();
+    }
+
+    update(slot, min_vec, max_vec, is_3d);
+    return slot;
+}
+
+void SceneBounds::update(const size_t slot,
+                         const arl::Vec3Dd& min_vec,
+                         const arl::Vec3Dd& max_vec,
+                         const bool is_3d)
+{
+    Node node;
+    node.min[0] = min_vec.x;
+    node.min[1] = min_vec.y;
+    node.min[2] = is_3d ? min_vec.z : 0.0;
+    node.max[0] = max_vec.x;
+    node.max[1] = max_vec.y;
+    node.max[2] = is_3d ? max_vec.z : 0.0;
+    node.is_empty = false;
+    node.has_z = is_3d;
+
+    setLeaf(slot, node);
+}
+
+void SceneBounds::remove(const size_t slot)
+{
+    setLeaf(slot, emptyNode());
+    free_slots_.push_back(slot);
+}
+
+void SceneBounds::clear()
+{
+    nodes_.clear();
+    capacity_ = 0;
+    num_slots_ = 0;
+    free_slots_.clear();
+}
+
+bool SceneBounds::isEmpty() const
+{
+    return nodes_.empty() || nodes_[1].is_empty;
+}
+
+bool SceneBounds::hasZ() const
+{
+    return !nodes_.empty() && nodes_[1].has_z;
+}
+
+std::pair<arl::Vec3Dd, arl::Vec3Dd> SceneBounds::getMinMaxVectors() const
+{
+    const Node& root = nodes_.empty() ? emptyNode() : nodes_[1];
+    return std::pair<arl::Vec3Dd, arl::Vec3Dd>(
+        arl::Vec3Dd(root.min[0], root.min[1], root.min[2]),
+        arl::Vec3Dd(root.max[0], root.max[1], root.max[2]));
+}
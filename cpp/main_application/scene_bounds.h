@@ -0,0 +1,53 @@
+#ifndef SCENE_BOUNDS_H_
+#define SCENE_BOUNDS_H_
+
+#include <arl/math/math.h>
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Union of the bounding boxes of all plot objects in a figure, for setting the axes
+// automatically. Each object has a slot in a segment tree, so adding, updating and removing an
+// object is O(log n), and the union is always available in the root. z is only taken from 3D
+// objects, 2D objects are at z = 0 and don't extend the z range.
+class SceneBounds
+{
+private:
+    struct Node
+    {
+        double min[3];
+        double max[3];
+        bool is_empty;  // No object in the subtree
+        bool has_z;     // Some 3D object in the subtree
+    };
+
+    std::vector<Node> nodes_;  // Root at 1, leaves at [capacity_, 2 * capacity_)
+    size_t capacity_;
+    size_t num_slots_;  // Slots in use or in free_slots_, [0, num_slots_)
+    std::vector<size_t> free_slots_;
+
+    static Node emptyNode();
+    static Node combine(const Node& left, const Node& right);
+    void grow();
+    void setLeaf(const size_t slot, const Node& node);
+
+public:
+    SceneBounds();
+
+    // Returns the slot of the object, to be used for updating or removing it
+    size_t add(const arl::Vec3Dd& min_vec, const arl::Vec3Dd& max_vec, const bool is_3d);
+    void update(const size_t slot,
+                const arl::Vec3Dd& min_vec,
+                const arl::Vec3Dd& max_vec,
+                const bool is_3d);
+    void remove(const size_t slot);
+    void clear();
+
+    bool isEmpty() const;
+    bool hasZ() const;
+    // Union of all objects. z is 0 if there are no 3D objects.
+    std::pair<arl::Vec3Dd, arl::Vec3Dd> getMinMaxVectors() const;
+};
+
+#endif
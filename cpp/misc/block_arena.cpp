@@ -0,0 +1,105 @@
+#include "misc/block_arena.h"
+
+#include <stdlib.h>
+
+#include <new>
+
+constexpr size_t BlockArena::alignment;
+
+BlockArena::BlockArena(const size_t block_size) : block_size_(block_size), num_reserved_bytes_(0)
+{
+}
+
+BlockArena::~BlockArena()
+{
+    reset();
+}
+
+void BlockArena::freeBlock(const size_t block_idx)
+{
+    num_reserved_bytes_ -= blocks_[block_idx].size;
+    free(blocks_[block_idx].data);
+    blocks_.erase(blocks_.begin() + block_idx);
+}
+
+char* BlockArena::allocate(const size_t num_bytes)
+{
+    // Empty requests take alignment bytes too, so that the returned pointer is always inside
+    // the block it's counted in, also when the block is full, and release() finds it
+    const size_t num_aligned_bytes =
+        num_bytes == 0 ? alignment : ((num_bytes + alignment - 1) / alignment) * alignment;
+    const bool is_large = num_aligned_bytes > (block_size_ / 2);
+
+    if (!is_large && !blocks_.empty() &&
+        (blocks_.back().num_used_bytes + num_aligned_bytes <= blocks_.back().size))
+    {
+        Block& block = blocks_.back();
+        char* const ptr = block.data + block.num_used_bytes;
+        block.num_used_bytes += num_aligned_bytes;
+        block.num_allocations++;
+        return ptr;
+    }
+
+    Block block;
+    block.size = is_large ? num_aligned_bytes : block_size_;
+    void* data;
+    if (posix_memalign(&data, alignment, block.size) != 0)
+    {
+        throw std::bad_alloc();
+    }
+    block.data = static_cast<char*>(data);
+    block.num_used_bytes = num_aligned_bytes;
+    block.num_allocations = 1;
+    num_reserved_bytes_ += block.size;
+
+    if (is_large && !blocks_.empty())
+    {
+        // Keep allocating small buffers from the current block
+        blocks_.insert(blocks_.end() - 1, block);
+    }
+    else
+    {
+        blocks_.push_back(block);
+    }
+
+    return block.data;
+}
+
+void BlockArena::release(const char* const ptr)
+{
+    for (size_t k = 0; k < blocks_.size(); k++)
+    {
+        Block& block = blocks_[k];
+        if ((ptr < block.data) || (ptr >= (block.data + block.size)))
+        {
+            continue;
+        }
+
+        block.num_allocations--;
+        if (block.num_allocations == 0)
+        {
+            if ((k == (blocks_.size() - 1)) && (block.size == block_size_))
+            {
+                block.num_used_bytes = 0;
+            }
+            else
+            {
+                freeBlock(k);
+            }
+        }
+        return;
+    }
+}
+
+void BlockArena::reset()
+{
+    while (!blocks_.empty())
+    {
+        freeBlock(blocks_.size() - 1);
+    }
+}
+
+size_t BlockArena::getNumReservedBytes() const
+{
+    return num_reserved_bytes_;
+}
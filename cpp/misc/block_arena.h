@@ -0,0 +1,49 @@
+#ifndef PLOT_TOOL_BLOCK_ARENA_H_
+#define PLOT_TOOL_BLOCK_ARENA_H_
+
+#include <cstddef>
+#include <vector>
+
+// Bump allocator for plot data, which hands out memory from large blocks. Every block counts
+// its live allocations. When the count of the block currently allocated from drops to zero, the
+// block is reused from the start; other blocks are freed as a whole. Clearing a figure thereby
+// doesn't touch the system allocator at all in the common case of plotting over and over, and
+// memory that is returned is returned in large blocks. Allocations larger than half a block get
+// a block of their own. Not thread safe.
+class BlockArena
+{
+private:
+    struct Block
+    {
+        char* data;
+        size_t size;
+        size_t num_used_bytes;
+        size_t num_allocations;
+    };
+
+    size_t block_size_;
+    std::vector<Block> blocks_;  // Allocations are made from the last block
+    size_t num_reserved_bytes_;
+
+    void freeBlock(const size_t block_idx);
+
+public:
+    static constexpr size_t alignment = 64;
+
+    BlockArena() = delete;
+    BlockArena(const BlockArena&) = delete;
+    BlockArena& operator=(const BlockArena&) = delete;
+    explicit BlockArena(const size_t block_size);
+    ~BlockArena();
+
+    // Returns memory aligned to alignment bytes, a distinct pointer also for num_bytes == 0
+    char* allocate(const size_t num_bytes);
+    void release(const char* const ptr);
+
+    // Frees all blocks, any memory from the arena must no longer be used
+    void reset();
+
+    size_t getNumReservedBytes() const;
+};
+
+#endif
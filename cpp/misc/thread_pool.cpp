@@ -0,0 +1,120 @@
+#include "misc/thread_pool.h"
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(const size_t num_worker_threads)
+    : task_(nullptr),
+      num_items_(0),
+      chunk_size_(1),
+      next_item_(0),
+      num_active_workers_(0),
+      generation_(0),
+      stop_(false)
+{
+    for (size_t k = 0; k < num_worker_threads; k++)
+    {
+        threads_.emplace_back(&ThreadPool::workerFunction, this);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        stop_ = true;
+    }
+    task_cv_.notify_all();
+
+    for (size_t k = 0; k < threads_.size(); k++)
+    {
+        threads_[k].join();
+    }
+}
+
+size_t ThreadPool::getNumThreads() const
+{
+    return threads_.size() + 1;
+}
+
+void ThreadPool::runChunks()
+{
+    while (true)
+    {
+        const size_t from = next_item_.fetch_add(chunk_size_);
+        if (from >= num_items_)
+        {
+            break;
+        }
+        (*task_)(from, std::min(from + chunk_size_, num_items_));
+    }
+}
+
+void ThreadPool::workerFunction()
+{
+    size_t last_generation = 0;
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mtx_);
+            task_cv_.wait(lock, [&] { return stop_ || (generation_ != last_generation); });
+            if (stop_)
+            {
+                return;
+            }
+            last_generation = generation_;
+        }
+
+        runChunks();
+
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            num_active_workers_--;
+            if (num_active_workers_ == 0)
+            {
+                done_cv_.notify_one();
+            }
+        }
+    }
+}
+
+void ThreadPool::parallelFor(const size_t num_items,
+                             const std::function<void(const size_t, const size_t)>& fcn)
+{
+    if (num_items == 0)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> call_lock(call_mtx_);
+
+    if (threads_.empty() || (num_items == 1))
+    {
+        fcn(0, num_items);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        task_ = &fcn;
+        num_items_ = num_items;
+        // A few chunks per thread evens out the load when chunks differ in cost
+        chunk_size_ = std::max<size_t>(1, num_items / (4 * getNumThreads()));
+        next_item_ = 0;
+        num_active_workers_ = threads_.size();
+        generation_++;
+    }
+    task_cv_.notify_all();
+
+    runChunks();
+
+    std::unique_lock<std::mutex> lock(mtx_);
+    done_cv_.wait(lock, [&] { return num_active_workers_ == 0; });
+    task_ = nullptr;
+}
+
+ThreadPool& getDefaultThreadPool()
+{
+    static ThreadPool thread_pool(std::max(1U, std::thread::hardware_concurrency()) - 1U);
+    return thread_pool;
+}
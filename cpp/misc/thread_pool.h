@@ -0,0 +1,55 @@
+#ifndef PLOT_TOOL_THREAD_POOL_H_
+#define PLOT_TOOL_THREAD_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed size pool of worker threads for data parallel loops. The thread calling
+// parallelFor takes part in the work, so a pool with zero worker threads runs
+// everything on the calling thread.
+class ThreadPool
+{
+private:
+    std::vector<std::thread> threads_;
+
+    std::mutex mtx_;
+    std::mutex call_mtx_;
+    std::condition_variable task_cv_;
+    std::condition_variable done_cv_;
+
+    const std::function<void(const size_t, const size_t)>* task_;
+    size_t num_items_;
+    size_t chunk_size_;
+    std::atomic<size_t> next_item_;
+    size_t num_active_workers_;
+    size_t generation_;
+    bool stop_;
+
+    void workerFunction();
+    void runChunks();
+
+public:
+    ThreadPool() = delete;
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    explicit ThreadPool(const size_t num_worker_threads);
+    ~ThreadPool();
+
+    // Number of threads doing work in parallelFor, including the calling thread
+    size_t getNumThreads() const;
+
+    // Splits [0, num_items) into chunks and calls fcn(from, to) for each chunk, from
+    // all threads in the pool. Blocks until all chunks are done.
+    void parallelFor(const size_t num_items,
+                     const std::function<void(const size_t, const size_t)>& fcn);
+};
+
+// Pool shared by the application, with one thread per hardware thread
+ThreadPool& getDefaultThreadPool();
+
+#endif
@@ -47,6 +47,42 @@ void drawPoints2D(const arl::Vectord& x_values, const arl::Vectord& y_values)
     glEnd();
 }
 
+void drawLineStripArray2D(const double* const vertices, const size_t num_vertices)
+{
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glVertexPointer(2, GL_DOUBLE, 0, vertices);
+
+    glDrawArrays(GL_LINE_STRIP, 0, num_vertices);
+
+    glDisableClientState(GL_VERTEX_ARRAY);
+}
+
+void drawPoints2D(const double* const x_values,
+                  const double* const y_values,
+                  const size_t num_values)
+{
+    glBegin(GL_POINTS);
+    for (size_t k = 0; k < num_values; k++)
+    {
+        glVertex2f(x_values[k], y_values[k]);
+    }
+
+    glEnd();
+}
+
+void drawPoints2D(const float* const x_values,
+                  const float* const y_values,
+                  const size_t num_values)
+{
+    glBegin(GL_POINTS);
+    for (size_t k = 0; k < num_values; k++)
+    {
+        glVertex2f(x_values[k], y_values[k]);
+    }
+
+    glEnd();
+}
+
 void drawLine2D(const float x0, const float y0, const float x1, const float y1)
 {
     glBegin(GL_LINES);
@@ -69,3 +105,29 @@ void drawLines2D(const arl::Vectord& x_values, const arl::Vectord& y_values)
 
     glEnd();
 }
+
+void drawLineStrip2D(const double* const x_values,
+                     const double* const y_values,
+                     const size_t num_values)
+{
+    glBegin(GL_LINE_STRIP);
+    for (size_t k = 0; k < num_values; k++)
+    {
+        glVertex2f(x_values[k], y_values[k]);
+    }
+
+    glEnd();
+}
+
+void drawLineStrip2D(const float* const x_values,
+                     const float* const y_values,
+                     const size_t num_values)
+{
+    glBegin(GL_LINE_STRIP);
+    for (size_t k = 0; k < num_values; k++)
+    {
+        glVertex2f(x_values[k], y_values[k]);
+    }
+
+    glEnd();
+}
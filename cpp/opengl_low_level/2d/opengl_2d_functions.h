@@ -16,6 +16,20 @@ void setPointSize(const float point_size);
 
 void drawLine2D(const float x0, const float y0, const float x1, const float y1);
 void drawLines2D(const arl::Vectord& x_values, const arl::Vectord& y_values);
+void drawLineStrip2D(const double* const x_values,
+                     const double* const y_values,
+                     const size_t num_values);
+void drawLineStrip2D(const float* const x_values,
+                     const float* const y_values,
+                     const size_t num_values);
+// Interleaved x and y values, drawn with a vertex array
+void drawLineStripArray2D(const double* const vertices, const size_t num_vertices);
 void drawPoints2D(const arl::Vectord& x_values, const arl::Vectord& y_values);
+void drawPoints2D(const double* const x_values,
+                  const double* const y_values,
+                  const size_t num_values);
+void drawPoints2D(const float* const x_values,
+                  const float* const y_values,
+                  const size_t num_values);
 
 #endif
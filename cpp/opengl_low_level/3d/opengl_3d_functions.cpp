@@ -4,6 +4,7 @@
 #include <arl/math/math.h>
 #include <assert.h>
 
+#include <cstring>
 #include <vector>
 
 #include "opengl_low_level/opengl_header.h"
@@ -45,6 +46,62 @@ void drawPoints3D(const arl::Vectord& x_values,
     glEnd();
 }
 
+void drawLineStrip3D(const double* const x_values,
+                     const double* const y_values,
+                     const double* const z_values,
+                     const size_t num_values)
+{
+    glBegin(GL_LINE_STRIP);
+    for (size_t k = 0; k < num_values; k++)
+    {
+        glVertex3f(x_values[k], y_values[k], z_values[k]);
+    }
+
+    glEnd();
+}
+
+void drawLineStrip3D(const float* const x_values,
+                     const float* const y_values,
+                     const float* const z_values,
+                     const size_t num_values)
+{
+    glBegin(GL_LINE_STRIP);
+    for (size_t k = 0; k < num_values; k++)
+    {
+        glVertex3f(x_values[k], y_values[k], z_values[k]);
+    }
+
+    glEnd();
+}
+
+void drawPoints3D(const double* const x_values,
+                  const double* const y_values,
+                  const double* const z_values,
+                  const size_t num_values)
+{
+    glBegin(GL_POINTS);
+    for (size_t k = 0; k < num_values; k++)
+    {
+        glVertex3f(x_values[k], y_values[k], z_values[k]);
+    }
+
+    glEnd();
+}
+
+void drawPoints3D(const float* const x_values,
+                  const float* const y_values,
+                  const float* const z_values,
+                  const size_t num_values)
+{
+    glBegin(GL_POINTS);
+    for (size_t k = 0; k < num_values; k++)
+    {
+        glVertex3f(x_values[k], y_values[k], z_values[k]);
+    }
+
+    glEnd();
+}
+
 void drawRectangle3D() {}
 
 void drawTriangle3D(const arl::Vec3Dd& v0, const arl::Vec3Dd& v1, const arl::Vec3Dd& v2)
@@ -86,3 +143,227 @@ void drawPolygon3D(const Vec3Dd& c0, const Vec3Dd& c1, const Vec3Dd& c2, const V
     glVertex3f(c3.x, c3.y, c3.z);
     glEnd();
 }
+
+void drawIndexedQuads3D(const float* const vertices,
+                        const float* const colors,
+                        const uint32_t* const indices,
+                        const size_t num_indices)
+{
+    assert((num_indices % 4) == 0);
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glVertexPointer(3, GL_FLOAT, 0, vertices);
+
+    if (colors != nullptr)
+    {
+        // With flat shading, the color of a quad is the color of its last vertex
+        glShadeModel(GL_FLAT);
+        glEnableClientState(GL_COLOR_ARRAY);
+        glColorPointer(3, GL_FLOAT, 0, colors);
+    }
+
+    glDrawElements(GL_QUADS, num_indices, GL_UNSIGNED_INT, indices);
+
+    if (colors != nullptr)
+    {
+        glDisableClientState(GL_COLOR_ARRAY);
+        glShadeModel(GL_SMOOTH);
+    }
+    glDisableClientState(GL_VERTEX_ARRAY);
+}
+
+void drawIndexedLines3D(const float* const vertices,
+                        const uint32_t* const indices,
+                        const size_t num_indices)
+{
+    assert((num_indices % 2) == 0);
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glVertexPointer(3, GL_FLOAT, 0, vertices);
+
+    glDrawElements(GL_LINES, num_indices, GL_UNSIGNED_INT, indices);
+
+    glDisableClientState(GL_VERTEX_ARRAY);
+}
+
+void drawPointArray3D(const float* const vertices, const size_t num_vertices)
+{
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glVertexPointer(3, GL_FLOAT, 0, vertices);
+
+    glDrawArrays(GL_POINTS, 0, num_vertices);
+
+    glDisableClientState(GL_VERTEX_ARRAY);
+}
+
+void drawLineArray3D(const float* const vertices, const size_t num_vertices)
+{
+    assert((num_vertices % 2) == 0);
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glVertexPointer(3, GL_FLOAT, 0, vertices);
+
+    glDrawArrays(GL_LINES, 0, num_vertices);
+
+    glDisableClientState(GL_VERTEX_ARRAY);
+}
+
+bool operator==(const ProjectionState& ps0, const ProjectionState& ps1)
+{
+    return (std::memcmp(ps0.modelview, ps1.modelview, sizeof(ps0.modelview)) == 0) &&
+           (std::memcmp(ps0.projection, ps1.projection, sizeof(ps0.projection)) == 0) &&
+           (std::memcmp(ps0.viewport, ps1.viewport, sizeof(ps0.viewport)) == 0) &&
+           (ps0.num_clip_planes == ps1.num_clip_planes) &&
+           (std::memcmp(ps0.clip_planes,
+                        ps1.clip_planes,
+                        ps0.num_clip_planes * sizeof(ps0.clip_planes[0])) == 0);
+}
+
+bool operator!=(const ProjectionState& ps0, const ProjectionState& ps1)
+{
+    return !(ps0 == ps1);
+}
+
+ProjectionState getProjectionState()
+{
+    ProjectionState projection_state;
+
+    glGetDoublev(GL_MODELVIEW_MATRIX, projection_state.modelview);
+    glGetDoublev(GL_PROJECTION_MATRIX, projection_state.projection);
+    glGetIntegerv(GL_VIEWPORT, projection_state.viewport);
+
+    projection_state.num_clip_planes = 0;
+    for (size_t k = 0; k < 6; k++)
+    {
+        if (glIsEnabled(GL_CLIP_PLANE0 + k))
+        {
+            glGetClipPlane(GL_CLIP_PLANE0 + k,
+                           projection_state.clip_planes[projection_state.num_clip_planes]);
+            projection_state.num_clip_planes++;
+        }
+    }
+
+    return projection_state;
+}
+
+BoxVisibility getBoxVisibility(const double* const box_min,
+                               const double* const box_max,
+                               const ProjectionState& projection_state)
+{
+    double eye_corners[8][4], clip_corners[8][4];
+    for (size_t k = 0; k < 8; k++)
+    {
+        const double corner[4] = {(k & 1) ? box_max[0] : box_min[0],
+                                  (k & 2) ? box_max[1] : box_min[1],
+                                  (k & 4) ? box_max[2] : box_min[2],
+                                  1.0};
+        multiplyMatVec4(projection_state.modelview, corner, eye_corners[k]);
+        multiplyMatVec4(projection_state.projection, eye_corners[k], clip_corners[k]);
+    }
+
+    bool is_inside = true;
+    const auto test_plane = [&is_inside](const double* const distances) -> bool {
+        size_t num_outside = 0;
+        for (size_t k = 0; k < 8; k++)
+        {
+            num_outside += distances[k] < 0.0 ? 1 : 0;
+        }
+        is_inside = is_inside && (num_outside == 0);
+        return num_outside < 8;
+    };
+
+    double distances[8];
+    for (size_t p = 0; p < projection_state.num_clip_planes; p++)
+    {
+        const double* const plane = projection_state.clip_planes[p];
+        for (size_t k = 0; k < 8; k++)
+        {
+            distances[k] = plane[0] * eye_corners[k][0] + plane[1] * eye_corners[k][1] +
+                           plane[2] * eye_corners[k][2] + plane[3] * eye_corners[k][3];
+        }
+        if (!test_plane(distances))
+        {
+            return BoxVisibility::OUTSIDE;
+        }
+    }
+
+    // View frustum, -w <= x, y, z <= w
+    for (size_t dim = 0; dim < 3; dim++)
+    {
+        for (const double sign : {1.0, -1.0})
+        {
+            for (size_t k = 0; k < 8; k++)
+            {
+                distances[k] = clip_corners[k][3] + sign * clip_corners[k][dim];
+            }
+            if (!test_plane(distances))
+            {
+                return BoxVisibility::OUTSIDE;
+            }
+        }
+    }
+
+    return is_inside ? BoxVisibility::INSIDE : BoxVisibility::PARTIAL;
+}
+
+namespace
+{
+void drawArraysInWindowCoordinates(const GLenum mode,
+                                   const float* const vertices,
+                                   const size_t num_vertices,
+                                   const ProjectionState& projection_state)
+{
+    bool clip_plane_enabled[6];
+    for (size_t k = 0; k < 6; k++)
+    {
+        clip_plane_enabled[k] = glIsEnabled(GL_CLIP_PLANE0 + k);
+        glDisable(GL_CLIP_PLANE0 + k);
+    }
+
+    const int* const vp = projection_state.viewport;
+
+    glMatrixMode(GL_PROJECTION);
+    glPushMatrix();
+    glLoadIdentity();
+    // Maps z = 0 to depth 0 and z = 1 to depth 1
+    glOrtho(vp[0], vp[0] + vp[2], vp[1], vp[1] + vp[3], 0.0, -1.0);
+
+    glMatrixMode(GL_MODELVIEW);
+    glPushMatrix();
+    glLoadIdentity();
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glVertexPointer(3, GL_FLOAT, 0, vertices);
+    glDrawArrays(mode, 0, num_vertices);
+    glDisableClientState(GL_VERTEX_ARRAY);
+
+    glPopMatrix();
+    glMatrixMode(GL_PROJECTION);
+    glPopMatrix();
+    glMatrixMode(GL_MODELVIEW);
+
+    for (size_t k = 0; k < 6; k++)
+    {
+        if (clip_plane_enabled[k])
+        {
+            glEnable(GL_CLIP_PLANE0 + k);
+        }
+    }
+}
+}  // namespace
+
+void drawLinesInWindowCoordinates(const float* const vertices,
+                                  const size_t num_vertices,
+                                  const ProjectionState& projection_state)
+{
+    assert((num_vertices % 2) == 0);
+    drawArraysInWindowCoordinates(GL_LINES, vertices, num_vertices, projection_state);
+}
+
+void drawTrianglesInWindowCoordinates(const float* const vertices,
+                                      const size_t num_vertices,
+                                      const ProjectionState& projection_state)
+{
+    assert((num_vertices % 3) == 0);
+    drawArraysInWindowCoordinates(GL_TRIANGLES, vertices, num_vertices, projection_state);
+}
@@ -3,6 +3,8 @@
 
 #include <arl/math/math.h>
 
+#include <stdint.h>
+
 #include <cstddef>
 #include <vector>
 
@@ -26,4 +28,79 @@ void drawPolygon3D(const arl::Vec3Dd& c0,
 void drawPoints3D(const arl::Vectord& x_values,
                   const arl::Vectord& y_values,
                   const arl::Vectord& z_values);
+void drawLineStrip3D(const double* const x_values,
+                     const double* const y_values,
+                     const double* const z_values,
+                     const size_t num_values);
+void drawLineStrip3D(const float* const x_values,
+                     const float* const y_values,
+                     const float* const z_values,
+                     const size_t num_values);
+void drawPoints3D(const double* const x_values,
+                  const double* const y_values,
+                  const double* const z_values,
+                  const size_t num_values);
+void drawPoints3D(const float* const x_values,
+                  const float* const y_values,
+                  const float* const z_values,
+                  const size_t num_values);
+
+// Vertex array versions, vertices and colors are packed as x, y, z and r, g, b.
+// If colors is nullptr, the current color is used.
+void drawIndexedQuads3D(const float* const vertices,
+                        const float* const colors,
+                        const uint32_t* const indices,
+                        const size_t num_indices);
+void drawIndexedLines3D(const float* const vertices,
+                        const uint32_t* const indices,
+                        const size_t num_indices);
+void drawPointArray3D(const float* const vertices, const size_t num_vertices);
+void drawLineArray3D(const float* const vertices, const size_t num_vertices);
+
+// Transform from model to window coordinates of the current OpenGL state
+struct ProjectionState
+{
+    double modelview[16];
+    double projection[16];
+    int viewport[4];
+    size_t num_clip_planes;
+    double clip_planes[6][4];  // Enabled clip planes, in eye coordinates
+};
+
+bool operator==(const ProjectionState& ps0, const ProjectionState& ps1);
+bool operator!=(const ProjectionState& ps0, const ProjectionState& ps1);
+ProjectionState getProjectionState();
+
+enum class BoxVisibility
+{
+    OUTSIDE,
+    PARTIAL,
+    INSIDE
+};
+
+// Visibility of an axis aligned box in model coordinates, with respect to the view volume
+// and the enabled clip planes
+BoxVisibility getBoxVisibility(const double* const box_min,
+                               const double* const box_max,
+                               const ProjectionState& projection_state);
+
+// res = m * v, with m a column major 4x4 matrix as used by OpenGL
+inline void multiplyMatVec4(const double* const m, const double* const v, double* const res)
+{
+    for (size_t r = 0; r < 4; r++)
+    {
+        res[r] = m[r] * v[0] + m[4 + r] * v[1] + m[8 + r] * v[2] + m[12 + r] * v[3];
+    }
+}
+
+// Draws lines/triangles from vertices given as x, y in window coordinates (pixels) and depth
+// in [0, 1]. Clip planes are disabled while drawing, as they are given in the eye coordinates
+// of the model transform, so vertices have to be clipped before being converted to window
+// coordinates.
+void drawLinesInWindowCoordinates(const float* const vertices,
+                                  const size_t num_vertices,
+                                  const ProjectionState& projection_state);
+void drawTrianglesInWindowCoordinates(const float* const vertices,
+                                      const size_t num_vertices,
+                                      const ProjectionState& projection_state);
 #endif
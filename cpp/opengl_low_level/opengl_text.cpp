@@ -86,6 +86,16 @@ void drawTextFromTopLeft(const std::string s, float x, float y)
     }
 }*/
 
+namespace
+{
+bool text_rendering_enabled = true;
+}
+
+void setTextRenderingEnabled(const bool enabled)
+{
+    text_rendering_enabled = enabled;
+}
+
 void putTextAt(const std::string& s, const arl::Vec2Dd& v)
 {
     putTextAt(s, v.x, v.y);
@@ -97,6 +107,10 @@ void putTextAt3D(const std::string& s, const arl::Vec3Dd& v)
 
 void putTextAt(const std::string& s, const double x, const double y)
 {
+    if (!text_rendering_enabled)
+    {
+        return;
+    }
     glRasterPos2f(x, y);
 
     for (size_t i = 0; i < s.length(); i++)
@@ -111,6 +125,10 @@ void putTextAt(const std::string& s, const double x, const double y)
 
 void putTextAt3D(const std::string& s, const double x, const double y, const double z)
 {
+    if (!text_rendering_enabled)
+    {
+        return;
+    }
     glRasterPos3f(x, y, z);
 
     for (size_t i = 0; i < s.length(); i++)
@@ -13,6 +13,9 @@ void drawTextFromTopLeft(const std::string s, float x, float y);
 double calculateStringWidth(const std::string& s);
 double calculateStringHeight();*/
 
+// Text is drawn with glut bitmap fonts, which requires glutInit to have been called
+void setTextRenderingEnabled(const bool enabled);
+
 void putTextAt(const std::string& s, const arl::Vec2Dd& v);
 void putTextAt3D(const std::string& s, const arl::Vec3Dd& v);
 void putTextAt(const std::string& s, const double x, const double y);
@@ -0,0 +1,106 @@
+#include "plot_functions/chunk_bounds.h"
+
+#include <algorithm>
+#include <limits>
+
+constexpr size_t ChunkBounds::chunk_size;
+
+ChunkBounds::ChunkBounds() : num_points_(0), is_line_strip_(false), is_valid_(false) {}
+
+size_t ChunkBounds::getChunkEnd(const size_t chunk_idx) const
+{
+    return std::min((chunk_idx + 1) * chunk_size + (is_line_strip_ ? 1 : 0), num_points_);
+}
+
+template <typename T>
+ChunkBounds::ChunkBounds(const T* const x_values,
+                         const T* const y_values,
+                         const T* const z_values,
+                         const size_t num_points,
+                         const bool is_line_strip)
+    : num_points_(num_points), is_line_strip_(is_line_strip), is_valid_(false)
+{
+    const size_t num_chunks = (num_points_ + chunk_size - 1) / chunk_size;
+    boxes_.resize(6 * num_chunks);
+
+    for (size_t chunk_idx = 0; chunk_idx < num_chunks; chunk_idx++)
+    {
+        double* const box_min = boxes_.data() + 6 * chunk_idx;
+        double* const box_max = box_min + 3;
+        std::fill(box_min, box_min + 3, std::numeric_limits<double>::max());
+        std::fill(box_max, box_max + 3, std::numeric_limits<double>::lowest());
+
+        const size_t idx_from = chunk_idx * chunk_size;
+        const size_t idx_to = getChunkEnd(chunk_idx);
+        for (size_t k = idx_from; k < idx_to; k++)
+        {
+            box_min[0] = std::min<double>(box_min[0], x_values[k]);
+            box_min[1] = std::min<double>(box_min[1], y_values[k]);
+            box_max[0] = std::max<double>(box_max[0], x_values[k]);
+            box_max[1] = std::max<double>(box_max[1], y_values[k]);
+        }
+
+        if (z_values == nullptr)
+        {
+            box_min[2] = 0.0;
+            box_max[2] = 0.0;
+        }
+        else
+        {
+            for (size_t k = idx_from; k < idx_to; k++)
+            {
+                box_min[2] = std::min<double>(box_min[2], z_values[k]);
+                box_max[2] = std::max<double>(box_max[2], z_values[k]);
+            }
+        }
+    }
+}
+
+const std::vector<std::pair<size_t, size_t>>& ChunkBounds::getVisibleRanges()
+{
+    const ProjectionState projection_state = getProjectionState();
+    if (is_valid_ && (projection_state == projection_state_))
+    {
+        return visible_ranges_;
+    }
+    projection_state_ = projection_state;
+    is_valid_ = true;
+
+    visible_ranges_.clear();
+
+    const size_t num_chunks = boxes_.size() / 6;
+    for (size_t chunk_idx = 0; chunk_idx < num_chunks; chunk_idx++)
+    {
+        const double* const box_min = boxes_.data() + 6 * chunk_idx;
+        if (getBoxVisibility(box_min, box_min + 3, projection_state_) == BoxVisibility::OUTSIDE)
+        {
+            continue;
+        }
+
+        const size_t idx_from = chunk_idx * chunk_size;
+        const size_t idx_to = getChunkEnd(chunk_idx);
+
+        // Line strip chunks overlap by one point
+        if (!visible_ranges_.empty() && (visible_ranges_.back().second >= idx_from))
+        {
+            visible_ranges_.back().second = idx_to;
+        }
+        else
+        {
+            visible_ranges_.push_back({idx_from, idx_to});
+        }
+    }
+
+    return visible_ranges_;
+}
+
+template ChunkBounds::ChunkBounds(const float* const x_values,
+                                  const float* const y_values,
+                                  const float* const z_values,
+                                  const size_t num_points,
+                                  const bool is_line_strip);
+template ChunkBounds::ChunkBounds(const double* const x_values,
+                                  const double* const y_values,
+                                  const double* const z_values,
+                                  const size_t num_points,
+                                  const bool is_line_strip);
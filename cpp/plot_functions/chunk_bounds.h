@@ -0,0 +1,45 @@
+#ifndef CHUNK_BOUNDS_H_
+#define CHUNK_BOUNDS_H_
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "opengl_low_level/opengl_low_level.h"
+
+// Bounding boxes of consecutive chunks of points, so that chunks entirely outside of the
+// axes box (the clip planes) or the view can be skipped instead of being clipped per vertex.
+// For line strips, each chunk also contains the first point of the next chunk, so that the
+// segment connecting them is kept.
+class ChunkBounds
+{
+private:
+    size_t num_points_;
+    bool is_line_strip_;
+    std::vector<double> boxes_;  // min x, y, z and max x, y, z for each chunk
+
+    ProjectionState projection_state_;
+    bool is_valid_;
+    std::vector<std::pair<size_t, size_t>> visible_ranges_;
+
+    size_t getChunkEnd(const size_t chunk_idx) const;
+
+public:
+    static constexpr size_t chunk_size = 4096;
+
+    ChunkBounds();
+    // z_values may be nullptr for 2D points, which are at z = 0. Instantiated for float and
+    // double values.
+    template <typename T>
+    ChunkBounds(const T* const x_values,
+                const T* const y_values,
+                const T* const z_values,
+                const size_t num_points,
+                const bool is_line_strip);
+
+    // Ranges of points [first, second) of the chunks that may be visible in the current
+    // OpenGL view, with adjacent chunks merged. Only recomputed when the view changes.
+    const std::vector<std::pair<size_t, size_t>>& getVisibleRanges();
+};
+
+#endif
@@ -0,0 +1,130 @@
+#include "plot_functions/color_lut.h"
+
+#include <arl/math/math.h>
+#include <arl/utilities/color_map.h>
+#include <arl/utilities/logging.h>
+#include <stdint.h>
+
+#include <algorithm>
+
+#include "communication/rx_list.h"
+
+ColorLut::ColorLut() : num_entries_(0) {}
+
+ColorLut::ColorLut(const arl::RGBColorMap<float>& c_map, const size_t num_entries)
+    : rgba_(4 * num_entries), num_entries_(num_entries)
+{
+    ASSERT(num_entries > 1) << "Color lookup table needs at least two entries!";
+
+    for (size_t k = 0; k < num_entries_; k++)
+    {
+        const RGBTripletf color = c_map(static_cast<double>(k) / (num_entries_ - 1));
+        rgba_[4 * k] = color.red;
+        rgba_[4 * k + 1] = color.green;
+        rgba_[4 * k + 2] = color.blue;
+        rgba_[4 * k + 3] = 1.0f;
+    }
+}
+
+ColorLut::ColorLut(const double* const red,
+                   const double* const green,
+                   const double* const blue,
+                   const size_t num_colors,
+                   const size_t num_entries)
+    : rgba_(4 * num_entries), num_entries_(num_entries)
+{
+    ASSERT(num_entries > 1) << "Color lookup table needs at least two entries!";
+    ASSERT(num_colors > 1) << "Custom color map needs at least two colors!";
+
+    for (size_t k = 0; k < num_entries_; k++)
+    {
+        const double pos = static_cast<double>(k) * (num_colors - 1) / (num_entries_ - 1);
+        const size_t idx0 = std::min(static_cast<size_t>(pos), num_colors - 2);
+        const double t = pos - idx0;
+
+        rgba_[4 * k] = (1.0 - t) * red[idx0] + t * red[idx0 + 1];
+        rgba_[4 * k + 1] = (1.0 - t) * green[idx0] + t * green[idx0 + 1];
+        rgba_[4 * k + 2] = (1.0 - t) * blue[idx0] + t * blue[idx0 + 1];
+        rgba_[4 * k + 3] = 1.0f;
+    }
+}
+
+size_t ColorLut::numEntries() const
+{
+    return num_entries_;
+}
+
+bool ColorLut::isEmpty() const
+{
+    return num_entries_ == 0;
+}
+
+RGBTripletf ColorLut::operator()(const double normalized_value) const
+{
+    const double max_idx = static_cast<double>(num_entries_ - 1);
+    const double scaled_value = std::max(0.0, std::min(normalized_value * max_idx, max_idx));
+    const float* const entry = rgba_.data() + 4 * static_cast<size_t>(scaled_value + 0.5);
+
+    return RGBTripletf(entry[0], entry[1], entry[2]);
+}
+
+void ColorLut::mapValues(const double* const values,
+                         const size_t num_values,
+                         const arl::Interval1D<double> min_max_interval,
+                         float* const rgb_out) const
+{
+    ASSERT(!isEmpty()) << "Color lookup table is empty!";
+
+    const double max_idx = static_cast<double>(num_entries_ - 1);
+    const double interval_length = min_max_interval.to - min_max_interval.from;
+    const double scale = interval_length > 0.0 ? max_idx / interval_length : 0.0;
+    const double offset = -min_max_interval.from * scale + 0.5;
+
+    // Indices are computed in blocks in a loop without dependencies or branches, which
+    // the compiler turns into SIMD code, before the (scalar) table lookups
+    const size_t block_size = 256;
+    int32_t indices[block_size];
+
+    for (size_t block_start = 0; block_start < num_values; block_start += block_size)
+    {
+        const size_t block_end = std::min(block_start + block_size, num_values);
+        const size_t num_block_values = block_end - block_start;
+        const double* const block_values = values + block_start;
+
+        for (size_t k = 0; k < num_block_values; k++)
+        {
+            const double idx = block_values[k] * scale + offset;
+            indices[k] = static_cast<int32_t>(std::max(0.0, std::min(idx, max_idx)));
+        }
+
+        float* const block_rgb_out = rgb_out + 3 * block_start;
+        for (size_t k = 0; k < num_block_values; k++)
+        {
+            const float* const entry = rgba_.data() + 4 * indices[k];
+            block_rgb_out[3 * k] = entry[0];
+            block_rgb_out[3 * k + 1] = entry[1];
+            block_rgb_out[3 * k + 2] = entry[2];
+        }
+    }
+}
+
+const ColorLut& getBuiltInColorLut(const int color_map)
+{
+    static const ColorLut jet_lut(arl::color_maps::jetf);
+    static const ColorLut rainbow_lut(arl::color_maps::rainbowf);
+    static const ColorLut magma_lut(arl::color_maps::magmaf);
+    static const ColorLut viridis_lut(arl::color_maps::viridisf);
+
+    switch (color_map)
+    {
+        case plot_tool::ColorMap::RAINBOW:
+            return rainbow_lut;
+        case plot_tool::ColorMap::MAGMA:
+            return magma_lut;
+        case plot_tool::ColorMap::VIRIDIS:
+            return viridis_lut;
+        case plot_tool::ColorMap::JET:
+        default:
+            return jet_lut;
+    }
+}
@@ -0,0 +1,51 @@
+#ifndef COLOR_LUT_H_
+#define COLOR_LUT_H_
+
+#include <arl/math/math.h>
+#include <arl/utilities/color_map.h>
+
+#include <vector>
+
+#include "opengl_low_level/data_structures.h"
+
+// Color map sampled into a fixed size RGBA table, so that mapping a value to a color
+// is a clamp, a multiply and a table lookup instead of evaluating the color map.
+class ColorLut
+{
+private:
+    std::vector<float> rgba_;  // r, g, b, a for each entry
+    size_t num_entries_;
+
+public:
+    static constexpr size_t default_num_entries = 4096;
+
+    ColorLut();
+    ColorLut(const arl::RGBColorMap<float>& c_map,
+             const size_t num_entries = default_num_entries);
+    // Custom color map from num_colors control colors, equally spaced over [0, 1] and
+    // linearly interpolated in between
+    ColorLut(const double* const red,
+             const double* const green,
+             const double* const blue,
+             const size_t num_colors,
+             const size_t num_entries = default_num_entries);
+
+    size_t numEntries() const;
+    bool isEmpty() const;
+
+    // Color for a value in [0, 1], values outside are clamped
+    RGBTripletf operator()(const double normalized_value) const;
+
+    // Maps values in min_max_interval to colors, written as packed r, g, b to rgb_out.
+    // Values outside the interval are clamped.
+    void mapValues(const double* const values,
+                   const size_t num_values,
+                   const arl::Interval1D<double> min_max_interval,
+                   float* const rgb_out) const;
+};
+
+// Tables for the built in color maps, ColorMap::JET etc. from plot_attributes.h.
+// They are created on first use and shared by all plot objects.
+const ColorLut& getBuiltInColorLut(const int color_map);
+
+#endif
@@ -0,0 +1,365 @@
+#include "plot_functions/line_batch.h"
+
+#include <arl/utilities/logging.h>
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+namespace
+{
+// Dash patterns as alternating on/off lengths, in units of the line width
+std::vector<float> createDashPattern(const plot_tool::LineStyle& line_style)
+{
+    const std::string style(line_style.data);
+
+    if (style.empty() || (style == "-"))
+    {
+        return std::vector<float>();
+    }
+    else if (style == "--")
+    {
+        return {6.0f, 4.0f};
+    }
+    else if (style == ":")
+    {
+        return {1.0f, 2.0f};
+    }
+    else if (style == "-.")
+    {
+        return {6.0f, 3.0f, 1.0f, 3.0f};
+    }
+    else
+    {
+        LOG_WARNING() << "Unsupported line style \"" << style << "\", using solid line!";
+        return std::vector<float>();
+    }
+}
+
+// Shrinks [t0, t1] so that p(t) = p0 + t * (p1 - p0) stays in the half space where the plane
+// equation is non negative, with d0 and d1 the plane equation evaluated at p0 and p1
+inline bool clipToHalfSpace(const double d0, const double d1, double& t0, double& t1)
+{
+    if ((d0 < 0.0) && (d1 < 0.0))
+    {
+        return false;
+    }
+    else if (d0 < 0.0)
+    {
+        t0 = std::max(t0, d0 / (d0 - d1));
+    }
+    else if (d1 < 0.0)
+    {
+        t1 = std::min(t1, d0 / (d0 - d1));
+    }
+    return t0 <= t1;
+}
+
+inline void clipToWindowCoordinates(const double* const clip_point,
+                                    const int* const vp,
+                                    float* const window_point)
+{
+    const double w_inv = 1.0 / clip_point[3];
+    window_point[0] = vp[0] + (clip_point[0] * w_inv + 1.0) * 0.5 * vp[2];
+    window_point[1] = vp[1] + (clip_point[1] * w_inv + 1.0) * 0.5 * vp[3];
+    window_point[2] = (clip_point[2] * w_inv + 1.0) * 0.5;
+}
+
+inline float windowDistance(const float* const p0, const float* const p1)
+{
+    return std::sqrt((p1[0] - p0[0]) * (p1[0] - p0[0]) + (p1[1] - p0[1]) * (p1[1] - p0[1]));
+}
+}  // namespace
+
+LineBatch::LineBatch() : line_width_(1.0f), is_valid_(false) {}
+
+LineBatch::LineBatch(const plot_tool::LineStyle& line_style, const float line_width)
+    : dash_pattern_(createDashPattern(line_style)), line_width_(line_width), is_valid_(false)
+{
+    const float dash_unit = std::max(line_width_, 1.0f);
+    for (size_t k = 0; k < dash_pattern_.size(); k++)
+    {
+        dash_pattern_[k] *= dash_unit;
+    }
+}
+
+bool LineBatch::isNeeded() const
+{
+    return usesTriangles() || !dash_pattern_.empty();
+}
+
+bool LineBatch::usesTriangles() const
+{
+    return line_width_ > 1.0f;
+}
+
+void LineBatch::invalidate()
+{
+    is_valid_ = false;
+}
+
+void LineBatch::addDash(const float* const p0,
+                        const float* const p1,
+                        const float cap_length,
+                        std::vector<float>& vertices) const
+{
+    if (!usesTriangles())
+    {
+        vertices.insert(vertices.end(), {p0[0], p0[1], p0[2], p1[0], p1[1], p1[2]});
+        return;
+    }
+
+    const float length = windowDistance(p0, p1);
+    if (length < 1e-6f)
+    {
+        return;
+    }
+
+    const float dx = (p1[0] - p0[0]) / length;
+    const float dy = (p1[1] - p0[1]) / length;
+    const float half_width = 0.5f * line_width_;
+    const float nx = -dy * half_width, ny = dx * half_width;
+
+    const float x0 = p0[0] - dx * cap_length, y0 = p0[1] - dy * cap_length;
+    const float x1 = p1[0] + dx * cap_length, y1 = p1[1] + dy * cap_length;
+
+    vertices.insert(vertices.end(),
+                    {x0 - nx, y0 - ny, p0[2], x0 + nx, y0 + ny, p0[2], x1 + nx, y1 + ny, p1[2],
+                     x0 - nx, y0 - ny, p0[2], x1 + nx, y1 + ny, p1[2], x1 - nx, y1 - ny, p1[2]});
+}
+
+template <typename T>
+void LineBatch::update(const T* const x_values,
+                       const T* const y_values,
+                       const T* const z_values,
+                       const size_t num_points,
+                       ThreadPool& thread_pool)
+{
+    const ProjectionState projection_state = getProjectionState();
+    if (is_valid_ && (projection_state == projection_state_))
+    {
+        return;
+    }
+    projection_state_ = projection_state;
+
+    const size_t num_segments = num_points > 1 ? num_points - 1 : 0;
+    const size_t chunk_size = 16384;
+    const size_t num_chunks = (num_segments + chunk_size - 1) / chunk_size;
+    segments_.resize(num_segments);
+    chunk_vertices_.resize(num_chunks);
+    std::vector<double> chunk_start_lengths(num_chunks + 1, 0.0);
+
+    const int* const vp = projection_state_.viewport;
+
+    // Project and clip all segments, and sum up their projected lengths per chunk
+    thread_pool.parallelFor(num_chunks, [&](const size_t chunk_from, const size_t chunk_to) {
+        for (size_t chunk_idx = chunk_from; chunk_idx < chunk_to; chunk_idx++)
+        {
+            double chunk_length = 0.0;
+
+            const size_t segment_end = std::min(num_segments, (chunk_idx + 1) * chunk_size);
+            for (size_t k = chunk_idx * chunk_size; k < segment_end; k++)
+            {
+                ProjectedSegment& segment = segments_[k];
+                segment.is_visible = false;
+                segment.length = 0.0f;
+
+                const double model_points[2][4] = {
+                    {x_values[k], y_values[k], z_values == nullptr ? 0.0 : z_values[k], 1.0},
+                    {x_values[k + 1],
+                     y_values[k + 1],
+                     z_values == nullptr ? 0.0 : z_values[k + 1],
+                     1.0}};
+                double eye_points[2][4], clip_points[2][4];
+                multiplyMatVec4(projection_state_.modelview, model_points[0], eye_points[0]);
+                multiplyMatVec4(projection_state_.modelview, model_points[1], eye_points[1]);
+                multiplyMatVec4(projection_state_.projection, eye_points[0], clip_points[0]);
+                multiplyMatVec4(projection_state_.projection, eye_points[1], clip_points[1]);
+
+                double t0 = 0.0, t1 = 1.0;
+                bool is_visible = std::isfinite(clip_points[0][3] + clip_points[1][3]);
+
+                for (size_t p = 0; is_visible && (p < projection_state_.num_clip_planes); p++)
+                {
+                    const double* const plane = projection_state_.clip_planes[p];
+                    const double d0 = plane[0] * eye_points[0][0] + plane[1] * eye_points[0][1] +
+                                      plane[2] * eye_points[0][2] + plane[3] * eye_points[0][3];
+                    const double d1 = plane[0] * eye_points[1][0] + plane[1] * eye_points[1][1] +
+                                      plane[2] * eye_points[1][2] + plane[3] * eye_points[1][3];
+                    is_visible = clipToHalfSpace(d0, d1, t0, t1);
+                }
+
+                // View frustum, -w <= x, y, z <= w
+                for (size_t dim = 0; is_visible && (dim < 3); dim++)
+                {
+                    is_visible = clipToHalfSpace(clip_points[0][3] + clip_points[0][dim],
+                                                 clip_points[1][3] + clip_points[1][dim],
+                                                 t0,
+                                                 t1) &&
+                                 clipToHalfSpace(clip_points[0][3] - clip_points[0][dim],
+                                                 clip_points[1][3] - clip_points[1][dim],
+                                                 t0,
+                                                 t1);
+                }
+
+                double visible_points[2][4];
+                for (size_t i = 0; i < 4; i++)
+                {
+                    const double delta = clip_points[1][i] - clip_points[0][i];
+                    visible_points[0][i] = clip_points[0][i] + t0 * delta;
+                    visible_points[1][i] = clip_points[0][i] + t1 * delta;
+                }
+
+                if (!is_visible || (visible_points[0][3] <= 0.0) || (visible_points[1][3] <= 0.0))
+                {
+                    // Keeps the dash phase of the following segments where possible
+                    if ((clip_points[0][3] > 0.0) && (clip_points[1][3] > 0.0))
+                    {
+                        float p0[3], p1[3];
+                        clipToWindowCoordinates(clip_points[0], vp, p0);
+                        clipToWindowCoordinates(clip_points[1], vp, p1);
+                        segment.length = windowDistance(p0, p1);
+                    }
+                    chunk_length += segment.length;
+                    continue;
+                }
+
+                clipToWindowCoordinates(visible_points[0], vp, segment.p0);
+                clipToWindowCoordinates(visible_points[1], vp, segment.p1);
+                segment.is_visible = true;
+                segment.visible_start = 0.0f;
+                segment.length = windowDistance(segment.p0, segment.p1);
+
+                // Measure the dash phase from the unclipped start point, so that dashes don't
+                // move along the line when it is clipped differently
+                if ((clip_points[0][3] > 0.0) && (clip_points[1][3] > 0.0))
+                {
+                    float p0[3], p1[3];
+                    clipToWindowCoordinates(clip_points[0], vp, p0);
+                    clipToWindowCoordinates(clip_points[1], vp, p1);
+                    segment.visible_start = windowDistance(p0, segment.p0);
+                    segment.length = std::max(segment.length, windowDistance(p0, p1));
+                }
+
+                chunk_length += segment.length;
+            }
+
+            chunk_start_lengths[chunk_idx + 1] = chunk_length;
+        }
+    });
+
+    for (size_t k = 0; k < num_chunks; k++)
+    {
+        chunk_start_lengths[k + 1] += chunk_start_lengths[k];
+    }
+
+    float dash_period = 0.0f;
+    for (size_t k = 0; k < dash_pattern_.size(); k++)
+    {
+        dash_period += dash_pattern_[k];
+    }
+
+    // Split the visible segments into dashes, and expand them to triangles for wide lines
+    thread_pool.parallelFor(num_chunks, [&](const size_t chunk_from, const size_t chunk_to) {
+        for (size_t chunk_idx = chunk_from; chunk_idx < chunk_to; chunk_idx++)
+        {
+            std::vector<float>& vertices = chunk_vertices_[chunk_idx];
+            vertices.clear();
+
+            double line_length = chunk_start_lengths[chunk_idx];
+
+            const size_t segment_end = std::min(num_segments, (chunk_idx + 1) * chunk_size);
+            for (size_t k = chunk_idx * chunk_size; k < segment_end; k++)
+            {
+                const ProjectedSegment& segment = segments_[k];
+                const double segment_start_length = line_length;
+                line_length += segment.length;
+
+                if (!segment.is_visible)
+                {
+                    continue;
+                }
+                else if (dash_pattern_.empty())
+                {
+                    // Square caps, to cover the gaps at the joints of wide lines
+                    addDash(segment.p0, segment.p1, 0.5f * line_width_, vertices);
+                    continue;
+                }
+
+                const float visible_length = windowDistance(segment.p0, segment.p1);
+                if (visible_length < 1e-6f)
+                {
+                    continue;
+                }
+
+                // Current position on the visible part of the segment and in the dash pattern
+                float pos = 0.0f;
+                float phase = std::fmod(segment_start_length + segment.visible_start, dash_period);
+                phase = std::isfinite(phase) ? phase : 0.0f;
+                size_t dash_idx = 0;
+                while (phase >= dash_pattern_[dash_idx])
+                {
+                    phase -= dash_pattern_[dash_idx];
+                    dash_idx = (dash_idx + 1) % dash_pattern_.size();
+                }
+
+                while (pos < visible_length)
+                {
+                    const float next_pos =
+                        std::min(visible_length, pos + dash_pattern_[dash_idx] - phase);
+
+                    // Even indices of the pattern are the dashes, odd are the gaps
+                    if ((dash_idx % 2) == 0)
+                    {
+                        float p0[3], p1[3];
+                        const float s0 = pos / visible_length, s1 = next_pos / visible_length;
+                        for (size_t i = 0; i < 3; i++)
+                        {
+                            p0[i] = segment.p0[i] + s0 * (segment.p1[i] - segment.p0[i]);
+                            p1[i] = segment.p0[i] + s1 * (segment.p1[i] - segment.p0[i]);
+                        }
+                        addDash(p0, p1, 0.0f, vertices);
+                    }
+
+                    pos = next_pos;
+                    phase = 0.0f;
+                    dash_idx = (dash_idx + 1) % dash_pattern_.size();
+                }
+            }
+        }
+    });
+
+    is_valid_ = true;
+}
+
+void LineBatch::draw() const
+{
+    for (size_t k = 0; k < chunk_vertices_.size(); k++)
+    {
+        if (chunk_vertices_[k].empty())
+        {
+            continue;
+        }
+        else if (usesTriangles())
+        {
+            drawTrianglesInWindowCoordinates(
+                chunk_vertices_[k].data(), chunk_vertices_[k].size() / 3, projection_state_);
+        }
+        else
+        {
+            drawLinesInWindowCoordinates(
+                chunk_vertices_[k].data(), chunk_vertices_[k].size() / 3, projection_state_);
+        }
+    }
+}
+
+template void LineBatch::update<float>(const float* const x_values,
+                                       const float* const y_values,
+                                       const float* const z_values,
+                                       const size_t num_points,
+                                       ThreadPool& thread_pool);
+template void LineBatch::update<double>(const double* const x_values,
+                                        const double* const y_values,
+                                        const double* const z_values,
+                                        const size_t num_points,
+                                        ThreadPool& thread_pool);
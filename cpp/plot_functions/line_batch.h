@@ -0,0 +1,64 @@
+#ifndef LINE_BATCH_H_
+#define LINE_BATCH_H_
+
+#include <arl/utilities/logging.h>
+
+#include <vector>
+
+#include "communication/rx_list.h"
+#include "misc/thread_pool.h"
+#include "opengl_low_level/opengl_low_level.h"
+
+// Lines for plot and plot3, with a LineStyle from plot_attributes.h and a width in pixels.
+// All segments are projected to window coordinates, clipped, split into dashes and, for
+// wide lines, expanded to two triangles per dash. This is done in parallel, and only when
+// the view has changed since the last frame, so wide and dashed lines are drawn with a
+// single glDrawArrays call per chunk of segments, just as thin lines.
+class LineBatch
+{
+private:
+    // Visible part of a segment in window coordinates, x, y and depth of both end points
+    struct ProjectedSegment
+    {
+        float p0[3];
+        float p1[3];
+        float visible_start;  // Distance along the projected segment to p0, in pixels
+        float length;         // Length of the whole projected segment, in pixels
+        bool is_visible;
+    };
+
+    std::vector<float> dash_pattern_;  // Alternating on/off lengths in pixels, empty if solid
+    float line_width_;
+
+    std::vector<ProjectedSegment> segments_;
+    std::vector<std::vector<float>> chunk_vertices_;
+    ProjectionState projection_state_;
+    bool is_valid_;
+
+    bool usesTriangles() const;
+    void addDash(const float* const p0,
+                 const float* const p1,
+                 const float cap_length,
+                 std::vector<float>& vertices) const;
+
+public:
+    LineBatch();
+    LineBatch(const plot_tool::LineStyle& line_style, const float line_width);
+
+    // Solid lines no wider than one pixel are drawn faster directly with GL_LINES
+    bool isNeeded() const;
+
+    // Regenerates the lines if the current OpenGL projection differs from the one they
+    // were generated for. z_values may be nullptr for 2D lines, which are put at z = 0.
+    // Instantiated for float and double values.
+    template <typename T>
+    void update(const T* const x_values,
+                const T* const y_values,
+                const T* const z_values,
+                const size_t num_points,
+                ThreadPool& thread_pool);
+    void invalidate();
+    void draw() const;
+};
+
+#endif
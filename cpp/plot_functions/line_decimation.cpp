@@ -0,0 +1,172 @@
+#include "plot_functions/line_decimation.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+// Appends the first, min, max and last sample of [idx_from, idx_to), in index order
+template <typename T>
+inline void addColumn(const T* const x_values,
+                      const T* const y_values,
+                      const size_t idx_from,
+                      const size_t idx_to,
+                      const size_t idx_min,
+                      const size_t idx_max,
+                      std::vector<double>& x_out,
+                      std::vector<double>& y_out)
+{
+    const size_t indices[4] = {
+        idx_from, std::min(idx_min, idx_max), std::max(idx_min, idx_max), idx_to - 1};
+
+    for (size_t k = 0; k < 4; k++)
+    {
+        if ((k == 0) || (indices[k] != indices[k - 1]))
+        {
+            x_out.push_back(x_values[indices[k]]);
+            y_out.push_back(y_values[indices[k]]);
+        }
+    }
+}
+}  // namespace
+
+LineDecimation::LineDecimation() : is_valid_(false), is_decimated_(false) {}
+
+void LineDecimation::invalidate()
+{
+    is_valid_ = false;
+}
+
+bool LineDecimation::isDecimated() const
+{
+    return is_decimated_;
+}
+
+const std::vector<double>& LineDecimation::getXValues() const
+{
+    return x_values_;
+}
+
+const std::vector<double>& LineDecimation::getYValues() const
+{
+    return y_values_;
+}
+
+template <typename T>
+void LineDecimation::update(const T* const x_values,
+                            const T* const y_values,
+                            const size_t num_points,
+                            ThreadPool& thread_pool)
+{
+    const ProjectionState projection_state = getProjectionState();
+    if (is_valid_ && (projection_state == projection_state_))
+    {
+        return;
+    }
+    projection_state_ = projection_state;
+    is_valid_ = true;
+    is_decimated_ = false;
+
+    // Clip coordinates of the point (x, y, 0), from the columns of projection * modelview
+    double mvp[16];
+    for (size_t c = 0; c < 4; c++)
+    {
+        multiplyMatVec4(
+            projection_state_.projection, projection_state_.modelview + 4 * c, mvp + 4 * c);
+    }
+    const double ax = mvp[0], bx = mvp[4], cx = mvp[12];
+    const double ay = mvp[1], by = mvp[5], cy = mvp[13];
+    const double w = mvp[15];
+    const int width = projection_state_.viewport[2];
+
+    // Pixel columns are only well defined for orthographic views
+    if ((num_points < 2) || (mvp[3] != 0.0) || (mvp[7] != 0.0) || (w <= 0.0) || (ax == 0.0) ||
+        (width <= 0))
+    {
+        return;
+    }
+
+    // Columns are computed per sample, and clamped to one column on each side of the viewport
+    const double column_scale = 0.5 * width / w;
+    const auto get_column = [&](const size_t k) -> long {
+        const double column =
+            std::floor((ax * x_values[k] + bx * y_values[k] + cx + w) * column_scale);
+        return static_cast<long>(std::max(-1.0, std::min(column, static_cast<double>(width))));
+    };
+
+    const size_t num_parts = thread_pool.getNumThreads() * 4;
+    const size_t part_size = (num_points + num_parts - 1) / num_parts;
+    std::vector<std::vector<double>> part_x(num_parts), part_y(num_parts);
+
+    // Parts are decimated independently, which at most adds a few samples in the columns
+    // where parts meet
+    thread_pool.parallelFor(num_parts, [&](const size_t part_from, const size_t part_to) {
+        for (size_t part_idx = part_from; part_idx < part_to; part_idx++)
+        {
+            const size_t idx_from = std::min(part_idx * part_size, num_points);
+            const size_t idx_to = std::min(idx_from + part_size, num_points);
+            if (idx_from == idx_to)
+            {
+                continue;
+            }
+
+            std::vector<double>& x_out = part_x[part_idx];
+            std::vector<double>& y_out = part_y[part_idx];
+            x_out.reserve(std::min(idx_to - idx_from, 4 * static_cast<size_t>(width) + 8));
+            y_out.reserve(x_out.capacity());
+
+            size_t column_start = idx_from, idx_min = idx_from, idx_max = idx_from;
+            long current_column = get_column(idx_from);
+            double y_min = ay * x_values[idx_from] + by * y_values[idx_from] + cy;
+            double y_max = y_min;
+
+            for (size_t k = idx_from + 1; k < idx_to; k++)
+            {
+                const long column = get_column(k);
+                // Window y, up to a constant offset and scale
+                const double y_window = ay * x_values[k] + by * y_values[k] + cy;
+
+                if (column != current_column)
+                {
+                    addColumn(x_values, y_values, column_start, k, idx_min, idx_max, x_out, y_out);
+                    column_start = k;
+                    current_column = column;
+                    idx_min = k;
+                    idx_max = k;
+                    y_min = y_window;
+                    y_max = y_window;
+                }
+                else if (y_window < y_min)
+                {
+                    y_min = y_window;
+                    idx_min = k;
+                }
+                else if (y_window > y_max)
+                {
+                    y_max = y_window;
+                    idx_max = k;
+                }
+            }
+            addColumn(x_values, y_values, column_start, idx_to, idx_min, idx_max, x_out, y_out);
+        }
+    });
+
+    x_values_.clear();
+    y_values_.clear();
+    for (size_t k = 0; k < num_parts; k++)
+    {
+        x_values_.insert(x_values_.end(), part_x[k].begin(), part_x[k].end());
+        y_values_.insert(y_values_.end(), part_y[k].begin(), part_y[k].end());
+    }
+
+    is_decimated_ = true;
+}
+
+template void LineDecimation::update<float>(const float* const x_values,
+                                            const float* const y_values,
+                                            const size_t num_points,
+                                            ThreadPool& thread_pool);
+template void LineDecimation::update<double>(const double* const x_values,
+                                             const double* const y_values,
+                                             const size_t num_points,
+                                             ThreadPool& thread_pool);
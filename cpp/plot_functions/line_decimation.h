@@ -0,0 +1,41 @@
+#ifndef LINE_DECIMATION_H_
+#define LINE_DECIMATION_H_
+
+#include <vector>
+
+#include "misc/thread_pool.h"
+#include "opengl_low_level/opengl_low_level.h"
+
+// View dependent decimation of 2D lines with sorted x values (M4 aggregation). For every pixel
+// column of the viewport only the first, last, min and max sample are kept, which with the
+// diamond exit rule for line rasterization covers the same pixels as the full line. Meant for
+// the visible part of the line from SortedLineWindow. Only recomputed when the view (axes
+// limits, window size) has changed.
+class LineDecimation
+{
+private:
+    std::vector<double> x_values_;
+    std::vector<double> y_values_;
+    ProjectionState projection_state_;
+    bool is_valid_;
+    bool is_decimated_;
+
+public:
+    LineDecimation();
+
+    // x_values have to be sorted, in ascending or descending order. Leaves the line
+    // undecimated if the view is rotated so that pixel columns don't correspond to x values.
+    // Instantiated for float and double values.
+    template <typename T>
+    void update(const T* const x_values,
+                const T* const y_values,
+                const size_t num_points,
+                ThreadPool& thread_pool);
+    void invalidate();
+
+    bool isDecimated() const;
+    const std::vector<double>& getXValues() const;
+    const std::vector<double>& getYValues() const;
+};
+
+#endif
@@ -0,0 +1,465 @@
+#include "plot_functions/point_octree.h"
+
+#include <arl/utilities/logging.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+const size_t max_num_leaf_primitives = 256;
+const size_t max_depth = 21;
+const size_t max_num_interactive_primitives = 256 * 1024;
+
+double squaredDistanceToBox(const double* const point,
+                            const float* const box_min,
+                            const float* const box_max)
+{
+    double squared_distance = 0.0;
+    for (size_t i = 0; i < 3; i++)
+    {
+        const double d = std::max(std::max(box_min[i] - point[i], point[i] - box_max[i]), 0.0);
+        squared_distance += d * d;
+    }
+    return squared_distance;
+}
+}  // namespace
+
+template <typename T>
+PointOctree::PointOctree(const T* const x_values,
+                         const T* const y_values,
+                         const T* const z_values,
+                         const size_t num_points,
+                         const PrimitiveType primitive_type)
+    : primitive_type_(primitive_type),
+      num_vertices_per_primitive_(primitive_type == PrimitiveType::POINTS ? 1 : 2),
+      is_valid_(false),
+      num_visible_primitives_(0),
+      is_sampled_valid_(false)
+{
+    ASSERT(num_points <= UINT32_MAX) << "Too many points for 32 bit indices!";
+
+    const size_t num_primitives =
+        primitive_type_ == PrimitiveType::POINTS ? num_points : std::max(num_points, size_t(1)) - 1;
+
+    std::vector<float> primitive_vertices(3 * num_vertices_per_primitive_ * num_primitives);
+    std::vector<float> centers(3 * num_primitives);
+    for (size_t k = 0; k < num_primitives; k++)
+    {
+        float* const v = primitive_vertices.data() + 3 * num_vertices_per_primitive_ * k;
+        for (size_t i = 0; i < num_vertices_per_primitive_; i++)
+        {
+            v[3 * i] = x_values[k + i];
+            v[3 * i + 1] = y_values[k + i];
+            v[3 * i + 2] = z_values[k + i];
+        }
+        for (size_t d = 0; d < 3; d++)
+        {
+            centers[3 * k + d] = num_vertices_per_primitive_ == 1 ? v[d] : 0.5f * (v[d] + v[3 + d]);
+        }
+    }
+
+    std::vector<uint32_t> order(num_primitives), order_tmp(num_primitives);
+    for (size_t k = 0; k < num_primitives; k++)
+    {
+        order[k] = k;
+    }
+
+    Node root;
+    root.begin = 0;
+    root.end = num_primitives;
+    nodes_.push_back(root);
+    buildNode(0, centers, order, order_tmp, 0);
+
+    // Vertices are stored in tree order, so that every node is a contiguous range
+    const size_t num_floats_per_primitive = 3 * num_vertices_per_primitive_;
+    vertices_.resize(primitive_vertices.size());
+    for (size_t k = 0; k < num_primitives; k++)
+    {
+        std::copy(primitive_vertices.begin() + num_floats_per_primitive * order[k],
+                  primitive_vertices.begin() + num_floats_per_primitive * (order[k] + 1),
+                  vertices_.begin() + num_floats_per_primitive * k);
+    }
+    primitive_indices_ = std::move(order);
+
+    // Bounding boxes from the leaves and up, children always come after their parent
+    for (size_t n = nodes_.size(); n-- > 0;)
+    {
+        Node& node = nodes_[n];
+        std::fill(node.min, node.min + 3, std::numeric_limits<float>::max());
+        std::fill(node.max, node.max + 3, std::numeric_limits<float>::lowest());
+
+        if (node.num_children == 0)
+        {
+            const float* const v = vertices_.data() + num_floats_per_primitive * node.begin;
+            const size_t num_vertices = num_vertices_per_primitive_ * (node.end - node.begin);
+            for (size_t k = 0; k < num_vertices; k++)
+            {
+                for (size_t d = 0; d < 3; d++)
+                {
+                    node.min[d] = std::min(node.min[d], v[3 * k + d]);
+                    node.max[d] = std::max(node.max[d], v[3 * k + d]);
+                }
+            }
+        }
+        else
+        {
+            for (size_t c = node.first_child; c < node.first_child + node.num_children; c++)
+            {
+                for (size_t d = 0; d < 3; d++)
+                {
+                    node.min[d] = std::min(node.min[d], nodes_[c].min[d]);
+                    node.max[d] = std::max(node.max[d], nodes_[c].max[d]);
+                }
+            }
+        }
+    }
+}
+
+void PointOctree::buildNode(const size_t node_idx,
+                            const std::vector<float>& centers,
+                            std::vector<uint32_t>& order,
+                            std::vector<uint32_t>& order_tmp,
+                            const size_t depth)
+{
+    const uint32_t begin = nodes_[node_idx].begin;
+    const uint32_t end = nodes_[node_idx].end;
+    nodes_[node_idx].first_child = 0;
+    nodes_[node_idx].num_children = 0;
+
+    if (((end - begin) <= max_num_leaf_primitives) || (depth >= max_depth))
+    {
+        return;
+    }
+
+    float center_min[3], center_max[3];
+    std::fill(center_min, center_min + 3, std::numeric_limits<float>::max());
+    std::fill(center_max, center_max + 3, std::numeric_limits<float>::lowest());
+    for (size_t k = begin; k < end; k++)
+    {
+        for (size_t d = 0; d < 3; d++)
+        {
+            center_min[d] = std::min(center_min[d], centers[3 * order[k] + d]);
+            center_max[d] = std::max(center_max[d], centers[3 * order[k] + d]);
+        }
+    }
+
+    float split[3];
+    for (size_t d = 0; d < 3; d++)
+    {
+        split[d] = 0.5f * (center_min[d] + center_max[d]);
+    }
+
+    const auto get_octant = [&](const uint32_t primitive_idx) -> size_t {
+        const float* const c = centers.data() + 3 * primitive_idx;
+        return (c[0] > split[0] ? 1 : 0) + (c[1] > split[1] ? 2 : 0) + (c[2] > split[2] ? 4 : 0);
+    };
+
+    // Stable counting sort of the range into the octants
+    size_t octant_starts[9] = {0};
+    for (size_t k = begin; k < end; k++)
+    {
+        octant_starts[get_octant(order[k]) + 1]++;
+    }
+
+    // All primitives at the same center, can't be split further
+    if (*std::max_element(octant_starts + 1, octant_starts + 9) == (end - begin))
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < 8; i++)
+    {
+        octant_starts[i + 1] += octant_starts[i];
+    }
+    size_t octant_pos[8];
+    std::copy(octant_starts, octant_starts + 8, octant_pos);
+    for (size_t k = begin; k < end; k++)
+    {
+        order_tmp[begin + octant_pos[get_octant(order[k])]++] = order[k];
+    }
+    std::copy(order_tmp.begin() + begin, order_tmp.begin() + end, order.begin() + begin);
+
+    const size_t first_child = nodes_.size();
+    for (size_t i = 0; i < 8; i++)
+    {
+        if (octant_starts[i + 1] > octant_starts[i])
+        {
+            Node child;
+            child.begin = begin + octant_starts[i];
+            child.end = begin + octant_starts[i + 1];
+            nodes_.push_back(child);
+        }
+    }
+    nodes_[node_idx].first_child = first_child;
+    nodes_[node_idx].num_children = nodes_.size() - first_child;
+
+    for (size_t c = first_child; c < first_child + nodes_[node_idx].num_children; c++)
+    {
+        buildNode(c, centers, order, order_tmp, depth + 1);
+    }
+}
+
+void PointOctree::updateVisibleRanges()
+{
+    leaf_ranges_.clear();
+    draw_ranges_.clear();
+    num_visible_primitives_ = 0;
+
+    // Nodes to visit, with a flag for being completely inside the view
+    std::vector<std::pair<uint32_t, bool>> node_stack = {{0, false}};
+    while (!node_stack.empty())
+    {
+        const Node& node = nodes_[node_stack.back().first];
+        bool is_inside = node_stack.back().second;
+        node_stack.pop_back();
+
+        if ((node.end == node.begin) || (node.min[0] > node.max[0]))
+        {
+            continue;
+        }
+
+        if (!is_inside)
+        {
+            const double box_min[3] = {node.min[0], node.min[1], node.min[2]};
+            const double box_max[3] = {node.max[0], node.max[1], node.max[2]};
+            const BoxVisibility visibility =
+                getBoxVisibility(box_min, box_max, projection_state_);
+            if (visibility == BoxVisibility::OUTSIDE)
+            {
+                continue;
+            }
+            is_inside = visibility == BoxVisibility::INSIDE;
+        }
+
+        if (node.num_children == 0)
+        {
+            leaf_ranges_.push_back({node.begin, node.end});
+            num_visible_primitives_ += node.end - node.begin;
+        }
+        else
+        {
+            // Reversed, so that leaves come out in increasing order
+            for (size_t c = node.first_child + node.num_children; c-- > node.first_child;)
+            {
+                node_stack.push_back({c, is_inside});
+            }
+        }
+    }
+
+    for (size_t k = 0; k < leaf_ranges_.size(); k++)
+    {
+        if (!draw_ranges_.empty() && (draw_ranges_.back().second == leaf_ranges_[k].first))
+        {
+            draw_ranges_.back().second = leaf_ranges_[k].second;
+        }
+        else
+        {
+            draw_ranges_.push_back(leaf_ranges_[k]);
+        }
+    }
+}
+
+void PointOctree::updateSampledVertices(const size_t max_num_primitives)
+{
+    const size_t num_floats_per_primitive = 3 * num_vertices_per_primitive_;
+    const double step = static_cast<double>(num_visible_primitives_) / max_num_primitives;
+
+    sampled_vertices_.clear();
+    sampled_vertices_.reserve(num_floats_per_primitive *
+                              (max_num_primitives + leaf_ranges_.size()));
+
+    // Evenly spaced primitives from every leaf, so that all visible parts keep some detail
+    for (size_t k = 0; k < leaf_ranges_.size(); k++)
+    {
+        const size_t num_in_leaf = leaf_ranges_[k].second - leaf_ranges_[k].first;
+        const size_t num_samples = std::ceil(num_in_leaf / step);
+        for (size_t i = 0; i < num_samples; i++)
+        {
+            const size_t idx = leaf_ranges_[k].first + static_cast<size_t>(i * step);
+            const float* const v = vertices_.data() + num_floats_per_primitive * idx;
+            sampled_vertices_.insert(sampled_vertices_.end(), v, v + num_floats_per_primitive);
+        }
+    }
+}
+
+void PointOctree::draw(const bool is_interacting)
+{
+    const ProjectionState projection_state = getProjectionState();
+    if (!is_valid_ || (projection_state != projection_state_))
+    {
+        projection_state_ = projection_state;
+        updateVisibleRanges();
+        is_valid_ = true;
+        is_sampled_valid_ = false;
+    }
+
+    const size_t num_floats_per_primitive = 3 * num_vertices_per_primitive_;
+
+    if (is_interacting && (num_visible_primitives_ > max_num_interactive_primitives))
+    {
+        if (!is_sampled_valid_)
+        {
+            updateSampledVertices(max_num_interactive_primitives);
+            is_sampled_valid_ = true;
+        }
+
+        const size_t num_vertices = sampled_vertices_.size() / 3;
+        if (primitive_type_ == PrimitiveType::POINTS)
+        {
+            drawPointArray3D(sampled_vertices_.data(), num_vertices);
+        }
+        else
+        {
+            drawLineArray3D(sampled_vertices_.data(), num_vertices);
+        }
+        return;
+    }
+
+    for (size_t k = 0; k < draw_ranges_.size(); k++)
+    {
+        const float* const v = vertices_.data() + num_floats_per_primitive * draw_ranges_[k].first;
+        const size_t num_vertices =
+            num_vertices_per_primitive_ * (draw_ranges_[k].second - draw_ranges_[k].first);
+        if (primitive_type_ == PrimitiveType::POINTS)
+        {
+            drawPointArray3D(v, num_vertices);
+        }
+        else
+        {
+            drawLineArray3D(v, num_vertices);
+        }
+    }
+}
+
+size_t PointOctree::findNearestPoint(const double x, const double y, const double z) const
+{
+    const double point[3] = {x, y, z};
+    double smallest_distance = std::numeric_limits<double>::max();
+    size_t nearest_idx = 0;
+
+    if (!primitive_indices_.empty())
+    {
+        findNearestPoint(0, point, smallest_distance, nearest_idx);
+    }
+
+    return nearest_idx;
+}
+
+void PointOctree::findNearestPoint(const size_t node_idx,
+                                   const double* const point,
+                                   double& smallest_distance,
+                                   size_t& nearest_idx) const
+{
+    const Node& node = nodes_[node_idx];
+
+    if (node.num_children == 0)
+    {
+        for (size_t k = node.begin; k < node.end; k++)
+        {
+            for (size_t i = 0; i < num_vertices_per_primitive_; i++)
+            {
+                const float* const v = vertices_.data() + 3 * (num_vertices_per_primitive_ * k + i);
+                const double squared_distance = (v[0] - point[0]) * (v[0] - point[0]) +
+                                                (v[1] - point[1]) * (v[1] - point[1]) +
+                                                (v[2] - point[2]) * (v[2] - point[2]);
+                if (squared_distance < smallest_distance)
+                {
+                    smallest_distance = squared_distance;
+                    // Segment k starts at point k
+                    nearest_idx = primitive_indices_[k] + i;
+                }
+            }
+        }
+        return;
+    }
+
+    // Closest children first, and skip those that can't contain anything closer
+    std::pair<double, uint32_t> children[8];
+    for (size_t c = 0; c < node.num_children; c++)
+    {
+        const Node& child = nodes_[node.first_child + c];
+        children[c] = {squaredDistanceToBox(point, child.min, child.max), node.first_child + c};
+    }
+    std::sort(children, children + node.num_children);
+
+    for (size_t c = 0; c < node.num_children; c++)
+    {
+        if (children[c].first < smallest_distance)
+        {
+            findNearestPoint(children[c].second, point, smallest_distance, nearest_idx);
+        }
+    }
+}
+
+size_t PointOctree::getNumBytes() const
+{
+    return sizeof(Node) * nodes_.capacity() + sizeof(float) * vertices_.capacity() +
+           sizeof(uint32_t) * primitive_indices_.capacity() +
+           sizeof(float) * sampled_vertices_.capacity();
+}
+
+size_t PointOctree::getNumReservedBytes(const size_t num_points,
+                                        const PrimitiveType primitive_type)
+{
+    const size_t num_vertices_per_primitive = primitive_type == PrimitiveType::POINTS ? 1 : 2;
+    const size_t num_primitives =
+        primitive_type == PrimitiveType::POINTS ? num_points : std::max(num_points, size_t(1)) - 1;
+
+    return sizeof(Node) + sizeof(float) * 3 * num_vertices_per_primitive * num_primitives +
+           sizeof(uint32_t) * num_primitives;
+}
+
+template <typename T>
+AsyncPointOctree::AsyncPointOctree(const T* const x_values,
+                                   const T* const y_values,
+                                   const T* const z_values,
+                                   const size_t num_points,
+                                   const PointOctree::PrimitiveType primitive_type)
+    : num_reserved_bytes_(PointOctree::getNumReservedBytes(num_points, primitive_type))
+{
+    octree_future_ = std::async(std::launch::async, [=]() {
+        return std::unique_ptr<PointOctree>(
+            new PointOctree(x_values, y_values, z_values, num_points, primitive_type));
+    });
+}
+
+PointOctree* AsyncPointOctree::get()
+{
+    if (!octree_ && octree_future_.valid() &&
+        (octree_future_.wait_for(std::chrono::seconds(0)) == std::future_status::ready))
+    {
+        octree_ = octree_future_.get();
+    }
+
+    return octree_.get();
+}
+
+size_t AsyncPointOctree::getNumBytes()
+{
+    const PointOctree* const octree = get();
+    return octree ? octree->getNumBytes() : num_reserved_bytes_;
+}
+
+template PointOctree::PointOctree(const float* const x_values,
+                                  const float* const y_values,
+                                  const float* const z_values,
+                                  const size_t num_points,
+                                  const PrimitiveType primitive_type);
+template PointOctree::PointOctree(const double* const x_values,
+                                  const double* const y_values,
+                                  const double* const z_values,
+                                  const size_t num_points,
+                                  const PrimitiveType primitive_type);
+template AsyncPointOctree::AsyncPointOctree(const float* const x_values,
+                                            const float* const y_values,
+                                            const float* const z_values,
+                                            const size_t num_points,
+                                            const PointOctree::PrimitiveType primitive_type);
+template AsyncPointOctree::AsyncPointOctree(const double* const x_values,
+                                            const double* const y_values,
+                                            const double* const z_values,
+                                            const size_t num_points,
+                                            const PointOctree::PrimitiveType primitive_type);
@@ -0,0 +1,117 @@
+#ifndef POINT_OCTREE_H_
+#define POINT_OCTREE_H_
+
+#include <stdint.h>
+
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "opengl_low_level/opengl_low_level.h"
+
+// Spatial index over the points of scatter3, or the line segments of plot3. Nodes split
+// their primitives into the eight octants around the center of the primitives, and store
+// the tight bounding box of what they contain. Primitives are reordered so that every
+// node covers a contiguous range of them, which makes a culled view a handful of
+// glDrawArrays calls over the reordered vertices.
+class PointOctree
+{
+public:
+    enum class PrimitiveType
+    {
+        POINTS,
+        LINE_STRIP
+    };
+
+private:
+    struct Node
+    {
+        float min[3];
+        float max[3];
+        uint32_t begin;  // Range of primitives
+        uint32_t end;
+        uint32_t first_child;  // Children are stored next to each other
+        uint32_t num_children;
+    };
+
+    PrimitiveType primitive_type_;
+    size_t num_vertices_per_primitive_;
+
+    std::vector<Node> nodes_;
+    std::vector<float> vertices_;             // x, y, z, in the order of the tree
+    std::vector<uint32_t> primitive_indices_;  // Original index of each primitive
+
+    // Visible leaves for the view in projection_state_, adjacent ranges are merged
+    ProjectionState projection_state_;
+    bool is_valid_;
+    std::vector<std::pair<uint32_t, uint32_t>> leaf_ranges_;
+    std::vector<std::pair<uint32_t, uint32_t>> draw_ranges_;
+    size_t num_visible_primitives_;
+
+    // Every n-th primitive of each visible leaf, used while interacting with the view
+    bool is_sampled_valid_;
+    std::vector<float> sampled_vertices_;
+
+    void buildNode(const size_t node_idx,
+                   const std::vector<float>& centers,
+                   std::vector<uint32_t>& order,
+                   std::vector<uint32_t>& order_tmp,
+                   const size_t depth);
+    void updateVisibleRanges();
+    void updateSampledVertices(const size_t max_num_primitives);
+    void findNearestPoint(const size_t node_idx,
+                          const double* const point,
+                          double& smallest_distance,
+                          size_t& nearest_idx) const;
+
+public:
+    // Instantiated for float and double values
+    template <typename T>
+    PointOctree(const T* const x_values,
+                const T* const y_values,
+                const T* const z_values,
+                const size_t num_points,
+                const PrimitiveType primitive_type);
+
+    // Draws the primitives of nodes inside the view volume and the clip planes. When
+    // is_interacting is set, large views are drawn with a subset of the primitives.
+    void draw(const bool is_interacting);
+
+    // Index of the point closest to (x, y, z), for a data cursor
+    size_t findNearestPoint(const double x, const double y, const double z) const;
+
+    size_t getNumBytes() const;
+
+    // Bytes of the vertices and primitive indices, which only depend on the number of points
+    static size_t getNumReservedBytes(const size_t num_points, const PrimitiveType primitive_type);
+};
+
+// PointOctree built on a worker thread, so that receiving data isn't delayed by it.
+// The points must stay valid until the octree is done, which the destructor waits for.
+class AsyncPointOctree
+{
+private:
+    std::future<std::unique_ptr<PointOctree>> octree_future_;
+    std::unique_ptr<PointOctree> octree_;
+    size_t num_reserved_bytes_;
+
+public:
+    AsyncPointOctree() : num_reserved_bytes_(0) {}
+    template <typename T>
+    AsyncPointOctree(const T* const x_values,
+                     const T* const y_values,
+                     const T* const z_values,
+                     const size_t num_points,
+                     const PointOctree::PrimitiveType primitive_type);
+
+    // Returns nullptr while the octree is still being built
+    PointOctree* get();
+
+    // The bytes the octree is known to take while it's still being built, so that a memory
+    // budget enforced right after the data is added accounts for it
+    size_t getNumBytes();
+};
+
+#endif
@@ -0,0 +1,179 @@
+#include "plot_functions/scatter_markers.h"
+
+#include <arl/utilities/logging.h>
+
+#include <cmath>
+
+#include "communication/rx_list.h"
+
+namespace
+{
+// Outline of the marker as line segments, x0, y0, x1, y1, ..., fitting in the unit circle
+std::vector<float> createMarkerTemplate(const int marker_type)
+{
+    std::vector<float> t;
+
+    const auto add_polygon = [&t](const std::vector<float>& corners) {
+        const size_t num_corners = corners.size() / 2;
+        for (size_t k = 0; k < num_corners; k++)
+        {
+            const size_t k_next = (k + 1) % num_corners;
+            t.insert(t.end(),
+                     {corners[2 * k],
+                      corners[2 * k + 1],
+                      corners[2 * k_next],
+                      corners[2 * k_next + 1]});
+        }
+    };
+    const float s = M_SQRT1_2;
+
+    switch (marker_type)
+    {
+        case plot_tool::MarkerType::CIRCLE:
+        {
+            const size_t num_segments = 8;
+            std::vector<float> corners;
+            for (size_t k = 0; k < num_segments; k++)
+            {
+                const float phi = 2.0 * M_PI * k / num_segments;
+                corners.push_back(std::cos(phi));
+                corners.push_back(std::sin(phi));
+            }
+            add_polygon(corners);
+            break;
+        }
+        case plot_tool::MarkerType::SQUARE:
+            add_polygon({s, s, -s, s, -s, -s, s, -s});
+            break;
+        case plot_tool::MarkerType::DIAMOND:
+            add_polygon({1.0f, 0.0f, 0.0f, 1.0f, -1.0f, 0.0f, 0.0f, -1.0f});
+            break;
+        case plot_tool::MarkerType::CROSS:
+            t = {-s, -s, s, s, -s, s, s, -s};
+            break;
+        case plot_tool::MarkerType::PLUS:
+            t = {-1.0f, 0.0f, 1.0f, 0.0f, 0.0f, -1.0f, 0.0f, 1.0f};
+            break;
+        case plot_tool::MarkerType::TRIANGLE_UP:
+            add_polygon({0.0f, 1.0f, -0.866f, -0.5f, 0.866f, -0.5f});
+            break;
+        case plot_tool::MarkerType::TRIANGLE_DOWN:
+            add_polygon({0.0f, -1.0f, 0.866f, 0.5f, -0.866f, 0.5f});
+            break;
+        default:
+            EXIT() << "Unsupported marker type: " << marker_type;
+            break;
+    }
+
+    return t;
+}
+}  // namespace
+
+MarkerBatch::MarkerBatch() : marker_size_(1.0f), is_valid_(false) {}
+
+MarkerBatch::MarkerBatch(const int marker_type, const float marker_size)
+    : marker_template_(createMarkerTemplate(marker_type)),
+      marker_size_(marker_size),
+      is_valid_(false)
+{
+}
+
+void MarkerBatch::invalidate()
+{
+    is_valid_ = false;
+}
+
+template <typename T>
+void MarkerBatch::update(const T* const x_values,
+                         const T* const y_values,
+                         const T* const z_values,
+                         const size_t num_points,
+                         ThreadPool& thread_pool)
+{
+    const ProjectionState projection_state = getProjectionState();
+    if (is_valid_ && (projection_state == projection_state_))
+    {
+        return;
+    }
+    projection_state_ = projection_state;
+
+    const size_t chunk_size = 16384;
+    const size_t num_chunks = (num_points + chunk_size - 1) / chunk_size;
+    chunk_vertices_.resize(num_chunks);
+
+    const size_t num_template_vertices = marker_template_.size() / 2;
+    const float radius = marker_size_ * 0.5f;
+    const int* const vp = projection_state_.viewport;
+
+    thread_pool.parallelFor(num_chunks, [&](const size_t chunk_from, const size_t chunk_to) {
+        for (size_t chunk_idx = chunk_from; chunk_idx < chunk_to; chunk_idx++)
+        {
+            std::vector<float>& vertices = chunk_vertices_[chunk_idx];
+            vertices.clear();
+            vertices.reserve(chunk_size * num_template_vertices * 3);
+
+            const size_t point_end = std::min(num_points, (chunk_idx + 1) * chunk_size);
+            for (size_t k = chunk_idx * chunk_size; k < point_end; k++)
+            {
+                const double model_point[4] = {
+                    x_values[k], y_values[k], z_values == nullptr ? 0.0 : z_values[k], 1.0};
+                double eye_point[4], clip_point[4];
+                multiplyMatVec4(projection_state_.modelview, model_point, eye_point);
+
+                bool is_clipped = false;
+                for (size_t p = 0; p < projection_state_.num_clip_planes; p++)
+                {
+                    const double* const plane = projection_state_.clip_planes[p];
+                    is_clipped = is_clipped ||
+                                 ((plane[0] * eye_point[0] + plane[1] * eye_point[1] +
+                                   plane[2] * eye_point[2] + plane[3] * eye_point[3]) < 0.0);
+                }
+
+                multiplyMatVec4(projection_state_.projection, eye_point, clip_point);
+                // Same near and far clipping as OpenGL would do
+                if (is_clipped || (clip_point[3] <= 0.0) ||
+                    (std::fabs(clip_point[2]) > clip_point[3]))
+                {
+                    continue;
+                }
+
+                const double w_inv = 1.0 / clip_point[3];
+                const float x_win = vp[0] + (clip_point[0] * w_inv + 1.0) * 0.5 * vp[2];
+                const float y_win = vp[1] + (clip_point[1] * w_inv + 1.0) * 0.5 * vp[3];
+                const float depth = (clip_point[2] * w_inv + 1.0) * 0.5;
+
+                for (size_t i = 0; i < num_template_vertices; i++)
+                {
+                    vertices.push_back(x_win + radius * marker_template_[2 * i]);
+                    vertices.push_back(y_win + radius * marker_template_[2 * i + 1]);
+                    vertices.push_back(depth);
+                }
+            }
+        }
+    });
+
+    is_valid_ = true;
+}
+
+void MarkerBatch::draw() const
+{
+    for (size_t k = 0; k < chunk_vertices_.size(); k++)
+    {
+        if (!chunk_vertices_[k].empty())
+        {
+            drawLinesInWindowCoordinates(
+                chunk_vertices_[k].data(), chunk_vertices_[k].size() / 3, projection_state_);
+        }
+    }
+}
+
+template void MarkerBatch::update<float>(const float* const x_values,
+                                         const float* const y_values,
+                                         const float* const z_values,
+                                         const size_t num_points,
+                                         ThreadPool& thread_pool);
+template void MarkerBatch::update<double>(const double* const x_values,
+                                          const double* const y_values,
+                                          const double* const z_values,
+                                          const size_t num_points,
+                                          ThreadPool& thread_pool);
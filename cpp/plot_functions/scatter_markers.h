@@ -0,0 +1,41 @@
+#ifndef SCATTER_MARKERS_H_
+#define SCATTER_MARKERS_H_
+
+#include <vector>
+
+#include "misc/thread_pool.h"
+#include "opengl_low_level/opengl_low_level.h"
+
+// Markers for scatter plots, with the shape given by MarkerType in plot_attributes.h.
+// Markers have a fixed size in pixels, so a unit template of the marker shape is copied
+// to the window coordinates of each point. This is done for all points at once, in
+// parallel, and only when the view has changed since the last frame. Drawing is then
+// a single glDrawArrays call per chunk of points.
+class MarkerBatch
+{
+private:
+    std::vector<float> marker_template_;  // Line segments, x, y with unit radius
+    float marker_size_;
+
+    std::vector<std::vector<float>> chunk_vertices_;
+    ProjectionState projection_state_;
+    bool is_valid_;
+
+public:
+    MarkerBatch();
+    MarkerBatch(const int marker_type, const float marker_size);
+
+    // Regenerates the markers if the current OpenGL projection differs from the one they
+    // were generated for. z_values may be nullptr for 2D points, which are put at z = 0.
+    // Instantiated for float and double values.
+    template <typename T>
+    void update(const T* const x_values,
+                const T* const y_values,
+                const T* const z_values,
+                const size_t num_points,
+                ThreadPool& thread_pool);
+    void invalidate();
+    void draw() const;
+};
+
+#endif
@@ -0,0 +1,155 @@
+#include "plot_functions/sorted_line_window.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+namespace
+{
+// Narrows [x_min, x_max] to where a * x + b * y + c >= 0 for some y in [y_min, y_max].
+// Returns false if no x satisfies it.
+bool applyHalfPlane(const double a,
+                    const double b,
+                    const double c,
+                    const double y_min,
+                    const double y_max,
+                    double& x_min,
+                    double& x_max)
+{
+    const double rhs = -c - std::max(b * y_min, b * y_max);
+    if (a > 0.0)
+    {
+        x_min = std::max(x_min, rhs / a);
+    }
+    else if (a < 0.0)
+    {
+        x_max = std::min(x_max, rhs / a);
+    }
+    else if (rhs > 0.0)
+    {
+        return false;
+    }
+
+    return x_min <= x_max;
+}
+
+// Visible x range for the current view, false if nothing can be visible
+bool getVisibleXRange(const ProjectionState& projection_state,
+                      const double y_min,
+                      const double y_max,
+                      double& x_min,
+                      double& x_max)
+{
+    x_min = std::numeric_limits<double>::lowest();
+    x_max = std::numeric_limits<double>::max();
+
+    // Clip coordinates of the point (x, y, 0), from the columns of projection * modelview
+    double mvp[16];
+    for (size_t c = 0; c < 4; c++)
+    {
+        multiplyMatVec4(
+            projection_state.projection, projection_state.modelview + 4 * c, mvp + 4 * c);
+    }
+
+    // View volume, -w <= clip[r] <= w
+    for (size_t r = 0; r < 3; r++)
+    {
+        for (const double sign : {-1.0, 1.0})
+        {
+            const double a = mvp[3] + sign * mvp[r];
+            const double b = mvp[7] + sign * mvp[4 + r];
+            const double c = mvp[15] + sign * mvp[12 + r];
+            if (!applyHalfPlane(a, b, c, y_min, y_max, x_min, x_max))
+            {
+                return false;
+            }
+        }
+    }
+
+    // Clip planes are in eye coordinates, plane . (modelview * p) >= 0
+    const double* const mv = projection_state.modelview;
+    for (size_t p = 0; p < projection_state.num_clip_planes; p++)
+    {
+        const double* const plane = projection_state.clip_planes[p];
+        double model_plane[4];
+        for (size_t c = 0; c < 4; c++)
+        {
+            model_plane[c] = plane[0] * mv[4 * c] + plane[1] * mv[4 * c + 1] +
+                             plane[2] * mv[4 * c + 2] + plane[3] * mv[4 * c + 3];
+        }
+        if (!applyHalfPlane(
+                model_plane[0], model_plane[1], model_plane[3], y_min, y_max, x_min, x_max))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+}  // namespace
+
+SortedLineWindow::SortedLineWindow() : is_valid_(false), idx_begin_(0), idx_end_(0) {}
+
+size_t SortedLineWindow::getBegin() const
+{
+    return idx_begin_;
+}
+
+size_t SortedLineWindow::getEnd() const
+{
+    return idx_end_;
+}
+
+template <typename T>
+void SortedLineWindow::update(const T* const x_values,
+                              const size_t num_points,
+                              const bool is_ascending,
+                              const double y_min,
+                              const double y_max)
+{
+    const ProjectionState projection_state = getProjectionState();
+    if (is_valid_ && (projection_state == projection_state_))
+    {
+        return;
+    }
+    projection_state_ = projection_state;
+    is_valid_ = true;
+
+    double x_min, x_max;
+    if (!getVisibleXRange(projection_state_, y_min, y_max, x_min, x_max))
+    {
+        idx_begin_ = 0;
+        idx_end_ = 0;
+        return;
+    }
+
+    // First and one past the last point inside [x_min, x_max], in index order
+    const T* const x_end = x_values + num_points;
+    const T* first;
+    const T* last;
+    if (is_ascending)
+    {
+        first = std::lower_bound(x_values, x_end, x_min);
+        last = std::upper_bound(x_values, x_end, x_max);
+    }
+    else
+    {
+        first = std::lower_bound(x_values, x_end, x_max, std::greater<double>());
+        last = std::upper_bound(x_values, x_end, x_min, std::greater<double>());
+    }
+
+    // Includes the closest point outside on each side
+    idx_begin_ = std::max(first - x_values - 1, std::ptrdiff_t(0));
+    idx_end_ = std::min(static_cast<size_t>(last - x_values + 1), num_points);
+}
+
+template void SortedLineWindow::update<float>(const float* const x_values,
+                                              const size_t num_points,
+                                              const bool is_ascending,
+                                              const double y_min,
+                                              const double y_max);
+template void SortedLineWindow::update<double>(const double* const x_values,
+                                               const size_t num_points,
+                                               const bool is_ascending,
+                                               const double y_min,
+                                               const double y_max);
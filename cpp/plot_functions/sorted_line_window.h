@@ -0,0 +1,38 @@
+#ifndef SORTED_LINE_WINDOW_H_
+#define SORTED_LINE_WINDOW_H_
+
+#include <cstddef>
+
+#include "opengl_low_level/opengl_low_level.h"
+
+// Visible part of a 2D line with monotonic x values, found by binary search instead of
+// walking the whole line. The visible x range is where the points (x, y, 0), with y anywhere
+// in the y range of the line, can be inside the view volume and the enabled clip planes.
+// The closest point outside on each side is included, for the segments going out of view.
+// Only recomputed when the view (axes limits, window size) has changed.
+class SortedLineWindow
+{
+private:
+    ProjectionState projection_state_;
+    bool is_valid_;
+    size_t idx_begin_;
+    size_t idx_end_;
+
+public:
+    SortedLineWindow();
+
+    // x_values have to be sorted in ascending order if is_ascending is set, and in descending
+    // order otherwise. Instantiated for float and double values.
+    template <typename T>
+    void update(const T* const x_values,
+                const size_t num_points,
+                const bool is_ascending,
+                const double y_min,
+                const double y_max);
+
+    // Range of points [getBegin(), getEnd()) to draw
+    size_t getBegin() const;
+    size_t getEnd() const;
+};
+
+#endif
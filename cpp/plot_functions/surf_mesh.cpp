@@ -0,0 +1,358 @@
+#include "plot_functions/surf_mesh.h"
+
+#include <arl/math/math.h>
+#include <arl/utilities/color_map.h>
+#include <arl/utilities/logging.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include "opengl_low_level/opengl_low_level.h"
+
+using namespace arl;
+
+namespace
+{
+// Every stride-th index of [0, num_indices), always including the last one
+std::vector<size_t> getSampledIndices(const size_t num_indices, const size_t stride)
+{
+    std::vector<size_t> indices;
+    if (num_indices == 0)
+    {
+        return indices;
+    }
+
+    for (size_t k = 0; k < num_indices - 1; k += stride)
+    {
+        indices.push_back(k);
+    }
+    indices.push_back(num_indices - 1);
+
+    return indices;
+}
+
+template <typename T>
+void buildSurfMeshGeometry(SurfMesh& mesh,
+                           const arl::Matrix<T>& x,
+                           const arl::Matrix<T>& y,
+                           const arl::Matrix<T>& z,
+                           const std::vector<size_t>& row_indices,
+                           const std::vector<size_t>& col_indices,
+                           ThreadPool& thread_pool)
+{
+    ASSERT((x.rows() == y.rows()) && (x.rows() == z.rows()));
+    ASSERT((x.cols() == y.cols()) && (x.cols() == z.cols()));
+    ASSERT(x.rows() * x.cols() <= UINT32_MAX) << "Too many points for 32 bit indices!";
+
+    const size_t num_rows = row_indices.size();
+    const size_t num_cols = col_indices.size();
+
+    mesh.num_rows = num_rows;
+    mesh.num_cols = num_cols;
+    if ((num_rows == 0) || (num_cols == 0))
+    {
+        mesh.vertices.clear();
+        mesh.quad_indices.clear();
+        mesh.edge_indices.clear();
+        return;
+    }
+
+    // A single row or column of points has no quads, only the grid lines between the points
+    mesh.vertices.resize(3 * num_rows * num_cols);
+    mesh.quad_indices.resize(4 * (num_rows - 1) * (num_cols - 1));
+    // Each grid point owns the edge to its right and the edge below it
+    mesh.edge_indices.resize(2 * ((num_rows - 1) * num_cols + num_rows * (num_cols - 1)));
+
+    thread_pool.parallelFor(num_rows, [&](const size_t row_from, const size_t row_to) {
+        for (size_t r = row_from; r < row_to; r++)
+        {
+            const size_t r_src = row_indices[r];
+            float* const vertex_row = mesh.vertices.data() + 3 * r * num_cols;
+            for (size_t c = 0; c < num_cols; c++)
+            {
+                const size_t c_src = col_indices[c];
+                vertex_row[3 * c] = x(r_src, c_src);
+                vertex_row[3 * c + 1] = y(r_src, c_src);
+                vertex_row[3 * c + 2] = z(r_src, c_src);
+            }
+
+            uint32_t* edge_idx =
+                mesh.edge_indices.data() + 2 * (r * (num_cols - 1) + r * num_cols);
+            for (size_t c = 0; c < num_cols - 1; c++)
+            {
+                *edge_idx++ = r * num_cols + c;
+                *edge_idx++ = r * num_cols + c + 1;
+            }
+
+            if (r == num_rows - 1)
+            {
+                continue;
+            }
+
+            for (size_t c = 0; c < num_cols; c++)
+            {
+                *edge_idx++ = r * num_cols + c;
+                *edge_idx++ = (r + 1) * num_cols + c;
+            }
+
+            uint32_t* const quad_row = mesh.quad_indices.data() + 4 * r * (num_cols - 1);
+            for (size_t c = 0; c < num_cols - 1; c++)
+            {
+                quad_row[4 * c] = r * num_cols + c;
+                quad_row[4 * c + 1] = r * num_cols + c + 1;
+                quad_row[4 * c + 2] = (r + 1) * num_cols + c + 1;
+                quad_row[4 * c + 3] = (r + 1) * num_cols + c;
+            }
+        }
+    });
+}
+}  // namespace
+
+SurfMesh::SurfMesh() : num_rows(0), num_cols(0) {}
+
+void SurfMesh::clear()
+{
+    num_rows = 0;
+    num_cols = 0;
+    vertices.clear();
+    colors.clear();
+    quad_indices.clear();
+    edge_indices.clear();
+}
+
+size_t SurfMesh::getNumBytes() const
+{
+    return sizeof(float) * (vertices.capacity() + colors.capacity()) +
+           sizeof(uint32_t) * (quad_indices.capacity() + edge_indices.capacity());
+}
+
+template <typename T>
+void buildSurfMesh(SurfMesh& mesh,
+                   const arl::Matrix<T>& x,
+                   const arl::Matrix<T>& y,
+                   const arl::Matrix<T>& z,
+                   ThreadPool& thread_pool,
+                   const size_t stride)
+{
+    buildSurfMeshGeometry(mesh,
+                          x,
+                          y,
+                          z,
+                          getSampledIndices(x.rows(), stride),
+                          getSampledIndices(x.cols(), stride),
+                          thread_pool);
+    mesh.colors.clear();
+}
+
+template <typename T>
+void buildSurfMesh(SurfMesh& mesh,
+                   const arl::Matrix<T>& x,
+                   const arl::Matrix<T>& y,
+                   const arl::Matrix<T>& z,
+                   const arl::Interval1D<double> min_max_interval,
+                   const ColorLut& color_lut,
+                   ThreadPool& thread_pool,
+                   const size_t stride)
+{
+    const std::vector<size_t> row_indices = getSampledIndices(x.rows(), stride);
+    const std::vector<size_t> col_indices = getSampledIndices(x.cols(), stride);
+    buildSurfMeshGeometry(mesh, x, y, z, row_indices, col_indices, thread_pool);
+
+    const size_t num_rows = mesh.num_rows;
+    const size_t num_cols = mesh.num_cols;
+
+    mesh.colors.resize(3 * num_rows * num_cols);
+    if (mesh.vertices.empty())
+    {
+        return;
+    }
+
+    // Row 0 and the last column are never the last vertex of a quad
+    std::fill(mesh.colors.begin(), mesh.colors.begin() + 3 * num_cols, 0.0f);
+
+    thread_pool.parallelFor(num_rows - 1, [&](const size_t row_from, const size_t row_to) {
+        std::vector<double> mean_vals(num_cols - 1);
+
+        for (size_t r = row_from; r < row_to; r++)
+        {
+            const size_t r0 = row_indices[r], r1 = row_indices[r + 1];
+            for (size_t c = 0; c < num_cols - 1; c++)
+            {
+                const size_t c0 = col_indices[c], c1 = col_indices[c + 1];
+                mean_vals[c] = (y(r0, c0) + y(r0, c1) + y(r1, c1) + y(r1, c0)) * 0.25;
+            }
+
+            float* const color_row = mesh.colors.data() + 3 * (r + 1) * num_cols;
+            color_lut.mapValues(mean_vals.data(), num_cols - 1, min_max_interval, color_row);
+
+            color_row[3 * (num_cols - 1)] = 0.0f;
+            color_row[3 * (num_cols - 1) + 1] = 0.0f;
+            color_row[3 * (num_cols - 1) + 2] = 0.0f;
+        }
+    });
+}
+
+void drawSurfMeshFaces(const SurfMesh& mesh)
+{
+    if (mesh.quad_indices.empty())
+    {
+        return;
+    }
+
+    drawIndexedQuads3D(mesh.vertices.data(),
+                       mesh.colors.empty() ? nullptr : mesh.colors.data(),
+                       mesh.quad_indices.data(),
+                       mesh.quad_indices.size());
+}
+
+void drawSurfMeshEdges(const SurfMesh& mesh)
+{
+    if (mesh.edge_indices.empty())
+    {
+        return;
+    }
+
+    drawIndexedLines3D(mesh.vertices.data(), mesh.edge_indices.data(), mesh.edge_indices.size());
+}
+
+template <typename T>
+void buildSurfMeshLevels(std::vector<SurfMesh>& mesh_levels,
+                         const arl::Matrix<T>& x,
+                         const arl::Matrix<T>& y,
+                         const arl::Matrix<T>& z,
+                         const arl::Interval1D<double> min_max_interval,
+                         const ColorLut* const color_lut,
+                         ThreadPool& thread_pool)
+{
+    // Coarsest level has at most this many quads
+    const size_t min_num_quads = 128 * 128;
+
+    mesh_levels.clear();
+    size_t stride = 1;
+    do
+    {
+        mesh_levels.emplace_back();
+        if (color_lut == nullptr)
+        {
+            buildSurfMesh(mesh_levels.back(), x, y, z, thread_pool, stride);
+        }
+        else
+        {
+            buildSurfMesh(
+                mesh_levels.back(), x, y, z, min_max_interval, *color_lut, thread_pool, stride);
+        }
+        stride *= 2;
+    } while (mesh_levels.back().quad_indices.size() / 4 > min_num_quads);
+}
+
+size_t selectSurfMeshLevel(const std::vector<SurfMesh>& mesh_levels, const bool is_interacting)
+{
+    ASSERT(!mesh_levels.empty());
+
+    // Grids without quads, a single row or column of points, have a single level
+    const SurfMesh& mesh = mesh_levels[0];
+    if (mesh.quad_indices.empty())
+    {
+        return 0;
+    }
+
+    const ProjectionState projection_state = getProjectionState();
+    const int* const vp = projection_state.viewport;
+
+    // Window coordinates of the four corners of the grid
+    const size_t corner_indices[4] = {0,
+                                      mesh.num_cols - 1,
+                                      (mesh.num_rows - 1) * mesh.num_cols,
+                                      mesh.num_rows * mesh.num_cols - 1};
+    double corners[4][2];
+    bool corners_in_front = true;
+    for (size_t k = 0; k < 4; k++)
+    {
+        const float* const v = mesh.vertices.data() + 3 * corner_indices[k];
+        const double model_point[4] = {v[0], v[1], v[2], 1.0};
+        double eye_point[4], clip_point[4];
+        multiplyMatVec4(projection_state.modelview, model_point, eye_point);
+        multiplyMatVec4(projection_state.projection, eye_point, clip_point);
+
+        corners_in_front = corners_in_front && (clip_point[3] > 0.0);
+        corners[k][0] = (clip_point[0] / clip_point[3] + 1.0) * 0.5 * vp[2];
+        corners[k][1] = (clip_point[1] / clip_point[3] + 1.0) * 0.5 * vp[3];
+    }
+
+    const auto distance = [&corners](const size_t i0, const size_t i1) -> double {
+        return std::sqrt((corners[i1][0] - corners[i0][0]) * (corners[i1][0] - corners[i0][0]) +
+                         (corners[i1][1] - corners[i0][1]) * (corners[i1][1] - corners[i0][1]));
+    };
+
+    // Largest projected size of a cell of the full resolution grid, in pixels. Levels are
+    // made coarser as long as their cells are still at most one pixel large.
+    size_t level = 0;
+    if (corners_in_front)
+    {
+        const double col_size = std::max(distance(0, 1), distance(2, 3)) / (mesh.num_cols - 1);
+        const double row_size = std::max(distance(0, 2), distance(1, 3)) / (mesh.num_rows - 1);
+        const double cell_size = std::max(col_size, row_size);
+        while ((level + 1 < mesh_levels.size()) && (cell_size * (2 << level) <= 1.0))
+        {
+            level++;
+        }
+    }
+
+    // While the view is being dragged, at least one level coarser, and at most this many quads
+    if (is_interacting)
+    {
+        const size_t max_num_interactive_quads = 256 * 1024;
+        level = std::min(level + 1, mesh_levels.size() - 1);
+        while ((level + 1 < mesh_levels.size()) &&
+               (mesh_levels[level].quad_indices.size() / 4 > max_num_interactive_quads))
+        {
+            level++;
+        }
+    }
+
+    return level;
+}
+
+template void buildSurfMesh(SurfMesh& mesh,
+                            const arl::Matrix<float>& x,
+                            const arl::Matrix<float>& y,
+                            const arl::Matrix<float>& z,
+                            const arl::Interval1D<double> min_max_interval,
+                            const ColorLut& color_lut,
+                            ThreadPool& thread_pool,
+                            const size_t stride);
+template void buildSurfMesh(SurfMesh& mesh,
+                            const arl::Matrix<float>& x,
+                            const arl::Matrix<float>& y,
+                            const arl::Matrix<float>& z,
+                            ThreadPool& thread_pool,
+                            const size_t stride);
+template void buildSurfMeshLevels(std::vector<SurfMesh>& mesh_levels,
+                                  const arl::Matrix<float>& x,
+                                  const arl::Matrix<float>& y,
+                                  const arl::Matrix<float>& z,
+                                  const arl::Interval1D<double> min_max_interval,
+                                  const ColorLut* const color_lut,
+                                  ThreadPool& thread_pool);
+
+template void buildSurfMesh(SurfMesh& mesh,
+                            const arl::Matrix<double>& x,
+                            const arl::Matrix<double>& y,
+                            const arl::Matrix<double>& z,
+                            const arl::Interval1D<double> min_max_interval,
+                            const ColorLut& color_lut,
+                            ThreadPool& thread_pool,
+                            const size_t stride);
+template void buildSurfMesh(SurfMesh& mesh,
+                            const arl::Matrix<double>& x,
+                            const arl::Matrix<double>& y,
+                            const arl::Matrix<double>& z,
+                            ThreadPool& thread_pool,
+                            const size_t stride);
+template void buildSurfMeshLevels(std::vector<SurfMesh>& mesh_levels,
+                                  const arl::Matrix<double>& x,
+                                  const arl::Matrix<double>& y,
+                                  const arl::Matrix<double>& z,
+                                  const arl::Interval1D<double> min_max_interval,
+                                  const ColorLut* const color_lut,
+                                  ThreadPool& thread_pool);
@@ -0,0 +1,72 @@
+#ifndef SURF_MESH_H_
+#define SURF_MESH_H_
+
+#include <arl/math/math.h>
+#include <arl/utilities/color_map.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "misc/thread_pool.h"
+#include "plot_functions/color_lut.h"
+#include "opengl_low_level/data_structures.h"
+
+// Render ready geometry for a surf, generated once on the CPU so that drawing is a
+// couple of vertex array calls instead of one glBegin/glEnd pair per quad.
+// Vertices are shared between neighbouring quads. Faces are drawn with flat shading,
+// where OpenGL takes the color of a quad from its last vertex, so the color of quad
+// (r, c) is stored in vertex (r + 1, c), which is the last vertex of no other quad.
+struct SurfMesh
+{
+    size_t num_rows;
+    size_t num_cols;
+
+    std::vector<float> vertices;  // x, y, z for each grid point, row major
+    std::vector<float> colors;    // r, g, b for each grid point, empty if uncolored
+    std::vector<uint32_t> quad_indices;
+    std::vector<uint32_t> edge_indices;
+
+    SurfMesh();
+    void clear();
+    size_t getNumBytes() const;
+};
+
+// Builds vertices, colors and indices, row wise in parallel on thread_pool. Only every
+// stride-th row and column is used, plus the last ones, so that the extent stays the same.
+// Instantiated for float and double matrices, as are the other builders.
+template <typename T>
+void buildSurfMesh(SurfMesh& mesh,
+                   const arl::Matrix<T>& x,
+                   const arl::Matrix<T>& y,
+                   const arl::Matrix<T>& z,
+                   const arl::Interval1D<double> min_max_interval,
+                   const ColorLut& color_lut,
+                   ThreadPool& thread_pool,
+                   const size_t stride = 1);
+// Same as above, but without colors for surfs drawn with a single face color
+template <typename T>
+void buildSurfMesh(SurfMesh& mesh,
+                   const arl::Matrix<T>& x,
+                   const arl::Matrix<T>& y,
+                   const arl::Matrix<T>& z,
+                   ThreadPool& thread_pool,
+                   const size_t stride = 1);
+
+// Level of detail pyramid, where level k uses a stride of 2^k. Levels are added until the
+// coarsest one is small enough to always be drawn interactively. No colors if color_lut is null.
+template <typename T>
+void buildSurfMeshLevels(std::vector<SurfMesh>& mesh_levels,
+                         const arl::Matrix<T>& x,
+                         const arl::Matrix<T>& y,
+                         const arl::Matrix<T>& z,
+                         const arl::Interval1D<double> min_max_interval,
+                         const ColorLut* const color_lut,
+                         ThreadPool& thread_pool);
+// Coarsest level with cells no larger than a pixel in the current OpenGL view, and a coarser
+// one while the user is interacting with the view
+size_t selectSurfMeshLevel(const std::vector<SurfMesh>& mesh_levels, const bool is_interacting);
+
+void drawSurfMeshFaces(const SurfMesh& mesh);
+void drawSurfMeshEdges(const SurfMesh& mesh);
+
+#endif